@@ -0,0 +1,145 @@
+// Standard
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Maze
+#include <maze/concurrent_maze.hpp>
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+
+namespace {
+std::atomic<uint64_t> checksum(0); /**< Keeps the reads from being optimized away. */
+
+/**
+ * @brief Runs readers against a writer that keeps moving, and counts the reads.
+ * @param readers The number of reader threads.
+ * @param seconds How long to run.
+ * @param read The function pinning a state and reading from it, returning a checksum.
+ * @param write The function applying one move.
+ * @return The reads per second over all readers.
+ */
+template <typename Read, typename Write>
+double measure(uint32_t readers, double seconds, const Read& read, const Write& write) {
+  std::atomic<bool> done(false);
+  std::atomic<uint64_t> reads(0);
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < readers; ++i) {
+    threads.emplace_back([&]() {
+      uint64_t count = 0;
+      uint64_t sum = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        sum += read();
+        ++count;
+      }
+      reads += count;
+      checksum += sum;
+    });
+  }
+  const auto start = std::chrono::steady_clock::now();
+  const auto stop = start + std::chrono::duration<double>(seconds);
+  while (std::chrono::steady_clock::now() < stop) {
+    write();
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  done.store(true);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  const double elapsed =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return static_cast<double>(reads.load()) / elapsed;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const uint32_t size = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 101;
+  const uint32_t max_readers = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2]))
+                                        : std::max(1u, std::thread::hardware_concurrency());
+
+  maze::GenerationOptions options;
+  options.seed = 1;
+  const maze::Maze generated(size, size, 0.0, options);
+  maze::Maze::Move forth = maze::Maze::Move::RIGHT;
+  for (const maze::Maze::Move move : {maze::Maze::Move::RIGHT, maze::Maze::Move::DOWN,
+                                      maze::Maze::Move::LEFT, maze::Maze::Move::UP}) {
+    maze::Maze probe(generated);
+    if (probe.movePlayer(move)) {
+      forth = move;
+      break;
+    }
+  }
+  const auto back = [](maze::Maze::Move move) {
+    switch (move) {
+    case maze::Maze::Move::RIGHT:
+      return maze::Maze::Move::LEFT;
+    case maze::Maze::Move::LEFT:
+      return maze::Maze::Move::RIGHT;
+    case maze::Maze::Move::DOWN:
+      return maze::Maze::Move::UP;
+    case maze::Maze::Move::UP:
+    default:
+      return maze::Maze::Move::DOWN;
+    }
+  };
+  const auto readState = [](const maze::Maze& maze) {
+    const maze::Coordinates pos = maze.getPlayerPosition();
+    return static_cast<uint64_t>(pos.row) + pos.col + maze.getCell(pos.row, pos.col).value;
+  };
+
+  {
+    // Every move is published as a version of its own, with no readers holding on to any.
+    maze::ConcurrentMaze shared(generated);
+    const uint32_t moves = 10000;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < moves; ++i) {
+      shared.movePlayer(i % 2 == 0 ? forth : back(forth));
+    }
+    const double elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Publishing a move on a " << size << "x" << size << " maze takes "
+              << elapsed / moves * 1e6 << " us\n\n";
+  }
+
+  std::cout << "Reading a " << size << "x" << size << " maze while one writer moves\n";
+  std::cout << std::left << std::setw(10) << "readers" << std::setw(20) << "mutex Mreads/s"
+            << "epoch Mreads/s\n";
+
+  for (uint32_t readers = 1; readers <= max_readers; readers *= 2) {
+    maze::Maze locked(generated);
+    std::mutex mutex;
+    bool away = false;
+    const double mutex_rate = measure(
+        readers, 0.5,
+        [&]() {
+          std::lock_guard<std::mutex> lock(mutex);
+          return readState(locked);
+        },
+        [&]() {
+          std::lock_guard<std::mutex> lock(mutex);
+          locked.movePlayer(away ? back(forth) : forth);
+          away = !away;
+        });
+
+    maze::ConcurrentMaze shared(generated);
+    away = false;
+    const double epoch_rate = measure(
+        readers, 0.5, [&]() { return readState(*shared.read()); },
+        [&]() {
+          shared.movePlayer(away ? back(forth) : forth);
+          away = !away;
+        });
+
+    std::cout << std::left << std::setw(10) << readers << std::setw(20) << mutex_rate / 1e6
+              << epoch_rate / 1e6 << "\n";
+  }
+
+  return EXIT_SUCCESS;
+}
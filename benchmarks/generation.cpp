@@ -0,0 +1,61 @@
+// Standard
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Maze
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+
+namespace {
+double secondsSince(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const uint32_t size = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 2001;
+  const uint32_t solve_size = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : 301;
+
+  const std::vector<std::pair<std::string, maze::GenerationAlgorithm>> algorithms = {
+      {"recursive-backtracker", maze::GenerationAlgorithm::RECURSIVE_BACKTRACKER},
+      {"kruskal", maze::GenerationAlgorithm::KRUSKAL},
+      {"prim", maze::GenerationAlgorithm::PRIM},
+      {"wilson", maze::GenerationAlgorithm::WILSON}};
+
+  std::cout << "Carving " << size << "x" << size << ", solving " << solve_size << "x"
+            << solve_size << "\n";
+  std::cout << std::left << std::setw(24) << "algorithm" << std::setw(16) << "Mcells/s"
+            << std::setw(16) << "solve ms" << "path length\n";
+
+  for (const auto& [name, algorithm] : algorithms) {
+    maze::GenerationOptions options;
+    options.seed = 1;
+    options.algorithm = algorithm;
+
+    maze::Grid grid(size, size);
+    const auto carve_start = std::chrono::steady_clock::now();
+    maze::carvePerfectMaze(grid, *options.seed, options);
+    const double carve_seconds = secondsSince(carve_start);
+
+    maze::Maze solve_maze(solve_size, solve_size, 0.0, options);
+    const auto solve_start = std::chrono::steady_clock::now();
+    std::string path_length = "unsolvable";
+    try {
+      path_length = std::to_string(solve_maze.solve().size());
+    } catch (const std::runtime_error&) {
+    }
+    const double solve_seconds = secondsSince(solve_start);
+
+    std::cout << std::left << std::setw(24) << name << std::setw(16)
+              << static_cast<double>(size) * size / carve_seconds / 1e6 << std::setw(16)
+              << solve_seconds * 1e3 << path_length << "\n";
+  }
+
+  return EXIT_SUCCESS;
+}
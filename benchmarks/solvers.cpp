@@ -0,0 +1,106 @@
+// Standard
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Maze
+#include <maze/generation.hpp>
+#include <maze/landmarks.hpp>
+#include <maze/maze.hpp>
+#include <maze/parallel_bfs.hpp>
+#include <maze/weighted_solver.hpp>
+
+namespace {
+double secondsSince(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void benchmarkWeighted(const std::string& name, const maze::Maze& maze, uint32_t repetitions) {
+  const auto start = std::chrono::steady_clock::now();
+  uint32_t cost = 0;
+  for (uint32_t repetition = 0; repetition < repetitions; ++repetition) {
+    const auto path = maze::solveWeighted(maze);
+    cost = path ? path->cost : 0;
+  }
+  std::cout << std::left << std::setw(24) << name << std::setw(16)
+            << secondsSince(start) * 1e3 / repetitions << cost << "\n";
+}
+
+void benchmarkSolve(const std::string& name, const maze::Maze& maze, uint32_t repetitions) {
+  const auto start = std::chrono::steady_clock::now();
+  std::size_t length = 0;
+  for (uint32_t repetition = 0; repetition < repetitions; ++repetition) {
+    length = maze::Maze(maze).solve().size();
+  }
+  std::cout << std::left << std::setw(24) << name << std::setw(16)
+            << secondsSince(start) * 1e3 / repetitions << length << "\n";
+}
+
+void benchmarkBreadthFirst(const std::string& name, const maze::Grid& grid, uint32_t threads) {
+  const auto start = std::chrono::steady_clock::now();
+  const std::vector<uint32_t> distances = maze::breadthFirstDistances(grid, {1, 1}, 0, threads);
+  const double seconds = secondsSince(start);
+  uint32_t reached = 0;
+  for (const uint32_t distance : distances) {
+    reached += distance != maze::kUnreachable;
+  }
+  std::cout << std::left << std::setw(24) << name << std::setw(16) << seconds * 1e3 << reached
+            << "\n";
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const uint32_t size = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 1001;
+  const uint32_t repetitions = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : 10;
+
+  maze::GenerationOptions options;
+  options.seed = 1;
+  options.algorithm = maze::GenerationAlgorithm::PRIM;
+  const maze::Maze unit(size, size, 0.0, options);
+  options.placement.mud_density = 0.2;
+  options.placement.water_density = 0.1;
+  const maze::Maze weighted(size, size, 0.0, options);
+
+  std::cout << "Solving " << size << "x" << size << "\n";
+  std::cout << std::left << std::setw(24) << "terrain" << std::setw(16) << "solve ms" << "cost\n";
+  benchmarkWeighted("unit", unit, repetitions);
+  benchmarkWeighted("mud and water", weighted, repetitions);
+
+  // Landmarks pay off in mazes whose paths wind far from the straight line.
+  maze::GenerationOptions winding;
+  winding.seed = 1;
+  winding.placement.food_density = 0.05;
+  maze::Maze solvable(size, size, 0.0, winding);
+  std::cout << "\nA* on " << size << "x" << size << "\n";
+  std::cout << std::left << std::setw(24) << "search" << std::setw(16) << "solve ms"
+            << "path length\n";
+  benchmarkSolve("manhattan", solvable, repetitions);
+  const auto build_start = std::chrono::steady_clock::now();
+  solvable.setLandmarkTable(std::make_shared<const maze::LandmarkTable>(solvable, 8));
+  std::cout << std::left << std::setw(24) << "8 landmarks (build)" << std::setw(16)
+            << secondsSince(build_start) * 1e3 << "\n";
+  benchmarkSolve("8 landmarks", solvable, repetitions);
+  solvable.setLandmarkTable(nullptr);
+  const auto contract_start = std::chrono::steady_clock::now();
+  solvable.setJunctionSearch(true);
+  std::cout << std::left << std::setw(24) << "junctions (build)" << std::setw(16)
+            << secondsSince(contract_start) * 1e3 << "\n";
+  benchmarkSolve("junctions", solvable, repetitions);
+
+  // An open grid keeps the frontier wide, a carved maze keeps it narrow.
+  const uint32_t bfs_size = argc > 3 ? static_cast<uint32_t>(std::stoul(argv[3])) : 4001;
+  maze::Grid open(bfs_size, bfs_size);
+  maze::Grid carved(bfs_size, bfs_size);
+  maze::carvePerfectMaze(carved, 1, options);
+  std::cout << "\nBreadth-first search " << bfs_size << "x" << bfs_size << "\n";
+  std::cout << std::left << std::setw(24) << "grid" << std::setw(16) << "search ms" << "reached\n";
+  benchmarkBreadthFirst("open, 1 thread", open, 1);
+  benchmarkBreadthFirst("open, all threads", open, 0);
+  benchmarkBreadthFirst("carved, 1 thread", carved, 1);
+  benchmarkBreadthFirst("carved, all threads", carved, 0);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file analytics.hpp
+ * @brief Defines the structural metrics computed for a maze.
+ */
+
+#ifndef MAZE_ANALYTICS_HPP_
+#define MAZE_ANALYTICS_HPP_
+
+// Standard
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace maze {
+
+class Maze;
+
+/**
+ * @brief Structural metrics of a maze layout, used to calibrate its difficulty.
+ *
+ * Distances ignore the food a player carries, they only follow passable tiles.
+ */
+struct MazeAnalytics {
+  uint32_t passable_cells = 0; /**< The number of passable cells. */
+  uint32_t dead_ends = 0; /**< Passable cells with exactly one passable neighbour. */
+  uint32_t junctions = 0; /**< Passable cells with three or four passable neighbours. */
+
+  /**
+   * @brief Histogram of corridor lengths: entry n is the number of corridors n cells long.
+   *
+   * A corridor is a maximal chain of passable cells with exactly two passable neighbours each.
+   */
+  std::vector<uint32_t> corridor_lengths;
+
+  std::optional<uint32_t> shortest_path_length; /**< Moves from start to end, if reachable. */
+  uint32_t food_on_path = 0; /**< Food tiles along one shortest path from start to end. */
+  uint32_t reachable_food = 0; /**< Food tiles reachable from the start. */
+  uint32_t visible_from_start = 0; /**< Cells perceivable from the start. */
+  uint32_t sight_radius = 0; /**< The sight radius visible_from_start was computed for. */
+};
+
+/**
+ * @brief Computes the metrics of a maze in two linear passes over its grid.
+ *
+ * The first pass counts neighbours and walks corridors, the second is a breadth-first search from
+ * the start. Only the visibility count depends on the sight radius, costing O(radius^3).
+ *
+ * @param maze The maze to analyze.
+ * @param sight_radius The sight radius to count the cells visible from the start with.
+ * @return The computed metrics.
+ */
+MazeAnalytics analyzeMaze(const Maze& maze, uint32_t sight_radius);
+
+}  // namespace maze
+
+#endif  // MAZE_ANALYTICS_HPP_
@@ -0,0 +1,149 @@
+/**
+ * @file belief_map.hpp
+ * @brief Defines the BeliefMap class, an agent's fog-of-war map built from perception windows.
+ */
+
+#ifndef MAZE_BELIEF_MAP_HPP_
+#define MAZE_BELIEF_MAP_HPP_
+
+// Standard
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Private
+#include "coordinates.hpp"
+#include "maze.hpp"
+
+namespace maze {
+
+/**
+ * @brief The way from a position to the nearest frontier cell.
+ */
+struct FrontierPath {
+  Coordinates target; /**< The frontier cell that was found. */
+  std::vector<Maze::Move> moves; /**< The moves leading to the target over known cells. */
+};
+
+/**
+ * @class BeliefMap
+ * @brief Accumulates what an agent has perceived of a maze and tracks its exploration frontier.
+ *
+ * A frontier cell is a known passable cell next to an unknown cell, where locked doors are only
+ * passable with their key, see setKeys(). The set of frontier cells is
+ * updated while merging, touching only the merged cells and their neighbours, so merging a window
+ * costs O(window) regardless of the maze size.
+ */
+class BeliefMap {
+ public:
+  /**
+   * @brief Constructs a map of the given size in which nothing is known yet.
+   * @param rows The number of rows of the maze.
+   * @param cols The number of columns of the maze.
+   */
+  BeliefMap(uint32_t rows, uint32_t cols);
+
+  /**
+   * @brief Merges a perception window as returned by Maze::perceiveTiles().
+   *
+   * Unknown entries of the window never overwrite known cells.
+   *
+   * @param center The position the window was perceived from.
+   * @param window The perceived tiles, with the center in the middle.
+   * @return The number of cells whose belief changed.
+   */
+  uint32_t merge(const Coordinates& center,
+                 const std::vector<std::vector<Maze::PerceivedTile>>& window);
+
+  /**
+   * @brief Sets the keys the agent holds, which decide whether locked doors are passable.
+   * @param keys The held keys, bit c set for the key of colour c.
+   */
+  void setKeys(uint16_t keys);
+
+  /**
+   * @brief Returns the believed tile at a position.
+   * @param pos The position of the cell.
+   * @return The last perceived tile, or UNKNOWN if the cell was never seen.
+   */
+  Maze::PerceivedTile getTile(const Coordinates& pos) const;
+
+  /**
+   * @brief Returns the number of cells that were perceived at least once.
+   * @return The number of known cells.
+   */
+  std::size_t getKnownCount() const;
+
+  /**
+   * @brief Returns whether a cell is on the frontier.
+   * @param pos The position of the cell.
+   * @return True if the cell is known, passable with the held keys and next to an unknown cell.
+   */
+  bool isFrontier(const Coordinates& pos) const;
+
+  /**
+   * @brief Returns the current frontier cells, in no particular order.
+   * @return The frontier cells.
+   */
+  const std::vector<Coordinates>& getFrontier() const;
+
+  /**
+   * @brief Finds the frontier cell closest to a position along cells known to be passable with the
+   * held keys.
+   *
+   * The breadth-first search stops at the first frontier cell, so its cost is bounded by the
+   * number of known cells closer than the result.
+   *
+   * @param from The position to search from.
+   * @return The nearest frontier cell and the way there, or nothing if none is reachable.
+   */
+  std::optional<FrontierPath> findNearestFrontier(const Coordinates& from);
+
+ private:
+  /**
+   * @brief Returns whether a believed tile can be walked on.
+   * @param tile The tile to check.
+   * @return True if the tile is known and neither a wall nor a door locked without its key.
+   */
+  bool isKnownPassable(Maze::PerceivedTile tile) const;
+
+  /**
+   * @brief Returns the colour of a locked door tile.
+   * @param tile The tile.
+   * @return The colour, or kKeyColours or more if the tile is no locked door.
+   */
+  static uint32_t getDoorColour(Maze::PerceivedTile tile);
+
+  /**
+   * @brief Recomputes whether a cell is on the frontier and updates the frontier set.
+   * @param cell The index of the cell.
+   */
+  void refreshFrontier(uint32_t cell);
+
+  /**
+   * @brief Returns the neighbours of a cell inside the map.
+   * @param cell The index of the cell.
+   * @param neighbors The array to write the neighbour indices to.
+   * @return The number of neighbours written.
+   */
+  uint32_t getNeighbors(uint32_t cell, uint32_t (&neighbors)[4]) const;
+
+  static constexpr uint32_t kNotInFrontier = UINT32_MAX; /**< Marks cells off the frontier. */
+
+  uint32_t rows_; /**< The number of rows of the maze. */
+  uint32_t cols_; /**< The number of columns of the maze. */
+  std::size_t known_count_; /**< The number of known cells. */
+  uint16_t keys_; /**< The keys the agent holds, bit c set for the key of colour c. */
+  std::vector<uint32_t> locked_doors_; /**< The cells believed to be locked doors. */
+  std::vector<Maze::PerceivedTile> tiles_; /**< The believed tile of every cell. */
+  std::vector<Coordinates> frontier_; /**< The frontier cells. */
+  std::vector<uint32_t> frontier_slots_; /**< The index of each cell in frontier_, if any. */
+  std::vector<uint32_t> visit_marks_; /**< The search each cell was last visited in. */
+  std::vector<uint32_t> parents_; /**< The cell each visited cell was reached from. */
+  std::vector<uint32_t> search_queue_; /**< The queue of the nearest frontier search. */
+  uint32_t search_mark_; /**< The mark of the current search, so visits never need clearing. */
+};
+
+}  // namespace maze
+
+#endif  // MAZE_BELIEF_MAP_HPP_
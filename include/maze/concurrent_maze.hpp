@@ -0,0 +1,217 @@
+/**
+ * @file concurrent_maze.hpp
+ * @brief Defines the ConcurrentMaze class, which publishes immutable maze versions to readers.
+ */
+
+#ifndef MAZE_CONCURRENT_MAZE_HPP_
+#define MAZE_CONCURRENT_MAZE_HPP_
+
+// Standard
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Private
+#include "maze.hpp"
+
+namespace maze {
+
+/**
+ * @class ConcurrentMaze
+ * @brief A maze changed by one writer thread and read by any number of threads without locks.
+ *
+ * The writer applies moves and tile changes to a private maze and publishes a copy of it as a
+ * new immutable version. Readers pin the latest version with read() and keep it for as long as
+ * they hold the guard, no matter how many versions are published meanwhile. Old versions are
+ * reclaimed by epochs: a version retired in epoch e is freed, or recycled for a later version,
+ * once no reader announced an epoch at or before e.
+ *
+ * Pinning a version costs a compare-and-swap on a reader slot, usually the one the thread used
+ * last, and one load, so reads never wait for the writer or for each other. Publishing copies the
+ * maze, but versions share the chunks of their grids (see Grid), so a version costs the chunks the
+ * writer changed since the last one and a pointer per chunk. The writer should still batch changes
+ * with update() when readers do not need every intermediate version.
+ *
+ * Only const members of the pinned maze may be called, and neither getAnalytics() nor
+ * getJunctionGraph(), since they cache their result in the maze. Copy the maze to call anything
+ * else.
+ */
+class ConcurrentMaze {
+ private:
+  struct Version;
+  struct ReaderSlot;
+
+ public:
+  static constexpr uint32_t kDefaultReaderSlots = 64; /**< The default number of reader slots. */
+
+  /**
+   * @class ReadGuard
+   * @brief Pins one published version of the maze until it is destroyed.
+   */
+  class ReadGuard {
+   public:
+    ReadGuard(ReadGuard&& other) noexcept;
+    ReadGuard& operator=(ReadGuard&& other) noexcept;
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+
+    /**
+     * @brief Releases the pinned version, which may then be reclaimed by the writer.
+     */
+    ~ReadGuard();
+
+    /**
+     * @brief Returns the pinned maze.
+     * @return A reference to the maze, valid for the lifetime of the guard.
+     */
+    const Maze& operator*() const;
+
+    /**
+     * @brief Returns the pinned maze.
+     * @return A pointer to the maze, valid for the lifetime of the guard.
+     */
+    const Maze* operator->() const;
+
+    /**
+     * @brief Returns the number of the pinned version.
+     * @return The version number, 0 for the maze the concurrent maze was constructed with.
+     */
+    uint64_t getVersion() const;
+
+   private:
+    friend class ConcurrentMaze;
+
+    /**
+     * @brief Constructs a guard for a version pinned through a reader slot.
+     * @param slot The reader slot announcing the epoch of the reader.
+     * @param version The pinned version.
+     */
+    ReadGuard(ReaderSlot* slot, const Version* version);
+
+    ReaderSlot* slot_; /**< The reader slot to release, or nullptr once moved from. */
+    const Version* version_; /**< The pinned version. */
+  };
+
+  /**
+   * @brief Publishes a maze as version 0.
+   * @param maze The maze to start from.
+   * @param reader_slots The number of guards that can be held at the same time. Further readers
+   * spin until a slot is released.
+   * @throws std::invalid_argument If reader_slots is 0.
+   */
+  explicit ConcurrentMaze(const Maze& maze, uint32_t reader_slots = kDefaultReaderSlots);
+
+  /**
+   * @brief Frees every version. No guard may be held anymore.
+   */
+  ~ConcurrentMaze();
+
+  ConcurrentMaze(const ConcurrentMaze&) = delete;
+  ConcurrentMaze& operator=(const ConcurrentMaze&) = delete;
+
+  /**
+   * @brief Pins the latest published version, without waiting for the writer.
+   *
+   * Safe to call from any thread, at the same time as the writer members.
+   *
+   * @return The guard pinning the version.
+   */
+  ReadGuard read() const;
+
+  /**
+   * @brief Moves the player and publishes the result. Writer only.
+   * @param move The direction to move the player.
+   * @return True if the move was successful, false otherwise. Nothing is published on failure.
+   */
+  bool movePlayer(Maze::Move move);
+
+  /**
+   * @brief Replaces the tile of a cell and publishes the result. Writer only.
+   * @param row The row of the cell.
+   * @param col The column of the cell.
+   * @param type The new tile type.
+   * @param value The new tile value, as for Maze::setTileType().
+   * @throws std::invalid_argument As Maze::setTileType(), in which case nothing is published.
+   */
+  void setTileType(uint32_t row, uint32_t col, TileType type, uint8_t value = 0);
+
+  /**
+   * @brief Applies any number of changes to the maze and publishes them as one version. Writer
+   * only.
+   *
+   * If the changes throw, the maze keeps the changes made so far but nothing is published until
+   * the next successful change.
+   *
+   * @param changes The function changing the maze.
+   */
+  void update(const std::function<void(Maze&)>& changes);
+
+  /**
+   * @brief Returns the maze of the writer, which includes every change made so far. Writer only.
+   * @return A reference to the maze of the writer.
+   */
+  const Maze& getWriterMaze() const;
+
+  /**
+   * @brief Returns the number of the latest published version. Writer only.
+   * @return The version number.
+   */
+  uint64_t getVersion() const;
+
+  /**
+   * @brief Returns the number of retired versions that readers may still hold. Writer only.
+   * @return The number of versions waiting to be reclaimed.
+   */
+  std::size_t getRetiredCount() const;
+
+ private:
+  /**
+   * @brief A published, immutable version of the maze.
+   */
+  struct Version {
+    Maze maze; /**< The maze as it was published. */
+    uint64_t number; /**< The version number. */
+  };
+
+  /**
+   * @brief The epoch announced by one reader, on a cache line of its own.
+   */
+  struct alignas(64) ReaderSlot {
+    std::atomic<uint64_t> epoch; /**< The announced epoch, or kIdle. */
+  };
+
+  /**
+   * @brief A version that was replaced, with the epoch it was replaced in.
+   */
+  struct Retired {
+    Version* version; /**< The replaced version. */
+    uint64_t epoch; /**< The epoch at the time it was replaced. */
+  };
+
+  static constexpr uint64_t kIdle = ~uint64_t{0}; /**< Marks a slot without a reader. */
+
+  /**
+   * @brief Publishes a copy of the writer maze, sharing its unchanged grid chunks, as the next
+   * version and reclaims old versions.
+   */
+  void publish();
+
+  /**
+   * @brief Recycles or frees the retired versions no reader can hold anymore.
+   */
+  void reclaim();
+
+  Maze maze_; /**< The maze of the writer. */
+  std::unique_ptr<ReaderSlot[]> slots_; /**< The epochs announced by the readers. */
+  uint32_t slot_count_; /**< The number of reader slots. */
+  std::atomic<Version*> current_; /**< The latest published version. */
+  std::atomic<uint64_t> epoch_; /**< The global epoch, advanced on every publication. */
+  std::vector<Retired> retired_; /**< Replaced versions, oldest first. */
+  std::vector<std::unique_ptr<Version>> spare_; /**< Reclaimed versions to copy the next into. */
+};
+
+}  // namespace maze
+
+#endif  // MAZE_CONCURRENT_MAZE_HPP_
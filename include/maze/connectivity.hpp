@@ -0,0 +1,192 @@
+/**
+ * @file connectivity.hpp
+ * @brief Defines the DynamicConnectivity class, which tracks connected cells as walls change.
+ */
+
+#ifndef MAZE_CONNECTIVITY_HPP_
+#define MAZE_CONNECTIVITY_HPP_
+
+// Standard
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Private
+#include "coordinates.hpp"
+#include "grid.hpp"
+#include "random.hpp"
+
+namespace maze {
+
+/**
+ * @class DynamicConnectivity
+ * @brief Answers whether two cells are connected while walls appear and disappear.
+ *
+ * A spanning forest of the passable cells is kept as Euler tours, each stored in a treap with
+ * parent pointers. Two cells are connected if their tours share a treap root, found in expected
+ * O(log n). Opening a cell links it to its open neighbours in O(log n) each. Closing a cell cuts
+ * its tree edges, which splits its tree into up to four pieces. The pieces are then joined again
+ * through replacement edges, searched for from the smaller pieces only: the grid graph lists every
+ * cell's edges implicitly, so no non-tree edge sets have to be kept up to date. Closing a cell
+ * costs O(k log n), where k is the size of all but the largest piece, and is fast whenever a wall
+ * cuts off little or nothing.
+ *
+ * Only walls block, doors count as open whatever keys the player holds.
+ */
+class DynamicConnectivity {
+ public:
+  /**
+   * @brief Builds the spanning forest of the passable cells of a grid, in linear time.
+   * @param grid The grid to track.
+   */
+  explicit DynamicConnectivity(const Grid& grid);
+
+  /**
+   * @brief Returns whether or not a cell is open.
+   * @param pos The cell.
+   * @return True if the cell is passable, false otherwise.
+   */
+  bool isOpen(const Coordinates& pos) const;
+
+  /**
+   * @brief Opens or closes a cell.
+   * @param pos The cell.
+   * @param open Whether the cell becomes passable or a wall.
+   */
+  void setOpen(const Coordinates& pos, bool open);
+
+  /**
+   * @brief Returns whether or not two open cells are connected through open cells.
+   * @param a The first cell.
+   * @param b The second cell.
+   * @return True if both cells are open and connected, false otherwise.
+   */
+  bool isConnected(const Coordinates& a, const Coordinates& b) const;
+
+  /**
+   * @brief Returns the number of cells connected to an open cell, the cell included.
+   * @param pos The cell.
+   * @return The size of the component of the cell, 0 if the cell is closed.
+   */
+  uint32_t getComponentSize(const Coordinates& pos) const;
+
+ private:
+  static constexpr uint32_t kNil = std::numeric_limits<uint32_t>::max(); /**< No node. */
+
+  /**
+   * @brief An element of an Euler tour: a cell, or one direction of a tree edge.
+   */
+  struct Node {
+    uint32_t left = kNil; /**< The left child in the treap. */
+    uint32_t right = kNil; /**< The right child in the treap. */
+    uint32_t parent = kNil; /**< The parent in the treap. */
+    uint32_t priority = 0; /**< The random heap priority. */
+    uint32_t size = 1; /**< The number of tour elements in the subtree. */
+    uint32_t cells = 0; /**< The number of cell elements in the subtree. */
+  };
+
+  /**
+   * @brief Returns the number of tour elements in a subtree.
+   * @param node The root of the subtree, or kNil.
+   * @return The number of elements.
+   */
+  uint32_t getSize(uint32_t node) const { return node == kNil ? 0 : nodes_[node].size; }
+
+  /**
+   * @brief Returns the number of cells in a subtree.
+   * @param node The root of the subtree, or kNil.
+   * @return The number of cell elements.
+   */
+  uint32_t getCells(uint32_t node) const { return node == kNil ? 0 : nodes_[node].cells; }
+
+  /**
+   * @brief Recomputes the sizes of a node from its children.
+   * @param node The node.
+   */
+  void update(uint32_t node);
+
+  /**
+   * @brief Concatenates two tours.
+   * @param left The root of the first tour.
+   * @param right The root of the second tour.
+   * @return The root of the joined tour.
+   */
+  uint32_t merge(uint32_t left, uint32_t right);
+
+  /**
+   * @brief Splits a tour after its first count elements.
+   * @param root The root of the tour.
+   * @param count The number of elements of the first part.
+   * @param left Receives the root of the first part.
+   * @param right Receives the root of the second part.
+   */
+  void split(uint32_t root, uint32_t count, uint32_t& left, uint32_t& right);
+
+  /**
+   * @brief Returns the treap root of the tour a node is in.
+   * @param node The node.
+   * @return The root.
+   */
+  uint32_t findRoot(uint32_t node) const;
+
+  /**
+   * @brief Returns the position of a node within its tour.
+   * @param node The node.
+   * @return The number of elements before the node.
+   */
+  uint32_t getPosition(uint32_t node) const;
+
+  /**
+   * @brief Rotates the tour of a cell so that it starts at the cell.
+   * @param cell The cell.
+   * @return The root of the rotated tour.
+   */
+  uint32_t reroot(uint32_t cell);
+
+  /**
+   * @brief Joins the trees of two adjacent cells by the edge between them.
+   * @param cell The first cell.
+   * @param direction The direction of the second cell from the first one.
+   */
+  void link(uint32_t cell, uint32_t direction);
+
+  /**
+   * @brief Removes a tree edge, splitting its tree in two.
+   * @param cell The first cell.
+   * @param direction The direction of the second cell from the first one.
+   */
+  void cut(uint32_t cell, uint32_t direction);
+
+  /**
+   * @brief Returns the neighbour of a cell.
+   * @param cell The cell.
+   * @param direction 0 to 3 for up, down, left and right.
+   * @return The neighbour, or kNil if it lies outside the grid.
+   */
+  uint32_t getNeighbor(uint32_t cell, uint32_t direction) const;
+
+  /**
+   * @brief Allocates a node for one direction of a tree edge.
+   * @return The node.
+   */
+  uint32_t allocateEdgeNode();
+
+  /**
+   * @brief Appends the cells of a tour to a list, in no particular order.
+   * @param root The root of the tour.
+   * @param cells The list to append to.
+   */
+  void collectCells(uint32_t root, std::vector<uint32_t>& cells) const;
+
+  uint32_t rows_; /**< The number of rows of the grid. */
+  uint32_t cols_; /**< The number of columns of the grid. */
+  std::vector<bool> open_; /**< Whether or not each cell is passable. */
+  std::vector<Node> nodes_; /**< Cell nodes first, one per cell, then edge nodes. */
+  std::vector<uint32_t> edge_nodes_; /**< Per cell and direction, the edge node leaving it. */
+  std::vector<uint32_t> free_nodes_; /**< Edge nodes available for reuse. */
+  RandomGenerator random_; /**< Draws the treap priorities. */
+};
+
+}  // namespace maze
+
+#endif  // MAZE_CONNECTIVITY_HPP_
@@ -0,0 +1,97 @@
+/**
+ * @file eller_generator.hpp
+ * @brief Defines the EllerGenerator class, which streams a maze one row at a time.
+ */
+
+#ifndef MAZE_ELLER_GENERATOR_HPP_
+#define MAZE_ELLER_GENERATOR_HPP_
+
+// Standard
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Private
+#include "coordinates.hpp"
+#include "grid.hpp"
+#include "placement.hpp"
+
+namespace maze {
+
+/**
+ * @class EllerGenerator
+ * @brief Generates a maze row by row with Eller's algorithm, keeping only O(cols) state.
+ *
+ * The carved maze is perfect, with rooms at odd rows and columns like the mazes built by the Maze
+ * class. Walls, food, doors and terrain are then placed with the counts Maze::generateMaze uses
+ * for the same difficulty and placement options. The number of open cells of a perfect maze is
+ * known up front, so selection sampling places exactly these counts, uniformly and cell by cell.
+ * The placement distribution and key colours need the whole maze and are ignored. Start and end
+ * are placed on the outer wall, next to a room, and are known before the first row is emitted.
+ */
+class EllerGenerator {
+ public:
+  /**
+   * @brief Receives one finished row of the maze.
+   * @param row The index of the row.
+   * @param cells The cells of the row, from left to right.
+   */
+  using RowCallback = std::function<void(uint32_t row, const std::vector<Cell>& cells)>;
+
+  /**
+   * @brief Constructs a new generator.
+   * @param rows The number of rows in the maze.
+   * @param cols The number of columns in the maze.
+   * @param difficulty The difficulty of the maze, represented as a value between 0 and 1.
+   * @param seed The seed to generate from.
+   * @param placement The densities and terrain costs of the placed items.
+   * @throws std::invalid_argument If the maze has fewer than three rows or columns.
+   */
+  EllerGenerator(uint32_t rows, uint32_t cols, double difficulty, uint64_t seed,
+                 const PlacementOptions& placement = PlacementOptions());
+
+  /**
+   * @brief Generates the maze and passes each row to the callback, from top to bottom.
+   * @param emit The callback receiving the rows.
+   */
+  void generate(const RowCallback& emit) const;
+
+  /**
+   * @brief Generates the maze into a grid, for example one backed by a memory-mapped file.
+   * @param grid The grid to write to, which must have the dimensions of the maze.
+   * @throws std::invalid_argument If the grid dimensions do not match.
+   */
+  void generate(Grid& grid) const;
+
+  /**
+   * @brief Returns the start position of the maze.
+   * @return A coordinates object representing the start position.
+   */
+  Coordinates getStartPosition() const;
+
+  /**
+   * @brief Returns the end position of the maze.
+   * @return A coordinates object representing the end position.
+   */
+  Coordinates getEndPosition() const;
+
+ private:
+  /**
+   * @brief Returns the border cell with the given index among all cells next to a room.
+   * @param index The index of the border cell.
+   * @return The coordinates of the border cell.
+   */
+  Coordinates getBorderCandidate(uint64_t index) const;
+
+  uint32_t rows_; /**< The number of rows in the maze. */
+  uint32_t cols_; /**< The number of columns in the maze. */
+  double difficulty_; /**< The difficulty of the maze. */
+  uint64_t seed_; /**< The seed to generate from. */
+  PlacementOptions placement_; /**< The densities and terrain costs of the placed items. */
+  Coordinates start_pos_; /**< The start position of the maze. */
+  Coordinates end_pos_; /**< The end position of the maze. */
+};
+
+}  // namespace maze
+
+#endif  // MAZE_ELLER_GENERATOR_HPP_
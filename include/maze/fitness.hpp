@@ -0,0 +1,50 @@
+/**
+ * @file fitness.hpp
+ * @brief Defines the parallel evaluation of candidate move sequences on one maze.
+ */
+
+#ifndef MAZE_FITNESS_HPP_
+#define MAZE_FITNESS_HPP_
+
+// Standard
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Private
+#include "maze.hpp"
+
+namespace maze {
+
+/**
+ * @brief The fitness data of one candidate move sequence.
+ */
+struct CandidateFitness {
+  uint32_t steps_survived = 0; /**< The moves made before starving, finishing or running out. */
+  uint32_t food_collected = 0; /**< The number of food tiles eaten. */
+  uint32_t food = 0; /**< The food carried after the last move. */
+  std::optional<uint32_t> distance_to_goal; /**< Moves from the final position to the end. */
+  bool reached_goal = false; /**< Whether the end was reached. */
+};
+
+/**
+ * @brief Plays candidate move sequences on a maze in parallel and scores them.
+ *
+ * Every candidate starts from the current player state of the maze and follows the rules of
+ * Maze::movePlayer(), through the step() forward model. A candidate stops as soon as it reaches
+ * the end or runs out of food. The maze is turned into one Layout shared by all candidates, which
+ * only keep their own game state, and distances to the end are computed once with a breadth-first
+ * search, so a candidate costs about one step per move.
+ *
+ * @param maze The maze to play on.
+ * @param candidates The move sequences to evaluate.
+ * @param threads The number of threads to evaluate with, 0 for one per hardware thread.
+ * @return One result per candidate, in the same order.
+ */
+std::vector<CandidateFitness> evaluateCandidates(
+    const Maze& maze, const std::vector<std::vector<Maze::Move>>& candidates,
+    uint32_t threads = 0);
+
+}  // namespace maze
+
+#endif  // MAZE_FITNESS_HPP_
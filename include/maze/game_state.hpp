@@ -0,0 +1,327 @@
+/**
+ * @file game_state.hpp
+ * @brief Defines an immutable maze layout and a value-type game state with a pure forward model.
+ */
+
+#ifndef MAZE_GAME_STATE_HPP_
+#define MAZE_GAME_STATE_HPP_
+
+// Standard
+#include <bitset>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Private
+#include "coordinates.hpp"
+#include "grid.hpp"
+#include "maze.hpp"
+
+namespace maze {
+
+/**
+ * @brief The state of a game that changes with moves, small enough to be branched by copying.
+ *
+ * Food that was eaten is tracked per food tile of the layout, so the tiles themselves never
+ * change and one layout can be shared by any number of states. The capacity bounds the food
+ * tiles of the layouts the state can be used with, visitInitialState() picks the smallest one.
+ *
+ * @tparam MaxFoodTiles The number of food tiles the state can track, a multiple of 64.
+ */
+template <uint32_t MaxFoodTiles>
+struct BasicGameState {
+  static_assert(MaxFoodTiles > 0 && MaxFoodTiles % 64 == 0,
+                "Eaten food is tracked in whole 64-bit words.");
+
+  static constexpr uint32_t kMaxFoodTiles = MaxFoodTiles; /**< The food tiles it can track. */
+
+  Coordinates position; /**< The position of the player. */
+  uint32_t food; /**< The food the player carries. */
+  uint16_t keys; /**< The keys the player carries, bit c set for the key of colour c. */
+  uint64_t eaten_food[kMaxFoodTiles / 64]; /**< Bit i is set once food tile i was eaten. */
+
+  /**
+   * @brief Returns a state without eaten food for a layout with the given number of food tiles.
+   * @param food_tiles The number of food tiles of the layout.
+   * @return The state, with position, food and keys left to the caller.
+   * @throws std::invalid_argument If the state cannot track that many food tiles.
+   */
+  static BasicGameState withCapacity(uint32_t food_tiles) {
+    if (food_tiles > kMaxFoodTiles) {
+      throw std::invalid_argument("This game state can track at most "
+                                  + std::to_string(kMaxFoodTiles) + " food tiles.");
+    }
+    return BasicGameState();
+  }
+
+  /**
+   * @brief Returns whether a food tile was eaten.
+   * @param food_index The index of the food tile in the layout.
+   * @return True if the food tile was eaten, false otherwise.
+   */
+  bool isEaten(uint32_t food_index) const {
+    return (eaten_food[food_index / 64] >> (food_index % 64)) & 1;
+  }
+
+  /**
+   * @brief Marks a food tile as eaten.
+   * @param food_index The index of the food tile in the layout.
+   */
+  void setEaten(uint32_t food_index) {
+    eaten_food[food_index / 64] |= uint64_t{1} << (food_index % 64);
+  }
+
+  /**
+   * @brief Returns the number of food tiles eaten.
+   * @return The number of eaten food tiles.
+   */
+  uint32_t getEatenCount() const {
+    uint32_t count = 0;
+    for (const uint64_t word : eaten_food) {
+      count += static_cast<uint32_t>(std::bitset<64>(word).count());
+    }
+    return count;
+  }
+};
+
+/**
+ * @brief The game state for layouts with up to 256 food tiles, a 48 byte copy.
+ */
+using GameState = BasicGameState<256>;
+
+static_assert(std::is_trivially_copyable<GameState>::value,
+              "Game states are branched by copying their bytes.");
+
+/**
+ * @brief A game state for layouts with any number of food tiles.
+ *
+ * The eaten food lives on the heap, so copies allocate. Only used for layouts too large for every
+ * BasicGameState visitInitialState() picks from.
+ */
+struct LargeGameState {
+  Coordinates position; /**< The position of the player. */
+  uint32_t food; /**< The food the player carries. */
+  uint16_t keys; /**< The keys the player carries, bit c set for the key of colour c. */
+  std::vector<uint64_t> eaten_food; /**< Bit i is set once food tile i was eaten. */
+
+  /**
+   * @brief Returns a state without eaten food for a layout with the given number of food tiles.
+   * @param food_tiles The number of food tiles of the layout.
+   * @return The state, with position, food and keys left to the caller.
+   */
+  static LargeGameState withCapacity(uint32_t food_tiles) {
+    LargeGameState state = {};
+    state.eaten_food.assign((static_cast<std::size_t>(food_tiles) + 63) / 64, 0);
+    return state;
+  }
+
+  /**
+   * @brief Returns whether a food tile was eaten.
+   * @param food_index The index of the food tile in the layout.
+   * @return True if the food tile was eaten, false otherwise.
+   */
+  bool isEaten(uint32_t food_index) const {
+    return (eaten_food[food_index / 64] >> (food_index % 64)) & 1;
+  }
+
+  /**
+   * @brief Marks a food tile as eaten.
+   * @param food_index The index of the food tile in the layout.
+   */
+  void setEaten(uint32_t food_index) {
+    eaten_food[food_index / 64] |= uint64_t{1} << (food_index % 64);
+  }
+
+  /**
+   * @brief Returns the number of food tiles eaten.
+   * @return The number of eaten food tiles.
+   */
+  uint32_t getEatenCount() const {
+    uint32_t count = 0;
+    for (const uint64_t word : eaten_food) {
+      count += static_cast<uint32_t>(std::bitset<64>(word).count());
+    }
+    return count;
+  }
+};
+
+/**
+ * @class Layout
+ * @brief An immutable snapshot of the tiles of a maze, shared by game states.
+ */
+class Layout {
+ public:
+  /**
+   * @brief Takes a snapshot of the tiles of a maze.
+   * @param maze The maze to take the snapshot of.
+   */
+  explicit Layout(const Maze& maze);
+
+  /**
+   * @brief Returns the state of the player of the maze at the time of the snapshot.
+   * @tparam State The state type, which must be able to track every food tile of the layout.
+   * @return The initial game state.
+   * @throws std::invalid_argument If the state type cannot track that many food tiles.
+   */
+  template <typename State = GameState>
+  State getInitialState() const {
+    State state = State::withCapacity(getFoodCount());
+    state.position = initial_position_;
+    state.food = initial_food_;
+    state.keys = initial_keys_;
+    return state;
+  }
+
+  /**
+   * @brief Returns the index of the food tile at a position.
+   * @param pos The position of the food tile.
+   * @return The index among the food tiles of the layout, or -1 if there is no food tile.
+   */
+  int32_t getFoodIndex(const Coordinates& pos) const;
+
+  /**
+   * @brief Returns the number of food tiles.
+   * @return The number of food tiles.
+   */
+  uint32_t getFoodCount() const;
+
+  /**
+   * @brief Returns the tiles of the layout.
+   * @return The grid of cells.
+   */
+  const Grid& getGrid() const;
+
+  /**
+   * @brief Returns the end position.
+   * @return The end position.
+   */
+  Coordinates getEndPosition() const;
+
+ private:
+  Grid grid_; /**< The tiles of the maze. */
+  Coordinates end_pos_; /**< The end position. */
+  std::vector<uint64_t> food_cells_; /**< The sorted cell indices of the food tiles. */
+  Coordinates initial_position_; /**< The player position at the time of the snapshot. */
+  uint32_t initial_food_; /**< The food the player carried at the time of the snapshot. */
+  uint16_t initial_keys_; /**< The keys the player carried at the time of the snapshot. */
+};
+
+/**
+ * @brief Calls a function with the initial state of a layout, in the smallest state type that
+ * can track all of its food tiles.
+ *
+ * States of up to 65536 food tiles are trivially copyable, larger layouts use LargeGameState.
+ * The function is instantiated for every state type and has to return the same type for all.
+ *
+ * @param layout The layout.
+ * @param function The function taking the initial state.
+ * @return The result of the function.
+ */
+template <typename Function>
+decltype(auto) visitInitialState(const Layout& layout, Function&& function) {
+  const uint32_t food_tiles = layout.getFoodCount();
+  if (food_tiles <= GameState::kMaxFoodTiles) {
+    return function(layout.getInitialState<GameState>());
+  } else if (food_tiles <= 4096) {
+    return function(layout.getInitialState<BasicGameState<4096>>());
+  } else if (food_tiles <= 65536) {
+    return function(layout.getInitialState<BasicGameState<65536>>());
+  }
+  return function(layout.getInitialState<LargeGameState>());
+}
+
+/**
+ * @brief Applies a move to a game state, with the rules of Maze::movePlayer() and Player.
+ *
+ * Moves into walls, locked doors without their key or out of the layout leave the state
+ * unchanged. Otherwise the player moves, picks up uneaten food or a key on the new tile and
+ * consumes the move cost of the tile in food.
+ *
+ * This is the one forward model of the library: step(), trajectory replay and candidate
+ * evaluation all move through it. It changes the state in place, so large states are not copied.
+ *
+ * @param layout The layout the game is played on.
+ * @param state The state to apply the move to.
+ * @param move The move to apply.
+ * @return True if the player moved, false if the state is unchanged.
+ */
+template <typename State>
+bool applyMove(const Layout& layout, State& state, Maze::Move move) {
+  Coordinates next = state.position;
+  switch (move) {
+  case Maze::Move::LEFT:
+    next.col--;
+    break;
+  case Maze::Move::RIGHT:
+    next.col++;
+    break;
+  case Maze::Move::UP:
+    next.row--;
+    break;
+  case Maze::Move::DOWN:
+    next.row++;
+    break;
+  }
+
+  const Grid& grid = layout.getGrid();
+  if (next.row >= grid.getRows() || next.col >= grid.getCols()) {
+    return false;
+  }
+  const Cell cell = grid.get(next.row, next.col);
+  if (!isPassable(cell, state.keys)) {
+    return false;
+  }
+
+  if (cell.type == TileType::FOOD) {
+    const uint32_t food_index = static_cast<uint32_t>(layout.getFoodIndex(next));
+    if (!state.isEaten(food_index)) {
+      state.setEaten(food_index);
+      // Same as Player::pickFood().
+      state.food += cell.value;
+      if (state.food > Maze::kMaxFood) {
+        state.food = Maze::kMaxFood - cell.value;
+      }
+    }
+  }
+
+  if (cell.type == TileType::KEY) {
+    // Key tiles of a colour that is held already change nothing, so they need no tracking.
+    state.keys |= static_cast<uint16_t>(1u << (cell.value - 1));
+  }
+
+  state.position = next;
+  // Same as Player::consumeFood().
+  const uint32_t cost = getMoveCost(cell);
+  state.food -= cost < state.food ? cost : state.food;
+  return true;
+}
+
+/**
+ * @brief Returns the state after a move, with the rules of applyMove().
+ * @param layout The layout the game is played on.
+ * @param state The state to apply the move to.
+ * @param move The move to apply.
+ * @return The state after the move.
+ */
+template <typename State>
+State step(const Layout& layout, State state, Maze::Move move) {
+  applyMove(layout, state, move);
+  return state;
+}
+
+/**
+ * @brief Returns whether a game is over, because the end was reached or the food ran out.
+ * @param layout The layout the game is played on.
+ * @param state The state to check.
+ * @return True if the game is over, false otherwise.
+ */
+template <typename State>
+bool isTerminal(const Layout& layout, const State& state) {
+  return state.position == layout.getEndPosition() || state.food == 0;
+}
+
+}  // namespace maze
+
+#endif  // MAZE_GAME_STATE_HPP_
@@ -0,0 +1,115 @@
+/**
+ * @file generation.hpp
+ * @brief Defines the options and routines used to carve generated mazes.
+ */
+
+#ifndef MAZE_GENERATION_HPP_
+#define MAZE_GENERATION_HPP_
+
+// Standard
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+// Private
+#include "grid.hpp"
+#include "placement.hpp"
+#include "random.hpp"
+
+namespace maze {
+
+/**
+ * @enum GenerationAlgorithm
+ * @brief The algorithms available for carving perfect mazes.
+ */
+enum class GenerationAlgorithm {
+  RECURSIVE_BACKTRACKER, /**< Depth-first search, long corridors with few junctions. */
+  KRUSKAL, /**< Randomized Kruskal with union-find, many short dead ends. */
+  PRIM, /**< Randomized Prim, grows outwards from one room with many junctions. */
+  WILSON /**< Loop-erased random walks, a uniformly drawn spanning tree. */
+};
+
+/**
+ * @brief A rectangular block of rooms. Room (r, c) of the maze sits at grid cell (2r+1, 2c+1).
+ */
+struct RoomRegion {
+  uint32_t first_row; /**< The first room row of the region. */
+  uint32_t first_col; /**< The first room column of the region. */
+  uint32_t rows; /**< The number of room rows in the region. */
+  uint32_t cols; /**< The number of room columns in the region. */
+};
+
+/**
+ * @class Carver
+ * @brief The interface of algorithms that carve a perfect maze into a region of rooms.
+ */
+class Carver {
+ public:
+  /**
+   * @brief Virtual destructor for the Carver class.
+   */
+  virtual ~Carver() = default;
+
+  /**
+   * @brief Opens every room of the region and the passages of a spanning tree between them.
+   *
+   * The grid cells of the region are walls when this is called. Implementations may only write
+   * to cells inside the region, since other regions can be carved at the same time. Exceptions
+   * reach the caller of the generation once every region being carved has finished.
+   *
+   * @param grid The grid to carve into.
+   * @param region The region of rooms to carve.
+   * @param rng The random number generator to carve with.
+   */
+  virtual void carve(Grid& grid, const RoomRegion& region, RandomGenerator& rng) const = 0;
+};
+
+/**
+ * @brief Creates the carver implementing the given algorithm.
+ * @param algorithm The algorithm to create a carver for.
+ * @return A unique pointer to the carver.
+ */
+std::unique_ptr<Carver> makeCarver(GenerationAlgorithm algorithm);
+
+/**
+ * @brief Options that control how a maze is generated.
+ */
+struct GenerationOptions {
+  std::optional<uint64_t> seed; /**< The seed to generate from, drawn randomly if not set. */
+
+  /**
+   * @brief The algorithm used to carve the maze.
+   */
+  GenerationAlgorithm algorithm = GenerationAlgorithm::RECURSIVE_BACKTRACKER;
+
+  std::shared_ptr<const Carver> carver; /**< If set, used instead of the algorithm above. */
+
+  /**
+   * @brief The edge length in cells of the regions that are carved independently.
+   *
+   * With 0 the whole maze is carved as a single region. Otherwise the regions are carved in
+   * parallel and then joined along their borders. The resulting maze depends on the seed and the
+   * region size, but never on the number of threads.
+   */
+  uint32_t region_size = 0;
+
+  uint32_t threads = 0; /**< The number of threads to carve with, 0 for one per hardware thread. */
+
+  PlacementOptions placement; /**< Densities and distribution of walls, food and doors. */
+};
+
+/**
+ * @brief Carves a perfect maze into a grid.
+ *
+ * Rooms sit at odd rows and columns and are joined through the cells between them, everything
+ * else is set to walls. Every room is reachable from every other room along exactly one path.
+ *
+ * @param grid The grid to carve into.
+ * @param seed The seed to carve with.
+ * @param options The options controlling the algorithm, regions and threads.
+ */
+void carvePerfectMaze(Grid& grid, uint64_t seed, const GenerationOptions& options);
+
+}  // namespace maze
+
+#endif  // MAZE_GENERATION_HPP_
@@ -0,0 +1,325 @@
+/**
+ * @file grid.hpp
+ * @brief Defines the compact cell storage used by the maze game.
+ */
+
+#ifndef MAZE_GRID_HPP_
+#define MAZE_GRID_HPP_
+
+// Standard
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Private
+#include "tiles.hpp"
+
+namespace maze {
+
+/**
+ * @enum TileType
+ * @brief The kinds of tiles a grid cell can hold.
+ */
+enum class TileType : uint8_t { EMPTY, WALL, DOOR, FOOD, KEY, MUD, WATER };
+
+constexpr uint32_t kKeyColours = 16; /**< The number of distinct key and door colours. */
+constexpr uint8_t kDefaultMudCost = 3; /**< The food it costs to enter mud by default. */
+constexpr uint8_t kDefaultWaterCost = 5; /**< The food it costs to enter water by default. */
+
+/**
+ * @brief A single grid cell: the tile type plus a type specific value (e.g. the food weight).
+ *
+ * Doors hold 0 when they are unlocked and colour + 1 when they need the key of that colour. Keys
+ * hold colour + 1. Mud and water hold the food it costs to enter them.
+ */
+struct Cell {
+  TileType type; /**< The type of the tile stored in this cell. */
+  uint8_t value; /**< Type specific payload, the weight for food or the colour of locks. */
+
+  bool operator==(const Cell& other) const {
+    return other.type == type && other.value == value;
+  }
+
+  bool operator!=(const Cell& other) const {
+    return other.type != type || other.value != value;
+  }
+};
+
+static_assert(sizeof(Cell) == 2, "Cells are stored as two bytes, also in grid files.");
+
+/**
+ * @brief Returns whether or not a cell with the given type can be passed through.
+ * @param type The tile type to check.
+ * @return True if the tile type is passable, false otherwise.
+ */
+inline bool isPassable(TileType type) {
+  return type != TileType::WALL;
+}
+
+/**
+ * @brief Returns whether or not a cell can be passed through by a player holding some keys.
+ * @param cell The cell to check.
+ * @param keys The held keys, bit c set for the key of colour c.
+ * @return True if the cell is neither a wall nor a door locked with a key that is not held.
+ */
+inline bool isPassable(const Cell& cell, uint16_t keys) {
+  if (cell.type == TileType::DOOR && cell.value > 0) {
+    return (keys >> (cell.value - 1)) & 1;
+  }
+  return cell.type != TileType::WALL;
+}
+
+/**
+ * @brief Returns the food it costs to enter a cell.
+ * @param cell The cell to enter.
+ * @return The cost stored in mud and water cells, at least 1, and 1 for all other cells.
+ */
+inline uint32_t getMoveCost(const Cell& cell) {
+  if (cell.type == TileType::MUD || cell.type == TileType::WATER) {
+    return cell.value > 1 ? cell.value : 1;
+  }
+  return 1;
+}
+
+/**
+ * @brief Creates a Tile object representing the given cell.
+ * @param cell The cell to convert.
+ * @return A shared pointer to a tile equivalent to the cell.
+ */
+std::shared_ptr<Tile> makeTile(const Cell& cell);
+
+/**
+ * @enum GridLayout
+ * @brief The order in which cells are stored in memory.
+ */
+enum class GridLayout {
+  ROW_MAJOR, /**< Cells are stored row by row. */
+  TILED /**< Cells are stored in square blocks, each block in Morton (Z) order. */
+};
+
+/**
+ * @brief Describes where and how the cells of a grid are stored.
+ */
+struct GridStorage {
+  GridLayout layout = GridLayout::ROW_MAJOR; /**< The in-memory order of the cells. */
+  std::string file_path; /**< If not empty, the cells are kept in this memory-mapped file. */
+
+  /**
+   * @brief Whether to map the cells already stored in the file instead of starting empty.
+   *
+   * The file must exist and hold exactly the cells of a grid with the same size and layout. Only
+   * grids can be opened this way: mazes write every cell and do not store their start and end in
+   * the file, so their constructors reject it.
+   */
+  bool open_existing = false;
+};
+
+/**
+ * @class Grid
+ * @brief A rectangular grid of cells, stored on the heap or in a memory-mapped file.
+ *
+ * In the tiled layout the grid is split into blocks of kBlockSize x kBlockSize cells. Blocks are
+ * laid out row by row and the cells inside a block follow the Morton (Z) order, so that cells that
+ * are close to each other vertically are also close to each other in memory. Copies of a grid
+ * always live on the heap, even if the original is memory-mapped.
+ *
+ * Heap storage is split into reference-counted chunks of kChunkSize consecutive storage cells.
+ * Copies share the chunks of the original until either of them writes to a chunk, which then gets
+ * a copy of its own, so a copy costs one pointer per chunk and a write at most one chunk copy.
+ * Grids sharing chunks may be read and written from different threads.
+ */
+class Grid {
+ public:
+  static constexpr uint32_t kBlockBits = 5; /**< Log2 of the block edge length. */
+  static constexpr uint32_t kBlockSize = 1u << kBlockBits; /**< The block edge length. */
+  static constexpr uint32_t kChunkBits = 14; /**< Log2 of the cells per shared chunk. */
+  static constexpr uint32_t kChunkSize = 1u << kChunkBits; /**< The cells per shared chunk. */
+
+  /**
+   * @brief Constructs an empty grid with zero rows and columns.
+   */
+  Grid();
+
+  /**
+   * @brief Constructs a new grid with all cells set to empty tiles.
+   * @param rows The number of rows in the grid.
+   * @param cols The number of columns in the grid.
+   * @param storage The storage layout and backing to use.
+   * @throws std::runtime_error If the memory-mapped file cannot be created, or an existing file
+   * cannot be opened or does not match the size of the grid.
+   */
+  Grid(uint32_t rows, uint32_t cols, const GridStorage& storage = GridStorage());
+
+  Grid(const Grid& other);
+  Grid(Grid&& other) noexcept;
+  Grid& operator=(const Grid& other);
+  Grid& operator=(Grid&& other) noexcept;
+  ~Grid();
+
+  /**
+   * @brief Returns the number of rows in the grid.
+   * @return The number of rows in the grid.
+   */
+  uint32_t getRows() const { return rows_; }
+
+  /**
+   * @brief Returns the number of columns in the grid.
+   * @return The number of columns in the grid.
+   */
+  uint32_t getCols() const { return cols_; }
+
+  /**
+   * @brief Returns the layout the cells are stored in.
+   * @return The layout of the grid.
+   */
+  GridLayout getLayout() const { return layout_; }
+
+  /**
+   * @brief Returns whether or not the cells live in a memory-mapped file.
+   * @return True if the grid is memory-mapped, false otherwise.
+   */
+  bool isMapped() const { return mapping_ != nullptr; }
+
+  /**
+   * @brief Returns the offset of a cell within the underlying storage.
+   * @param row The row of the cell.
+   * @param col The column of the cell.
+   * @return The storage offset of the cell.
+   */
+  std::size_t index(uint32_t row, uint32_t col) const {
+    if (layout_ == GridLayout::ROW_MAJOR) {
+      return static_cast<std::size_t>(row) * cols_ + col;
+    }
+    const std::size_t block = static_cast<std::size_t>(row >> kBlockBits) * blocks_per_row_
+                              + (col >> kBlockBits);
+    return (block << (2 * kBlockBits)) | interleave(row & (kBlockSize - 1), col & (kBlockSize - 1));
+  }
+
+  /**
+   * @brief Returns the cell at the specified position.
+   * @param row The row of the cell.
+   * @param col The column of the cell.
+   * @return The cell at the specified position.
+   */
+  Cell get(uint32_t row, uint32_t col) const {
+    const std::size_t offset = index(row, col);
+    return chunks_[offset >> kChunkBits][offset & (kChunkSize - 1)];
+  }
+
+  /**
+   * @brief Replaces the cell at the specified position, copying its chunk first if it is shared.
+   * @param row The row of the cell.
+   * @param col The column of the cell.
+   * @param cell The new cell value.
+   */
+  void set(uint32_t row, uint32_t col, Cell cell) {
+    const std::size_t offset = index(row, col);
+    writableChunk(offset >> kChunkBits)[offset & (kChunkSize - 1)] = cell;
+  }
+
+  /**
+   * @brief Sets all cells of the grid to the given value.
+   * @param cell The value to assign to every cell.
+   */
+  void fill(Cell cell);
+
+  /**
+   * @brief Writes pending changes of a memory-mapped grid back to its file.
+   */
+  void flush();
+
+ private:
+  /**
+   * @brief A chunk of heap storage, shared by the grids copied from one another.
+   */
+  struct Chunk {
+    std::atomic<uint32_t> references; /**< The number of grids holding the chunk. */
+    Cell cells[kChunkSize]; /**< The cells of the chunk. */
+  };
+
+  /**
+   * @brief Returns the cells of a chunk for writing, copying the chunk if other grids share it.
+   * @param chunk The index of the chunk.
+   * @return The cells of the chunk, owned by this grid alone.
+   */
+  Cell* writableChunk(std::size_t chunk) {
+    // The acquire pairs with the release of the last other holder, whose reads then happened
+    // before any write here.
+    if (!owned_.empty() && owned_[chunk]->references.load(std::memory_order_acquire) > 1) {
+      return unshare(chunk);
+    }
+    return chunks_[chunk];
+  }
+
+  /**
+   * @brief Replaces a shared chunk with a copy owned by this grid alone.
+   * @param chunk The index of the chunk.
+   * @return The cells of the copy.
+   */
+  Cell* unshare(std::size_t chunk);
+
+  /**
+   * @brief Shares the storage of another grid, or copies it to the heap if it is memory-mapped.
+   * @param other The grid to share. This grid must hold no storage.
+   */
+  void share(const Grid& other);
+
+  /**
+   * @brief Drops one reference to a chunk, freeing it with the last one.
+   * @param chunk The chunk to release.
+   */
+  static void releaseChunk(Chunk* chunk);
+
+  /**
+   * @brief Interleaves the bits of a row and column offset inside a block.
+   * @param row The row offset inside the block.
+   * @param col The column offset inside the block.
+   * @return The Morton code of the offset.
+   */
+  static std::size_t interleave(uint32_t row, uint32_t col) {
+    return spread(col) | (spread(row) << 1);
+  }
+
+  /**
+   * @brief Spreads the lower kBlockBits bits of a value so that a zero bit follows each of them.
+   * @param value The value to spread.
+   * @return The spread value.
+   */
+  static std::size_t spread(uint32_t value) {
+    std::size_t x = value;
+    x = (x | (x << 8)) & 0x00FF00FFu;
+    x = (x | (x << 4)) & 0x0F0F0F0Fu;
+    x = (x | (x << 2)) & 0x33333333u;
+    x = (x | (x << 1)) & 0x55555555u;
+    return x;
+  }
+
+  /**
+   * @brief Allocates the storage for the current dimensions and layout.
+   * @param file_path The file to map, or an empty string for heap storage.
+   * @param open_existing Whether to map the cells already in the file instead of truncating it.
+   */
+  void allocate(const std::string& file_path, bool open_existing = false);
+
+  /**
+   * @brief Releases the storage, unmapping the file if there is one.
+   */
+  void release();
+
+  uint32_t rows_; /**< The number of rows in the grid. */
+  uint32_t cols_; /**< The number of columns in the grid. */
+  GridLayout layout_; /**< The order in which cells are stored. */
+  std::size_t blocks_per_row_; /**< The number of blocks per block row in the tiled layout. */
+  std::size_t size_; /**< The number of cells in the storage, including block padding. */
+  std::vector<Cell*> chunks_; /**< The first cell of every chunk of the storage. */
+  std::vector<Chunk*> owned_; /**< The heap chunks, empty if the grid is memory-mapped. */
+  void* mapping_; /**< The address of the file mapping, or nullptr. */
+  int file_descriptor_; /**< The descriptor of the mapped file, or -1. */
+};
+
+}  // namespace maze
+
+#endif  // MAZE_GRID_HPP_
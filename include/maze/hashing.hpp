@@ -0,0 +1,70 @@
+/**
+ * @file hashing.hpp
+ * @brief Defines the Zobrist keys used to hash maze layouts and game states.
+ */
+
+#ifndef MAZE_HASHING_HPP_
+#define MAZE_HASHING_HPP_
+
+// Standard
+#include <cstdint>
+
+// Private
+#include "coordinates.hpp"
+#include "grid.hpp"
+
+namespace maze {
+
+/**
+ * @brief Returns the Zobrist key of a cell at a position.
+ *
+ * Keys are derived from the position and cell contents on the fly instead of being read from a
+ * table, so they cost no memory for huge mazes. Empty cells have the key 0, so turning a tile into
+ * an empty tile only removes the key of the old tile from a hash.
+ *
+ * @param pos The position of the cell.
+ * @param cell The cell at the position.
+ * @return The key of the cell.
+ */
+uint64_t zobristCellKey(const Coordinates& pos, const Cell& cell);
+
+/**
+ * @brief Returns the Zobrist key of the start being at a position.
+ * @param pos The start position.
+ * @return The key of the start position.
+ */
+uint64_t zobristStartKey(const Coordinates& pos);
+
+/**
+ * @brief Returns the Zobrist key of the end being at a position.
+ * @param pos The end position.
+ * @return The key of the end position.
+ */
+uint64_t zobristEndKey(const Coordinates& pos);
+
+/**
+ * @brief Returns the Zobrist key of the player being at a position.
+ * @param pos The player position.
+ * @return The key of the player position.
+ */
+uint64_t zobristPlayerKey(const Coordinates& pos);
+
+/**
+ * @brief Returns the Zobrist key of the player carrying an amount of food.
+ * @param food The amount of food.
+ * @return The key of the food amount.
+ */
+uint64_t zobristFoodKey(uint32_t food);
+
+/**
+ * @brief Computes the layout hash of a grid with its start and end positions.
+ * @param grid The grid to hash, including its dimensions.
+ * @param start The start position.
+ * @param end The end position.
+ * @return The XOR of the keys of all cells, the dimensions, the start and the end.
+ */
+uint64_t hashLayout(const Grid& grid, const Coordinates& start, const Coordinates& end);
+
+}  // namespace maze
+
+#endif  // MAZE_HASHING_HPP_
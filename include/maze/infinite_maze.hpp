@@ -0,0 +1,169 @@
+/**
+ * @file infinite_maze.hpp
+ * @brief Defines the InfiniteMaze class, an unbounded maze generated chunk by chunk.
+ */
+
+#ifndef MAZE_INFINITE_MAZE_HPP_
+#define MAZE_INFINITE_MAZE_HPP_
+
+// Standard
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Private
+#include "grid.hpp"
+#include "maze.hpp"
+#include "player.hpp"
+
+namespace maze {
+
+/**
+ * @brief Signed coordinates of a cell in an unbounded maze.
+ */
+struct WorldCoordinates {
+  int64_t row;
+  int64_t col;
+
+  bool operator==(const WorldCoordinates& other) const {
+    return other.row == row && other.col == col;
+  }
+
+  bool operator!=(const WorldCoordinates& other) const {
+    return other.row != row || other.col != col;
+  }
+};
+
+/**
+ * @class InfiniteMaze
+ * @brief A maze without bounds that is generated in square chunks when they are first reached.
+ *
+ * Every chunk is derived only from the world seed and its chunk coordinates, so a chunk that was
+ * evicted looks the same when it is generated again. Each chunk is a perfect maze that opens into
+ * the chunk above and the chunk to its left, which keeps the whole world connected before walls,
+ * food and doors are scattered based on the difficulty. Chunks that are further than the keep
+ * radius away from every player are evicted; food eaten in them grows back when they return.
+ */
+class InfiniteMaze {
+ public:
+  /**
+   * @brief Constructs a new unbounded maze.
+   * @param seed The world seed all chunks are derived from.
+   * @param difficulty The difficulty of the maze, represented as a value between 0 and 1.
+   * @param chunk_size The edge length of a chunk in cells, must be even and at least 4.
+   * @param keep_radius The number of chunks around each player that are kept in memory.
+   * @throws std::invalid_argument If the chunk size is odd or smaller than 4.
+   */
+  InfiniteMaze(uint64_t seed, double difficulty, uint32_t chunk_size = 32,
+               uint32_t keep_radius = 1);
+
+  /**
+   * @brief Adds a player at the spawn position of the world.
+   * @return The index of the new player.
+   */
+  std::size_t addPlayer();
+
+  /**
+   * @brief Returns the number of players in the maze.
+   * @return The number of players.
+   */
+  std::size_t getPlayerCount() const;
+
+  /**
+   * @brief Moves a player in the specified direction.
+   * @param player The index of the player to move.
+   * @param move The direction to move the player.
+   * @return True if the move was successful, false otherwise.
+   */
+  bool movePlayer(std::size_t player, Maze::Move move);
+
+  /**
+   * @brief Returns the current position of a player.
+   * @param player The index of the player.
+   * @return The world coordinates of the player.
+   */
+  WorldCoordinates getPlayerPosition(std::size_t player) const;
+
+  /**
+   * @brief Returns the current amount of food in a player's inventory.
+   * @param player The index of the player.
+   * @return The current amount of food of the player.
+   */
+  uint32_t getPlayerCurrentFood(std::size_t player) const;
+
+  /**
+   * @brief Returns the cell at the specified position, generating its chunk if needed.
+   * @param row The row of the cell.
+   * @param col The column of the cell.
+   * @return The cell at the specified position.
+   */
+  Cell getCell(int64_t row, int64_t col);
+
+  /**
+   * @brief Returns the currently perceived tiles around a player.
+   * @param player The index of the player.
+   * @param radius The radius of the player's field of view.
+   * @return A 2D vector of PerceivedTile types representing the tiles within the field of view.
+   */
+  std::vector<std::vector<Maze::PerceivedTile>> perceiveTiles(std::size_t player, uint32_t radius);
+
+  /**
+   * @brief Returns the number of chunks currently held in memory.
+   * @return The number of loaded chunks.
+   */
+  std::size_t getLoadedChunkCount() const;
+
+ private:
+  /**
+   * @brief Hashes chunk coordinates for the chunk map.
+   */
+  struct ChunkHash {
+    std::size_t operator()(const WorldCoordinates& chunk) const;
+  };
+
+  /**
+   * @brief Returns the chunk at the specified chunk coordinates, generating it if needed.
+   * @param chunk The chunk coordinates.
+   * @return A reference to the cells of the chunk.
+   */
+  Grid& getChunk(const WorldCoordinates& chunk);
+
+  /**
+   * @brief Generates the cells of a chunk from the world seed and the chunk coordinates.
+   * @param chunk The chunk coordinates.
+   * @return The generated cells.
+   */
+  Grid generateChunk(const WorldCoordinates& chunk) const;
+
+  /**
+   * @brief Drops all chunks that are further than the keep radius away from every player.
+   */
+  void evictChunks();
+
+  /**
+   * @brief Returns the coordinates of the chunk containing the given cell.
+   * @param position The world coordinates of the cell.
+   * @return The coordinates of the chunk.
+   */
+  WorldCoordinates chunkOf(const WorldCoordinates& position) const;
+
+  /**
+   * @brief Determines if there is a line of sight between two cells.
+   * @param from The starting cell.
+   * @param to The ending cell.
+   * @return True if there is a line of sight between the cells, false otherwise.
+   */
+  bool lineOfSight(const WorldCoordinates& from, const WorldCoordinates& to);
+
+  uint64_t seed_; /**< The world seed all chunks are derived from. */
+  double difficulty_; /**< The difficulty of the maze. */
+  uint32_t chunk_size_; /**< The edge length of a chunk in cells. */
+  uint32_t keep_radius_; /**< The number of chunks around each player kept in memory. */
+  std::unordered_map<WorldCoordinates, Grid, ChunkHash> chunks_; /**< The loaded chunks. */
+  std::vector<Player> players_; /**< The players in the maze. */
+  std::vector<WorldCoordinates> player_positions_; /**< The current positions of the players. */
+};
+
+}  // namespace maze
+
+#endif  // MAZE_INFINITE_MAZE_HPP_
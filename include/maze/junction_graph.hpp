@@ -0,0 +1,140 @@
+/**
+ * @file junction_graph.hpp
+ * @brief Defines the JunctionGraph class, which contracts maze corridors into weighted edges.
+ */
+
+#ifndef MAZE_JUNCTION_GRAPH_HPP_
+#define MAZE_JUNCTION_GRAPH_HPP_
+
+// Standard
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+// Private
+#include "coordinates.hpp"
+#include "grid.hpp"
+#include "maze.hpp"
+
+namespace maze {
+
+/**
+ * @class JunctionGraph
+ * @brief The passable cells of a maze with every corridor collapsed into one weighted edge.
+ *
+ * Nodes are the cells a search has to stop at: junctions, dead ends, food, keys, doors, the start
+ * and the end. Every chain of other passable cells with exactly two passable neighbours becomes a
+ * pair of directed edges between the nodes at its ends, weighted by its length and food cost. The
+ * edges are stored in compressed sparse row form, so a search touches one contiguous range per
+ * node and its cost grows with the number of nodes rather than cells. The moves along an edge are
+ * not stored, they are recovered by walking the corridor again for the final path only.
+ */
+class JunctionGraph {
+ public:
+  /**
+   * @brief Contracts the corridors of a grid.
+   * @param grid The grid to contract.
+   * @param start The start position, which is always a node.
+   * @param end The end position, which is always a node.
+   */
+  JunctionGraph(const Grid& grid, const Coordinates& start, const Coordinates& end);
+
+  /**
+   * @brief Returns the number of nodes, including the ones bypassed since construction.
+   * @return The number of nodes.
+   */
+  std::size_t getNodeCount() const { return nodes_.size(); }
+
+  /**
+   * @brief Returns the number of directed edges.
+   * @return The number of edges.
+   */
+  std::size_t getEdgeCount() const { return edges_.size(); }
+
+  /**
+   * @brief Returns whether or not a cell is a node of the graph.
+   * @param pos The cell.
+   * @return True if the search stops at the cell, false if it lies inside a corridor or a wall.
+   */
+  bool isNode(const Coordinates& pos) const;
+
+  /**
+   * @brief Updates the graph after the food or key on a node was picked up.
+   *
+   * A node left with two neighbours is bypassed by joining its two edges, in constant time.
+   *
+   * @param pos The cell that became empty.
+   */
+  void clearCell(const Coordinates& pos);
+
+  /**
+   * @brief Finds the path with the fewest moves to the end that never runs out of food.
+   *
+   * Like the cell-level search, food is tracked along the search tree and locked doors are only
+   * passed with keys held already.
+   *
+   * @param grid The grid the graph was built for, used to walk the corridors of the final path.
+   * @param from The position to search from, a node or a corridor cell.
+   * @param food The food available at the start.
+   * @param keys The keys held, bit c set for the key of colour c.
+   * @return The moves to the end, or nothing if no path was found.
+   */
+  std::optional<std::vector<Maze::Move>> solve(const Grid& grid, const Coordinates& from,
+                                               uint32_t food, uint16_t keys) const;
+
+ private:
+  static constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max(); /**< Marks a missing node or edge. */
+
+  /**
+   * @brief A cell the search stops at.
+   */
+  struct Node {
+    uint32_t cell; /**< The row-major index of the cell. */
+    Cell tile; /**< The tile on the cell. */
+  };
+
+  /**
+   * @brief A corridor from one node to the next.
+   */
+  struct Edge {
+    uint32_t target; /**< The node at the end of the corridor. */
+    uint32_t length; /**< The number of moves along the corridor. */
+    uint32_t cost; /**< The food the moves cost, the target cell included. */
+    uint32_t reverse; /**< The index of the same corridor walked the other way. */
+    Maze::Move direction; /**< The first move into the corridor. */
+  };
+
+  /**
+   * @brief The outcome of walking a corridor up to the next node.
+   */
+  struct Walk {
+    uint32_t node; /**< The node reached, kNone if the corridor loops without one. */
+    uint32_t length; /**< The number of moves. */
+    uint32_t cost; /**< The food the moves cost. */
+    Maze::Move last_direction; /**< The last move, into the node. */
+  };
+
+  /**
+   * @brief Walks a corridor from a cell until it reaches a node.
+   * @param grid The grid to walk.
+   * @param cell The row-major index of the cell to walk from.
+   * @param direction The first move.
+   * @param moves If not null, receives the moves.
+   * @return The node reached with the length and cost of the walk.
+   */
+  Walk walk(const Grid& grid, uint32_t cell, Maze::Move direction,
+            std::vector<Maze::Move>* moves) const;
+
+  uint32_t rows_; /**< The number of rows of the grid. */
+  uint32_t cols_; /**< The number of columns of the grid. */
+  uint32_t end_node_; /**< The node of the end position. */
+  std::vector<Node> nodes_; /**< The nodes, in row-major order of their cells. */
+  std::vector<uint32_t> node_of_cell_; /**< The node of every cell, kNone for other cells. */
+  std::vector<uint32_t> offsets_; /**< The edges of node n are edges_[offsets_[n], offsets_[n+1]). */
+  std::vector<Edge> edges_; /**< The edges, grouped by source node. */
+};
+
+}  // namespace maze
+
+#endif  // MAZE_JUNCTION_GRAPH_HPP_
@@ -0,0 +1,34 @@
+/**
+ * @file key_solver.hpp
+ * @brief Defines a solver for mazes with keys and locked doors.
+ */
+
+#ifndef MAZE_KEY_SOLVER_HPP_
+#define MAZE_KEY_SOLVER_HPP_
+
+// Standard
+#include <optional>
+#include <vector>
+
+// Private
+#include "maze.hpp"
+
+namespace maze {
+
+/**
+ * @brief Finds the shortest way from the player to the end, picking up keys to open locked doors.
+ *
+ * The search runs over states made of a key tile and the set of held keys. For every state that is
+ * reached, one breadth-first search in the layer of the held keys gives the distances to all key
+ * tiles with new colours and to the end. These key-to-key distances are computed once per state
+ * and reused, so the search only ever touches states whose key sets can actually be collected,
+ * instead of every combination of cell and key set. Food is not taken into account.
+ *
+ * @param maze The maze to solve, from the current player position and keys.
+ * @return The moves to the end, or nothing if the end cannot be reached.
+ */
+std::optional<std::vector<Maze::Move>> solveWithKeys(const Maze& maze);
+
+}  // namespace maze
+
+#endif  // MAZE_KEY_SOLVER_HPP_
@@ -0,0 +1,105 @@
+/**
+ * @file landmarks.hpp
+ * @brief Defines the LandmarkTable class, which bounds maze distances with landmarks (ALT).
+ */
+
+#ifndef MAZE_LANDMARKS_HPP_
+#define MAZE_LANDMARKS_HPP_
+
+// Standard
+#include <cstdint>
+#include <vector>
+
+// Private
+#include "coordinates.hpp"
+
+namespace maze {
+
+class Maze;
+
+/**
+ * @class LandmarkTable
+ * @brief Distances from a few landmark cells to every cell, for tight A* lower bounds.
+ *
+ * For any landmark L, the triangle inequality gives |d(L, to) - d(L, from)| <= d(from, to). In a
+ * maze with long detours that bound is often close to the true distance, where the Manhattan
+ * distance is not. Landmarks are picked by farthest-point selection, each one as far as possible
+ * from the start and the landmarks before it, so that they sit at the ends of the maze.
+ *
+ * Distances are counted with every door open, so they stay lower bounds whatever keys the player
+ * holds and whatever food has been eaten. The table is immutable and can be shared between all
+ * mazes with the same walls.
+ */
+class LandmarkTable {
+ public:
+  /**
+   * @brief Picks landmarks on a maze and computes their distance tables.
+   * @param maze The maze to pick landmarks on.
+   * @param count The number of landmarks, fewer if the start's component has fewer cells.
+   * @param threads The number of threads for each breadth-first search, 0 for one per hardware
+   * thread.
+   */
+  LandmarkTable(const Maze& maze, uint32_t count, uint32_t threads = 0);
+
+  /**
+   * @brief Returns the number of rows of the maze the table was built for.
+   * @return The number of rows.
+   */
+  uint32_t getRows() const { return rows_; }
+
+  /**
+   * @brief Returns the number of columns of the maze the table was built for.
+   * @return The number of columns.
+   */
+  uint32_t getCols() const { return cols_; }
+
+  /**
+   * @brief Returns the picked landmarks.
+   * @return The landmark cells, in the order they were picked.
+   */
+  const std::vector<Coordinates>& getLandmarks() const { return landmarks_; }
+
+  /**
+   * @brief Returns the distance between a landmark and a cell.
+   * @param landmark The index of the landmark.
+   * @param pos The cell.
+   * @return The number of moves, kUnreachable if the cell cannot be reached.
+   */
+  uint32_t getDistance(uint32_t landmark, const Coordinates& pos) const {
+    return distances_[getCell(pos) * landmarks_.size() + landmark];
+  }
+
+  /**
+   * @brief Returns the largest lower bound on the distance between two cells over all landmarks.
+   * @param from The first cell.
+   * @param to The second cell.
+   * @return A lower bound on the number of moves between the cells, 0 if none is known.
+   */
+  uint32_t getLowerBound(const Coordinates& from, const Coordinates& to) const;
+
+ private:
+  /**
+   * @brief Returns the row-major index of a cell.
+   * @param pos The cell.
+   * @return The index of the cell.
+   */
+  std::size_t getCell(const Coordinates& pos) const {
+    return static_cast<std::size_t>(pos.row) * cols_ + pos.col;
+  }
+
+  uint32_t rows_; /**< The number of rows of the maze. */
+  uint32_t cols_; /**< The number of columns of the maze. */
+  std::vector<Coordinates> landmarks_; /**< The landmark cells. */
+
+  /**
+   * @brief The distances, the ones of all landmarks to a cell next to each other.
+   *
+   * Every heuristic evaluation reads the distances of two cells to all landmarks, so keeping them
+   * together costs two cache lines instead of one per landmark.
+   */
+  std::vector<uint32_t> distances_;
+};
+
+}  // namespace maze
+
+#endif  // MAZE_LANDMARKS_HPP_
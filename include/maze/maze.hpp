@@ -8,18 +8,29 @@
 
 // Standard
 #include <cstdint>
+#include <memory>
+#include <optional>
 #include <queue>
-#include <random>
 #include <unordered_set>
 #include <vector>
 
 // Private
+#include "analytics.hpp"
 #include "coordinates.hpp"
+#include "generation.hpp"
+#include "grid.hpp"
 #include "player.hpp"
+#include "random.hpp"
 #include "tiles.hpp"
+#include "visibility.hpp"
 
 namespace maze {
 
+class DynamicConnectivity;
+class JunctionGraph;
+class LandmarkTable;
+class SolveCache;
+
 /**
  * @class Maze
  * @brief The Maze class represents the maze in the maze game.
@@ -36,21 +47,70 @@ class Maze {
    * @enum PerceivedTile
    * @brief Represents the types of perceived tiles.
    */
-  enum class PerceivedTile { UNKNOWN, EMPTY, WALL, FOOD, DOOR, START, END };
+  enum class PerceivedTile : uint8_t {
+    UNKNOWN, EMPTY, WALL, FOOD, DOOR, START, END,
+    KEY, /**< The key of colour 0, the key of colour c is KEY + c. */
+    LOCKED_DOOR = KEY + kKeyColours, /**< A door locked with colour 0, colour c is LOCKED_DOOR + c. */
+    MUD = LOCKED_DOOR + kKeyColours, /**< Mud, loaded with the default mud cost. */
+    WATER /**< Water, loaded with the default water cost. */
+  };
+
+  /**
+   * @brief Returns the perceived tile of a key.
+   * @param colour The colour of the key.
+   * @return The tile KEY + colour.
+   * @throws std::invalid_argument If the colour is not below kKeyColours.
+   */
+  static PerceivedTile perceivedKey(uint32_t colour);
+
+  /**
+   * @brief Returns the perceived tile of a locked door.
+   * @param colour The colour of the key opening the door.
+   * @return The tile LOCKED_DOOR + colour.
+   * @throws std::invalid_argument If the colour is not below kKeyColours.
+   */
+  static PerceivedTile perceivedLockedDoor(uint32_t colour);
+
+  /**
+   * @brief Returns how a cell is perceived, regardless of start and end.
+   * @param cell The cell.
+   * @return The perceived tile of the cell.
+   */
+  static PerceivedTile perceivedCell(const Cell& cell);
+
+  static constexpr uint32_t kMaxFood = 100; /**< The food a player carries at most and starts with. */
 
   /**
    * @brief Constructs a new Maze with the given number of rows, columns, and difficulty.
    * @param rows The number of rows in the maze.
    * @param cols The number of columns in the maze.
    * @param difficulty The difficulty of the maze, represented as a value between 0 and 1.
+   * @param storage The layout and backing of the tile storage. A file is always created anew.
+   * @throws std::invalid_argument If the storage asks to open an existing file.
+   */
+  Maze(uint32_t rows, uint32_t cols, double difficulty,
+       const GridStorage& storage = GridStorage());
+
+  /**
+   * @brief Constructs a new Maze with the given size and difficulty, generated with the given options.
+   * @param rows The number of rows in the maze.
+   * @param cols The number of columns in the maze.
+   * @param difficulty The difficulty of the maze, represented as a value between 0 and 1.
+   * @param generation The options controlling seed, algorithm, regions and threads of the generation.
+   * @param storage The layout and backing of the tile storage. A file is always created anew.
+   * @throws std::invalid_argument If the storage asks to open an existing file.
    */
-  Maze(uint32_t rows, uint32_t cols, double difficulty);
+  Maze(uint32_t rows, uint32_t cols, double difficulty, const GenerationOptions& generation,
+       const GridStorage& storage = GridStorage());
 
   /**
    * @brief Constructs a Maze based on the layout specified.
    * @param maze_layout The layout used to instantiate the Maze.
+   * @param storage The layout and backing of the tile storage. A file is always created anew.
+   * @throws std::invalid_argument If the storage asks to open an existing file.
    */
-  Maze(const std::vector<std::vector<PerceivedTile>>& maze_layout);
+  Maze(const std::vector<std::vector<PerceivedTile>>& maze_layout,
+       const GridStorage& storage = GridStorage());
 
   /**
    * @brief Moves the player in the specified direction.
@@ -73,6 +133,20 @@ class Maze {
    */
   std::shared_ptr<Tile> getTile(uint32_t row, uint32_t col) const;
 
+  /**
+   * @brief Returns the cell at the specified position in the maze.
+   * @param row The row of the cell to retrieve.
+   * @param col The column of the cell to retrieve.
+   * @return The cell at the specified position.
+   */
+  Cell getCell(uint32_t row, uint32_t col) const;
+
+  /**
+   * @brief Returns the grid holding the cells of the maze.
+   * @return A reference to the grid of the maze.
+   */
+  const Grid& getGrid() const;
+
   /**
    * @brief Returns whether or not the player is at the specified position in the maze.
    * @param row The row to check.
@@ -123,18 +197,85 @@ class Maze {
    */
   uint32_t getPlayerCurrentFood() const;
 
+  /**
+   * @brief Returns the keys in the player's inventory.
+   * @return The keys, bit c set for the key of colour c.
+   */
+  uint16_t getPlayerKeys() const;
+
+  /**
+   * @brief Replaces the tile of a cell, e.g. to move an obstacle or toggle a door.
+   *
+   * The hashes are updated in constant time and so is connectivity tracking, in logarithmic time
+   * unless a wall cuts the maze apart. Everything derived from the walls is dropped: analytics, the
+   * visibility index and landmarks. The junction graph is dropped and rebuilt once, on the next
+   * search, so any number of changes between two searches cost one rebuild.
+   *
+   * @param row The row of the cell.
+   * @param col The column of the cell.
+   * @param type The new tile type.
+   * @param value The new tile value: the food amount, key colour + 1 (1 to kKeyColours), 0 for an
+   * unlocked door or its colour + 1 (1 to kKeyColours) for a locked one, or the move cost.
+   * @throws std::invalid_argument If the cell lies outside the maze, a wall would cover the player,
+   * or the value of a key or door is out of range.
+   */
+  void setTileType(uint32_t row, uint32_t col, TileType type, uint8_t value = 0);
+
+  /**
+   * @brief Keeps track of which cells are connected, for fast reachability queries after changes.
+   *
+   * Copies of the maze share the tracking structure until one of them changes its walls.
+   *
+   * @param enabled Whether or not to track connectivity.
+   */
+  void setConnectivityTracking(bool enabled);
+
+  /**
+   * @brief Determines whether or not a cell can be reached from the player position.
+   *
+   * Only walls block, food and keys are ignored. With connectivity tracking this takes
+   * logarithmic time, otherwise it searches the maze.
+   *
+   * @param pos The cell.
+   * @return True if the cell can be reached, false otherwise.
+   */
+  bool isReachable(const Coordinates& pos) const;
+
   /**
    * @brief Determines whether or not the maze is solvable.
+   *
+   * A breadth-first search that ignores food and opens every door, or connectivity tracking if
+   * enabled, rules out unreachable ends before solving.
+   *
    * @return True if the maze is solvable, false otherwise.
    */
   bool isSolvable();
 
   /**
    * @brief Solves the maze and returns a vector of moves to get from start to end.
+   *
+   * Keys on the way are picked up to pass locked doors, solveWithKeys() finds the shortest such
+   * way when food does not matter. If a solve cache is set, the result for the current state is
+   * looked up there first and stored there after a search, including the fact that the state is
+   * unsolvable.
+   *
    * @return A vector of moves to get from start to end.
+   * @throws std::runtime_error If the maze is not solvable from the current state.
    */
   std::vector<Move> solve();
 
+  /**
+   * @brief Sets the cache solve() and isSolvable() use. The cache can be shared between mazes.
+   * @param cache The cache to use, or a null pointer to always search.
+   */
+  void setSolveCache(std::shared_ptr<SolveCache> cache);
+
+  /**
+   * @brief Returns the cache solve() and isSolvable() use.
+   * @return The cache, or a null pointer if none is set.
+   */
+  const std::shared_ptr<SolveCache>& getSolveCache() const;
+
   /**
    * @brief Returns the player's start position in the maze.
    * @return A coordinates object representing the player's start position.
@@ -160,13 +301,116 @@ class Maze {
    */
   std::vector<std::vector<PerceivedTile>> perceiveTiles(uint32_t radius);
 
+  /**
+   * @brief Returns the visibility index for a sight radius, building it on first use.
+   *
+   * Once built, perceiveTiles() with the same radius looks the visible cells up instead of
+   * tracing lines of sight. The index is replaced when it is requested for another radius.
+   *
+   * @param radius The sight radius to index.
+   * @param threads The number of threads to build with, 0 for one per hardware thread.
+   * @return The shared index, which can be passed to mazes with the same walls.
+   */
+  std::shared_ptr<const VisibilityIndex> getVisibilityIndex(uint32_t radius,
+                                                            uint32_t threads = 0);
+
+  /**
+   * @brief Sets a visibility index built for a maze with the same walls, or removes it.
+   * @param index The index to use, or a null pointer to trace lines of sight again.
+   * @throws std::invalid_argument If the index was built for a maze of another size.
+   */
+  void setVisibilityIndex(std::shared_ptr<const VisibilityIndex> index);
+
+  /**
+   * @brief Sets landmark distances built for a maze with the same walls, or removes them.
+   *
+   * With landmarks, solve() estimates remaining distances with the larger of the Manhattan and the
+   * landmark lower bound, which expands far fewer cells in mazes with long detours. Copies of the
+   * maze share the table.
+   *
+   * @param landmarks The landmark table to use, or a null pointer to use the Manhattan distance.
+   * @throws std::invalid_argument If the table was built for a maze of another size.
+   */
+  void setLandmarkTable(std::shared_ptr<const LandmarkTable> landmarks);
+
+  /**
+   * @brief Returns the landmark table solve() uses.
+   * @return The landmark table, or a null pointer if none is set.
+   */
+  const std::shared_ptr<const LandmarkTable>& getLandmarkTable() const;
+
+  /**
+   * @brief Makes solve() search on the junction graph of the maze instead of cell by cell.
+   *
+   * The graph is built when enabled and then kept up to date as food and keys are picked up.
+   * Copies of the maze share it until one of them changes it. While the maze has locked doors,
+   * solve() searches cell by cell, since the graph does not plan picking up keys.
+   *
+   * @param enabled Whether or not to search on the junction graph.
+   */
+  void setJunctionSearch(bool enabled);
+
+  /**
+   * @brief Returns the junction graph solve() searches on, rebuilding it if tiles were changed.
+   * @return The junction graph, or a null pointer if junction search is disabled.
+   */
+  std::shared_ptr<const JunctionGraph> getJunctionGraph() const;
+
+  /**
+   * @brief Writes the currently perceived tiles around the player into a caller-owned buffer.
+   * @param radius The radius of the player's field of view.
+   * @param out The buffer to fill, (2 * radius + 1)^2 tiles in row-major order.
+   */
+  void perceiveTiles(uint32_t radius, PerceivedTile* out) const;
+
+  /**
+   * @brief Determines if walls leave a line of sight between two positions in the maze.
+   * @param from The position to look from.
+   * @param to The position to look at.
+   * @return True if there is a line of sight between the positions, false otherwise.
+   */
+  bool hasLineOfSight(const Coordinates& from, const Coordinates& to) const;
+
+  /**
+   * @brief Returns the structural metrics of the maze, computing them on first use.
+   *
+   * The result is cached until the layout changes, i.e. until the player eats food.
+   *
+   * @param sight_radius The sight radius to count the cells visible from the start with.
+   * @return A reference to the metrics of the maze.
+   */
+  const MazeAnalytics& getAnalytics(uint32_t sight_radius) const;
+
+  /**
+   * @brief Returns the Zobrist hash of the layout: tiles, food, start and end.
+   *
+   * The hash is computed on construction and kept up to date when the player eats food.
+   *
+   * @return The 64 bit layout hash.
+   */
+  uint64_t getLayoutHash() const;
+
+  /**
+   * @brief Returns the Zobrist hash of the full state: the layout, the player position and food.
+   * @return The 64 bit state hash.
+   */
+  uint64_t getStateHash() const;
+
  private:
   /**
-   * @brief Checks if a line of sight is blocked by the given tile.
-   * @param tile The tile to check.
+   * @brief Checks if a line of sight is blocked by the given cell.
+   * @param cell The cell to check.
    * @return True if the line of sight is blocked, false otherwise.
    */
-  bool blocksLineOfSight(const std::shared_ptr<Tile>& tile) const;
+  bool blocksLineOfSight(const Cell& cell) const;
+
+  /**
+   * @brief Returns how the tile at a visible position is perceived.
+   * @param row The row of the tile.
+   * @param col The column of the tile.
+   * @return The perceived tile, including the start and end markers.
+   */
+  PerceivedTile perceiveCell(uint32_t row, uint32_t col) const;
 
   /**
    * @brief Determines if there is a line of sight between two points in the maze.
@@ -189,15 +433,49 @@ class Maze {
   /**
    * @brief Generates the maze with the specified difficulty.
    * @param difficulty The difficulty of the maze, represented as a value between 0 and 1.
+   * @param generation The options controlling seed, algorithm, regions and threads of the generation.
+   * @throws std::invalid_argument If the maze has fewer than three rows or columns.
+   */
+  void generateMaze(double difficulty, const GenerationOptions& generation);
+
+  /**
+   * @brief Searches for the moves from the player to the end with A*, taking food into account.
+   *
+   * Search states are a cell and the keys held, so keys are picked up for the locked doors.
+   *
+   * @return A vector of moves to get from the player to the end.
+   * @throws std::runtime_error If the maze is not solvable from the current state.
    */
-  void generateMaze(double difficulty);
+  std::vector<Move> search();
+
+  /**
+   * @brief Locks doors of different colours along a shortest path and places their keys.
+   *
+   * The key of each colour is placed where it can be reached with the keys of lower colours, so
+   * the maze stays solvable when it was solvable before.
+   *
+   * @param colours The number of colours to place, fewer if the path is too short.
+   * @param rng The random number generator to place keys with.
+   */
+  void placeKeysAndDoors(uint32_t colours, RandomGenerator& rng);
+
+  /**
+   * @brief Computes the layout and state hashes from scratch.
+   */
+  void initializeHashes();
+
+  /**
+   * @brief Counts the doors that need a key from scratch.
+   */
+  void countLockedDoors();
 
   /**
    * @brief Returns a vector of the neighboring positions of the specified position.
    * @param pos The position to find neighbors for.
+   * @param keys The keys held, which decide which locked doors can be passed.
    * @return A vector of the neighboring positions of the specified position.
    */
-  std::vector<Coordinates> getNeighbors(const Coordinates& pos);
+  std::vector<Coordinates> getNeighbors(const Coordinates& pos, uint16_t keys);
 
   /**
    * @brief Returns the Manhattan distance between two positions.
@@ -207,13 +485,30 @@ class Maze {
    */
   uint32_t manhattanDistance(const Coordinates& a, const Coordinates& b);
 
+  /**
+   * @brief Returns a lower bound on the moves from a position to the end.
+   * @param pos The position.
+   * @return The larger of the Manhattan distance and the landmark bound, if landmarks are set.
+   */
+  uint32_t estimateDistanceToEnd(const Coordinates& pos);
+
   uint32_t rows_; /**< The number of rows in the maze. */
   uint32_t cols_; /**< The number of columns in the maze. */
-  std::vector<std::shared_ptr<Tile>> grid_; /**< The grid of tiles that make up the maze. */
+  Grid grid_; /**< The grid of cells that make up the maze. */
   Player player_; /**< The player object. */
   Coordinates start_pos_; /**< The starting position of the maze. */
   Coordinates end_pos_; /**< The ending position of the maze. */
   Coordinates player_pos_; /**< The current position of the player in the maze. */
+  mutable std::optional<MazeAnalytics> analytics_; /**< The cached metrics of the maze. */
+  uint64_t layout_hash_; /**< The Zobrist hash of the layout. */
+  uint64_t state_hash_; /**< The Zobrist hash of the layout, player position and food. */
+  std::shared_ptr<SolveCache> solve_cache_; /**< The cache of solve results, if any. */
+  std::shared_ptr<const VisibilityIndex> visibility_; /**< The visibility index, if any. */
+  std::shared_ptr<const LandmarkTable> landmarks_; /**< The landmark distances, if any. */
+  bool junction_search_; /**< Whether solve() searches on the junction graph. */
+  mutable std::shared_ptr<JunctionGraph> junctions_; /**< The junction graph, null while stale. */
+  std::shared_ptr<DynamicConnectivity> connectivity_; /**< The connectivity tracking, if any. */
+  uint32_t locked_doors_; /**< The number of doors that need a key. */
 };
 
 }  // namespace maze
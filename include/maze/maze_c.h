@@ -0,0 +1,115 @@
+/**
+ * @file maze_c.h
+ * @brief Defines a stable C interface for creating and stepping batches of mazes.
+ *
+ * All buffers are owned by the caller and filled in place. Functions that can fail return a
+ * negative status or a null pointer, and maze_last_error() describes the failure.
+ */
+
+#ifndef MAZE_MAZE_C_H_
+#define MAZE_MAZE_C_H_
+
+/* Standard */
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief An opaque maze environment. */
+typedef struct maze_env maze_env;
+
+/** @brief The moves accepted by maze_env_step_batch(), matching maze::Maze::Move. */
+enum maze_move { MAZE_MOVE_LEFT = 0, MAZE_MOVE_RIGHT = 1, MAZE_MOVE_UP = 2, MAZE_MOVE_DOWN = 3 };
+
+/**
+ * @brief The observation values, matching maze::Maze::PerceivedTile.
+ */
+enum maze_tile {
+  MAZE_TILE_UNKNOWN = 0,
+  MAZE_TILE_EMPTY = 1,
+  MAZE_TILE_WALL = 2,
+  MAZE_TILE_FOOD = 3,
+  MAZE_TILE_DOOR = 4,
+  MAZE_TILE_START = 5,
+  MAZE_TILE_END = 6,
+  MAZE_TILE_KEY = 7, /**< The key of colour 0, colour c is MAZE_TILE_KEY + c. */
+  MAZE_TILE_LOCKED_DOOR = 23, /**< A door locked with colour 0, colour c is MAZE_TILE_LOCKED_DOOR + c. */
+  MAZE_TILE_MUD = 39,
+  MAZE_TILE_WATER = 40
+};
+
+/**
+ * @brief Creates a generated maze environment.
+ * @param rows The number of rows, at least 3.
+ * @param cols The number of columns, at least 3.
+ * @param difficulty The difficulty between 0 and 1.
+ * @param seed The seed the maze is generated from.
+ * @return The environment, or NULL on failure.
+ */
+maze_env* maze_env_create(uint32_t rows, uint32_t cols, double difficulty, uint64_t seed);
+
+/**
+ * @brief Destroys an environment. Passing NULL does nothing.
+ * @param env The environment to destroy.
+ */
+void maze_env_destroy(maze_env* env);
+
+/**
+ * @brief Regenerates the maze of an environment from its seed and puts the player at the start.
+ * @param env The environment to reset.
+ * @return 0 on success, a negative value on failure.
+ */
+int maze_env_reset(maze_env* env);
+
+/**
+ * @brief Returns the number of observation bytes per environment for a sight radius.
+ * @param radius The sight radius.
+ * @return (2 * radius + 1)^2.
+ */
+size_t maze_observation_size(uint32_t radius);
+
+/**
+ * @brief Writes the current observation of one environment.
+ * @param env The environment to observe.
+ * @param radius The sight radius.
+ * @param observation The buffer of maze_observation_size(radius) bytes to fill with maze_tile values.
+ * @return 0 on success, a negative value on failure.
+ */
+int maze_env_observe(const maze_env* env, uint32_t radius, uint8_t* observation);
+
+/**
+ * @brief Applies one move to each of a batch of environments.
+ *
+ * The reward is 1 when the end is reached, -1 when the food runs out and 0 otherwise. Finished
+ * environments are left unchanged, with a reward of 0 and done set, until they are reset.
+ *
+ * @param envs The environments to step, each at most once. Batches listing an environment twice
+ *        are rejected.
+ * @param count The number of environments.
+ * @param moves One maze_move per environment.
+ * @param radius The sight radius of the observations.
+ * @param observations count * maze_observation_size(radius) bytes, filled after the moves. May be
+ *        NULL if no observations are needed.
+ * @param rewards count rewards to fill. May be NULL.
+ * @param dones count flags to fill, 1 for finished environments. May be NULL.
+ * @param threads The number of threads to step with, 0 for one per hardware thread.
+ * @return 0 on success, a negative value on failure. Invalid arguments are detected before any
+ *         environment is stepped.
+ */
+int maze_env_step_batch(maze_env* const* envs, size_t count, const uint8_t* moves,
+                        uint32_t radius, uint8_t* observations, float* rewards, uint8_t* dones,
+                        uint32_t threads);
+
+/**
+ * @brief Returns a description of the last failure on the calling thread.
+ * @return The description, or an empty string. Valid until the next call on the thread.
+ */
+const char* maze_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MAZE_MAZE_C_H_ */
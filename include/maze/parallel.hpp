@@ -0,0 +1,94 @@
+/**
+ * @file parallel.hpp
+ * @brief Defines small helpers for running loops on several threads.
+ */
+
+#ifndef MAZE_PARALLEL_HPP_
+#define MAZE_PARALLEL_HPP_
+
+// Standard
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace maze {
+
+/**
+ * @brief Returns the number of threads to use for a requested thread count.
+ * @param threads The requested number of threads, 0 for one per hardware thread.
+ * @return The number of threads to use, at least 1.
+ */
+inline uint32_t resolveThreadCount(uint32_t threads) {
+  if (threads == 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+  return std::max<uint32_t>(threads, 1);
+}
+
+/**
+ * @brief Calls a function for every index in [0, count), distributing the indices over threads.
+ *
+ * Indices are handed out one at a time, so uneven work per index is balanced between threads. If
+ * threads cannot be created, the indices are distributed over the threads that could. If the
+ * function throws, no further indices are handed out and the first exception is rethrown once every
+ * thread has finished.
+ *
+ * @param count The number of indices.
+ * @param threads The requested number of threads, 0 for one per hardware thread.
+ * @param function The function to call with each index.
+ */
+template <typename Function>
+void parallelFor(std::size_t count, uint32_t threads, const Function& function) {
+  const std::size_t thread_count = std::min<std::size_t>(resolveThreadCount(threads), count);
+  if (thread_count <= 1) {
+    for (std::size_t index = 0; index < count; ++index) {
+      function(index);
+    }
+    return;
+  }
+
+  std::atomic<std::size_t> next_index{0};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  const auto worker = [&]() {
+    try {
+      for (std::size_t index = next_index.fetch_add(1); index < count;
+           index = next_index.fetch_add(1)) {
+        function(index);
+      }
+    } catch (...) {
+      next_index.store(count);
+      const std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(thread_count - 1);
+  for (std::size_t thread = 1; thread < thread_count; ++thread) {
+    try {
+      pool.emplace_back(worker);
+    } catch (const std::system_error&) {
+      break;
+    }
+  }
+  worker();
+  for (std::thread& thread : pool) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace maze
+
+#endif  // MAZE_PARALLEL_HPP_
@@ -0,0 +1,48 @@
+/**
+ * @file parallel_bfs.hpp
+ * @brief Defines a multithreaded breadth-first search over a grid.
+ */
+
+#ifndef MAZE_PARALLEL_BFS_HPP_
+#define MAZE_PARALLEL_BFS_HPP_
+
+// Standard
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Private
+#include "coordinates.hpp"
+#include "grid.hpp"
+
+namespace maze {
+
+/**
+ * @brief The distance of cells that cannot be reached.
+ */
+constexpr uint32_t kUnreachable = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief Computes the number of moves from a source to every cell of a grid.
+ *
+ * The search is level-synchronous and direction-optimizing. While the frontier is small, its cells
+ * are expanded top-down, spread over the threads that each collect their part of the next
+ * frontier and claim cells with an atomic bit per cell. Once the frontier covers a large part of
+ * the unvisited cells, every thread instead scans its own range of unvisited cells bottom-up for
+ * a neighbour in the frontier, which needs no atomics at all. Levels with few cells run on the
+ * calling thread only, so narrow corridors don't pay for synchronization. Food and terrain costs
+ * are ignored.
+ *
+ * @param grid The grid to search, in any layout.
+ * @param source The cell to measure distances from.
+ * @param keys The keys the locked doors are passed with, bit c set for the key of colour c.
+ * @param threads The number of threads to search with, 0 for one per hardware thread.
+ * @return The distances, row by row, with kUnreachable for cells that cannot be reached.
+ * @throws std::invalid_argument If the source lies outside the grid.
+ */
+std::vector<uint32_t> breadthFirstDistances(const Grid& grid, const Coordinates& source,
+                                            uint16_t keys = 0, uint32_t threads = 0);
+
+}  // namespace maze
+
+#endif  // MAZE_PARALLEL_BFS_HPP_
@@ -0,0 +1,108 @@
+/**
+ * @file placement.hpp
+ * @brief Defines the PlacementEngine class, which picks cells for walls, food and doors.
+ */
+
+#ifndef MAZE_PLACEMENT_HPP_
+#define MAZE_PLACEMENT_HPP_
+
+// Standard
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Private
+#include "coordinates.hpp"
+#include "grid.hpp"
+#include "random.hpp"
+
+namespace maze {
+
+/**
+ * @enum PlacementDistribution
+ * @brief The spatial distributions items can be placed with.
+ */
+enum class PlacementDistribution {
+  UNIFORM, /**< Every eligible cell is equally likely. */
+  CLUSTERED, /**< Cells close to a few random cluster centres are more likely. */
+  DISTANCE_FROM_START /**< Cells further away from the start, along the maze, are more likely. */
+};
+
+/**
+ * @brief Options that control how walls, food and doors are placed in a generated maze.
+ */
+struct PlacementOptions {
+  /**
+   * @brief The distribution food and doors are placed with. Extra walls are always uniform.
+   */
+  PlacementDistribution distribution = PlacementDistribution::UNIFORM;
+
+  std::optional<double> wall_density; /**< Extra walls per interior cell, or by difficulty. */
+  std::optional<double> food_density; /**< Food items per interior cell, or by difficulty. */
+  std::optional<double> door_density; /**< Doors per interior cell, or by difficulty. */
+  uint32_t cluster_count = 4; /**< The number of cluster centres for clustered placement. */
+  double cluster_radius = 0.0; /**< The cluster spread in cells, 0 for a tenth of the maze size. */
+  uint32_t key_colours = 0; /**< Locked doors on the way to the end, each with its own key. */
+  double mud_density = 0.0; /**< Mud tiles per interior cell. */
+  double water_density = 0.0; /**< Water tiles per interior cell. */
+  uint8_t mud_cost = kDefaultMudCost; /**< The food it costs to enter mud. */
+  uint8_t water_cost = kDefaultWaterCost; /**< The food it costs to enter water. */
+};
+
+/**
+ * @class PlacementEngine
+ * @brief Picks distinct empty interior cells of a grid, without rejection sampling.
+ *
+ * The eligible cells are indexed once on construction. Every call to take() removes the chosen
+ * cells from the index, so successive calls never pick the same cell twice and never ask for more
+ * cells than there are. Uniform picks are a partial Fisher-Yates shuffle, weighted picks use one
+ * random key per cell and a linear-time selection, so every call is O(cells) at worst.
+ */
+class PlacementEngine {
+ public:
+  /**
+   * @brief Indexes the empty interior cells of a grid.
+   * @param grid The grid to place items in.
+   * @param rng The random number generator to pick cells with.
+   */
+  PlacementEngine(const Grid& grid, RandomGenerator& rng);
+
+  /**
+   * @brief Returns the number of cells that can still be taken.
+   * @return The number of remaining eligible cells.
+   */
+  std::size_t getAvailableCount() const;
+
+  /**
+   * @brief Picks and removes up to count cells from the index.
+   *
+   * Weights for non-uniform distributions are derived from the grid as it is at the time of the
+   * first weighted call, so walls and the start should be in place by then.
+   *
+   * @param count The number of cells to pick.
+   * @param options The options selecting the distribution.
+   * @param start The start position, used by the distance based distribution.
+   * @return The picked cells, at most as many as there are remaining eligible cells.
+   */
+  std::vector<Coordinates> take(std::size_t count, const PlacementOptions& options,
+                                const Coordinates& start);
+
+ private:
+  /**
+   * @brief Computes the weights of the remaining cells for a distribution.
+   * @param options The options selecting the distribution.
+   * @param start The start position, used by the distance based distribution.
+   */
+  void computeWeights(const PlacementOptions& options, const Coordinates& start);
+
+  const Grid& grid_; /**< The grid items are placed in. */
+  RandomGenerator& rng_; /**< The random number generator to pick cells with. */
+  std::vector<Coordinates> cells_; /**< The eligible cells, the taken ones at the front. */
+  std::vector<double> weights_; /**< The weights of the cells, empty until needed. */
+  std::optional<PlacementDistribution> weighted_for_; /**< The distribution of the weights. */
+  std::size_t taken_; /**< The number of cells taken so far. */
+};
+
+}  // namespace maze
+
+#endif  // MAZE_PLACEMENT_HPP_
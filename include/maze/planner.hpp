@@ -0,0 +1,167 @@
+/**
+ * @file planner.hpp
+ * @brief Defines the IncrementalPlanner class, which replans paths on a partially known maze.
+ */
+
+#ifndef MAZE_PLANNER_HPP_
+#define MAZE_PLANNER_HPP_
+
+// Standard
+#include <cstdint>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Private
+#include "coordinates.hpp"
+#include "maze.hpp"
+
+namespace maze {
+
+/**
+ * @class IncrementalPlanner
+ * @brief Plans shortest paths to the end of a maze from what an agent has perceived, with D* Lite.
+ *
+ * Cells the agent has not seen yet are assumed to be passable. Perceived walls and agent moves
+ * only repair the parts of the search that they affect, so the cost of a replan scales with the
+ * amount of changed map instead of the size of the maze. Food is recorded in the known map but
+ * does not change path costs, every move costs one step. Perceived locked doors are blocked
+ * unless the agent holds their key, see setKeys().
+ */
+class IncrementalPlanner {
+ public:
+  /**
+   * @brief The knowledge the planner has about a cell.
+   */
+  enum class Knowledge : uint8_t {
+    UNKNOWN, /**< Not perceived yet, assumed to be passable. */
+    PASSABLE, /**< Perceived as a tile that can be walked on. */
+    FOOD, /**< Perceived as a food tile. */
+    BLOCKED /**< Perceived as a wall, or a locked door without its key. */
+  };
+
+  /**
+   * @brief Constructs a planner for a maze of known size and end, with nothing else perceived.
+   * @param rows The number of rows of the maze.
+   * @param cols The number of columns of the maze.
+   * @param start The position of the agent.
+   * @param goal The position of the end of the maze.
+   * @throws std::invalid_argument If a position is outside of the maze.
+   */
+  IncrementalPlanner(uint32_t rows, uint32_t cols, const Coordinates& start,
+                     const Coordinates& goal);
+
+  /**
+   * @brief Moves the agent. Its old search tree stays valid and is reused.
+   * @param start The new position of the agent.
+   */
+  void setStart(const Coordinates& start);
+
+  /**
+   * @brief Records what is known about a single cell.
+   * @param pos The position of the cell.
+   * @param knowledge The knowledge about the cell.
+   * @return True if the knowledge changed, false otherwise.
+   */
+  bool setKnowledge(const Coordinates& pos, Knowledge knowledge);
+
+  /**
+   * @brief Sets the keys the agent holds, unblocking the perceived locked doors they open.
+   * @param keys The held keys, bit c set for the key of colour c.
+   * @return The number of cells whose knowledge changed.
+   */
+  uint32_t setKeys(uint16_t keys);
+
+  /**
+   * @brief Records a perception window as returned by Maze::perceiveTiles().
+   * @param center The position the window was perceived from.
+   * @param window The perceived tiles, with the center in the middle.
+   * @return The number of cells whose knowledge changed.
+   */
+  uint32_t observe(const Coordinates& center,
+                   const std::vector<std::vector<Maze::PerceivedTile>>& window);
+
+  /**
+   * @brief Repairs the search and returns the moves from the agent to the goal.
+   * @return The planned moves, or nothing if the goal cannot be reached on the known map.
+   */
+  std::optional<std::vector<Maze::Move>> plan();
+
+  /**
+   * @brief Returns the knowledge the planner has about a cell.
+   * @param pos The position of the cell.
+   * @return The knowledge about the cell.
+   */
+  Knowledge getKnowledge(const Coordinates& pos) const;
+
+  /**
+   * @brief Returns the number of cells expanded by all searches so far.
+   * @return The total number of expanded cells.
+   */
+  uint64_t getExpandedCount() const;
+
+ private:
+  using Key = std::pair<uint32_t, uint32_t>;
+  using QueueEntry = std::pair<Key, uint32_t>;
+
+  /**
+   * @brief Computes the priority of a cell.
+   * @param cell The index of the cell.
+   * @return The key the cell is ordered by.
+   */
+  Key calculateKey(uint32_t cell) const;
+
+  /**
+   * @brief Recomputes the right-hand side value of a cell and queues it if inconsistent.
+   * @param cell The index of the cell.
+   */
+  void updateVertex(uint32_t cell);
+
+  /**
+   * @brief Expands cells until the distance of the agent is consistent.
+   */
+  void computeShortestPath();
+
+  /**
+   * @brief Drops queue entries that were removed or re-queued with another key.
+   */
+  void dropStaleEntries();
+
+  /**
+   * @brief Returns the passable neighbours of a cell.
+   * @param cell The index of the cell.
+   * @param neighbors The array to write the neighbour indices to.
+   * @return The number of neighbours written.
+   */
+  uint32_t getNeighbors(uint32_t cell, uint32_t (&neighbors)[4]) const;
+
+  /**
+   * @brief Returns the Manhattan distance between two cells.
+   * @param first The index of the first cell.
+   * @param second The index of the second cell.
+   * @return The distance between the cells.
+   */
+  uint32_t heuristic(uint32_t first, uint32_t second) const;
+
+  uint32_t rows_; /**< The number of rows of the maze. */
+  uint32_t cols_; /**< The number of columns of the maze. */
+  uint32_t start_; /**< The index of the agent cell. */
+  uint32_t last_start_; /**< The agent cell when the key modifier was last updated. */
+  uint32_t goal_; /**< The index of the goal cell. */
+  uint32_t key_modifier_; /**< The sum of heuristic changes caused by agent moves. */
+  uint64_t expanded_; /**< The number of expanded cells. */
+  uint16_t keys_; /**< The keys the agent holds, bit c set for the key of colour c. */
+  std::unordered_map<uint32_t, uint32_t> door_colours_; /**< The colour of each locked door seen. */
+  std::vector<Knowledge> knowledge_; /**< What is known about each cell. */
+  std::vector<uint32_t> g_; /**< The current distance estimates to the goal. */
+  std::vector<uint32_t> rhs_; /**< The one-step lookahead distances to the goal. */
+  std::vector<Key> queued_keys_; /**< The key each queued cell was queued with. */
+  std::vector<bool> queued_; /**< Whether each cell is in the queue. */
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> queue_; /**< Open cells. */
+};
+
+}  // namespace maze
+
+#endif  // MAZE_PLANNER_HPP_
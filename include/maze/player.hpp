@@ -41,9 +41,22 @@ class Player {
    */
   uint32_t getCurrentFood() const;
 
+  /**
+   * @brief Adds the key of a colour to the player's inventory.
+   * @param colour The colour of the key.
+   */
+  void pickKey(uint32_t colour);
+
+  /**
+   * @brief Returns the keys in the player's inventory.
+   * @return The keys, bit c set for the key of colour c.
+   */
+  uint16_t getKeys() const;
+
  private:
   uint32_t maxWeight; /**< The maximum weight of food that the player can carry. */
   uint32_t currentWeight; /**< The current weight of food in the player's inventory. */
+  uint16_t keys; /**< The keys in the player's inventory, one bit per colour. */
 };
 
 }  // namespace maze
@@ -0,0 +1,103 @@
+/**
+ * @file radix_heap.hpp
+ * @brief Defines the RadixHeap class, a monotone priority queue for integer keys.
+ */
+
+#ifndef MAZE_RADIX_HEAP_HPP_
+#define MAZE_RADIX_HEAP_HPP_
+
+// Standard
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace maze {
+
+/**
+ * @class RadixHeap
+ * @brief A monotone min-priority queue with unsigned 32 bit keys.
+ *
+ * Keys may never be smaller than the last popped key, which holds for Dijkstra's algorithm with
+ * non-negative weights. Entries sit in buckets by the highest bit in which their key differs from
+ * the last popped key, so every entry moves between buckets at most 32 times and pushing and
+ * popping cost amortized O(1) for small weights.
+ *
+ * @tparam Value The type stored with each key.
+ */
+template <typename Value>
+class RadixHeap {
+ public:
+  /**
+   * @brief Adds an entry.
+   * @param key The key, at least the last popped key.
+   * @param value The value stored with the key.
+   */
+  void push(uint32_t key, const Value& value) {
+    buckets_[getBucket(key)].emplace_back(key, value);
+    ++size_;
+  }
+
+  /**
+   * @brief Removes an entry with the smallest key.
+   * @return The key and value of the removed entry. The heap must not be empty.
+   */
+  std::pair<uint32_t, Value> pop() {
+    if (buckets_[0].empty()) {
+      // Redistribute the first non-empty bucket around its smallest key.
+      std::size_t bucket = 1;
+      while (buckets_[bucket].empty()) {
+        ++bucket;
+      }
+      uint32_t smallest = std::numeric_limits<uint32_t>::max();
+      for (const auto& entry : buckets_[bucket]) {
+        smallest = entry.first < smallest ? entry.first : smallest;
+      }
+      last_ = smallest;
+      for (const auto& entry : buckets_[bucket]) {
+        buckets_[getBucket(entry.first)].push_back(entry);
+      }
+      buckets_[bucket].clear();
+    }
+
+    std::pair<uint32_t, Value> entry = buckets_[0].back();
+    buckets_[0].pop_back();
+    --size_;
+    return entry;
+  }
+
+  /**
+   * @brief Returns whether the heap holds no entries.
+   * @return True if the heap is empty, false otherwise.
+   */
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  /**
+   * @brief Returns the number of entries.
+   * @return The number of entries.
+   */
+  std::size_t size() const {
+    return size_;
+  }
+
+ private:
+  std::size_t getBucket(uint32_t key) const {
+    std::size_t bucket = 0;
+    for (uint32_t difference = key ^ last_; difference != 0; difference >>= 1) {
+      ++bucket;
+    }
+    return bucket;
+  }
+
+  std::array<std::vector<std::pair<uint32_t, Value>>, 33> buckets_; /**< Entries by bucket. */
+  uint32_t last_ = 0; /**< The last popped key. */
+  std::size_t size_ = 0; /**< The number of entries. */
+};
+
+}  // namespace maze
+
+#endif  // MAZE_RADIX_HEAP_HPP_
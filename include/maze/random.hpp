@@ -0,0 +1,225 @@
+/**
+ * @file random.hpp
+ * @brief Defines the random number generator and helpers for deriving reproducible seeds.
+ */
+
+#ifndef MAZE_RANDOM_HPP_
+#define MAZE_RANDOM_HPP_
+
+// Standard
+#include <cstddef>
+#include <cstdint>
+
+namespace maze {
+
+/**
+ * @brief Scrambles a 64 bit value with the SplitMix64 finalizer.
+ *
+ * Nearby inputs yield unrelated outputs, which makes this suitable for deriving independent seeds
+ * from a base seed and an index.
+ *
+ * @param value The value to scramble.
+ * @return The scrambled value.
+ */
+inline uint64_t splitMix64(uint64_t value) {
+  value += 0x9E3779B97F4A7C15ull;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+  return value ^ (value >> 31);
+}
+
+/**
+ * @brief Derives a seed for a sub-stream of a base seed.
+ * @param seed The base seed.
+ * @param index The index of the sub-stream.
+ * @return A seed for the sub-stream.
+ */
+inline uint64_t deriveSeed(uint64_t seed, uint64_t index) {
+  return splitMix64(seed ^ splitMix64(index));
+}
+
+/**
+ * @class RandomGenerator
+ * @brief A small and fast xoshiro256** pseudo-random number generator.
+ *
+ * The state is four 64 bit words, so generators are cheap to create, copy and keep per thread.
+ * It satisfies UniformRandomBitGenerator and can be passed to the standard algorithms. Unlike
+ * taking the remainder of a draw, the bounded draws below are unbiased for every bound.
+ */
+class RandomGenerator {
+ public:
+  using result_type = uint64_t;
+
+  /**
+   * @brief Seeds the generator, expanding the seed into the state with SplitMix64.
+   * @param seed The seed.
+   */
+  explicit RandomGenerator(uint64_t seed) {
+    for (uint64_t i = 0; i < 4; ++i) {
+      state_[i] = splitMix64(seed + i * 0x9E3779B97F4A7C15ull);
+    }
+  }
+
+  /**
+   * @brief Creates the generator of one stream of a base seed.
+   *
+   * Every maze index gets its own hashed seed. Threads working on the same index get streams
+   * 2^128 draws apart, so they can never overlap.
+   *
+   * @param seed The base seed.
+   * @param index The index of the maze, region or chunk the stream is for.
+   * @param thread The index of the thread the stream is for.
+   * @return The generator of the stream.
+   */
+  static RandomGenerator forStream(uint64_t seed, uint64_t index, uint32_t thread = 0) {
+    RandomGenerator rng(deriveSeed(seed, index));
+    for (uint32_t i = 0; i < thread; ++i) {
+      rng.jump();
+    }
+    return rng;
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return ~result_type(0); }
+
+  /**
+   * @brief Draws the next 64 random bits.
+   * @return The random bits.
+   */
+  result_type operator()() {
+    const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+    const uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = rotl(state_[3], 45);
+    return result;
+  }
+
+  /**
+   * @brief Draws an integer in [0, bound).
+   * @param bound The exclusive upper bound, must be positive.
+   * @return The random integer.
+   */
+  uint64_t below(uint64_t bound) {
+    if (bound <= 0xFFFFFFFFull) {
+      return below32(static_cast<uint32_t>(bound));
+    }
+    // Mask down to the next power of two and reject, at most half of the draws are rejected.
+    uint64_t mask = bound - 1;
+    mask |= mask >> 1;
+    mask |= mask >> 2;
+    mask |= mask >> 4;
+    mask |= mask >> 8;
+    mask |= mask >> 16;
+    mask |= mask >> 32;
+    uint64_t value = (*this)() & mask;
+    while (value >= bound) {
+      value = (*this)() & mask;
+    }
+    return value;
+  }
+
+  /**
+   * @brief Draws a double in [0, 1) with 53 random bits.
+   * @return The random double.
+   */
+  double unit() {
+    return static_cast<double>((*this)() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  /**
+   * @brief Fills a buffer with random bits.
+   * @param out The buffer to fill.
+   * @param count The number of values to write.
+   */
+  void fill(uint64_t* out, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      out[i] = (*this)();
+    }
+  }
+
+  /**
+   * @brief Fills a buffer with integers in [0, bound).
+   * @param out The buffer to fill.
+   * @param count The number of values to write.
+   * @param bound The exclusive upper bound, must be positive.
+   */
+  void fillBelow(uint32_t* out, std::size_t count, uint32_t bound) {
+    for (std::size_t i = 0; i < count; ++i) {
+      out[i] = below32(bound);
+    }
+  }
+
+  /**
+   * @brief Fills a buffer with doubles in [0, 1).
+   * @param out The buffer to fill.
+   * @param count The number of values to write.
+   */
+  void fillUnit(double* out, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      out[i] = unit();
+    }
+  }
+
+  /**
+   * @brief Advances the generator by 2^128 draws, as if operator() was called that often.
+   */
+  void jump() {
+    constexpr uint64_t kJump[] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                  0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+    uint64_t jumped[4] = {0, 0, 0, 0};
+    for (const uint64_t word : kJump) {
+      for (uint32_t bit = 0; bit < 64; ++bit) {
+        if ((word >> bit) & 1) {
+          for (uint32_t i = 0; i < 4; ++i) {
+            jumped[i] ^= state_[i];
+          }
+        }
+        (*this)();
+      }
+    }
+    for (uint32_t i = 0; i < 4; ++i) {
+      state_[i] = jumped[i];
+    }
+  }
+
+ private:
+  /**
+   * @brief Draws an integer in [0, bound) with Lemire's multiply-and-reject method.
+   *
+   * Only draws whose low product half falls below 2^32 mod bound are rejected, which needs a
+   * division in rare cases only.
+   *
+   * @param bound The exclusive upper bound, must be positive.
+   * @return The random integer.
+   */
+  uint32_t below32(uint32_t bound) {
+    uint64_t product = ((*this)() >> 32) * bound;
+    if (static_cast<uint32_t>(product) < bound) {
+      const uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+      while (static_cast<uint32_t>(product) < threshold) {
+        product = ((*this)() >> 32) * bound;
+      }
+    }
+    return static_cast<uint32_t>(product >> 32);
+  }
+
+  /**
+   * @brief Rotates a value left.
+   * @param value The value to rotate.
+   * @param shift The number of bits to rotate by, in (0, 64).
+   * @return The rotated value.
+   */
+  static uint64_t rotl(uint64_t value, int shift) {
+    return (value << shift) | (value >> (64 - shift));
+  }
+
+  uint64_t state_[4]; /**< The generator state, never all zero. */
+};
+
+}  // namespace maze
+
+#endif  // MAZE_RANDOM_HPP_
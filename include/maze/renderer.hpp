@@ -0,0 +1,152 @@
+/**
+ * @file renderer.hpp
+ * @brief Defines the MazeRenderer class, which draws mazes as text or binary images.
+ */
+
+#ifndef MAZE_RENDERER_HPP_
+#define MAZE_RENDERER_HPP_
+
+// Standard
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Private
+#include "maze.hpp"
+
+namespace maze {
+
+/**
+ * @enum RenderFormat
+ * @brief The output formats a maze can be rendered in.
+ */
+enum class RenderFormat {
+  ASCII, /**< One character per cell and a newline per row. */
+  PGM, /**< A binary greyscale image (P5). */
+  PPM /**< A binary colour image (P6). */
+};
+
+/**
+ * @brief Options that control how a maze is rendered.
+ */
+struct RenderOptions {
+  RenderFormat format = RenderFormat::ASCII; /**< The output format. */
+  uint32_t scale = 1; /**< The edge length in pixels of a cell in images. */
+  std::vector<Maze::Move> path; /**< Moves from the player position to draw, e.g. a solution. */
+  std::optional<uint32_t> sight_radius; /**< If set, cells the player does not perceive fade. */
+  uint32_t threads = 1; /**< The number of threads to render with, 0 for one per hardware thread. */
+};
+
+/**
+ * @class MazeRenderer
+ * @brief Renders a maze into caller-provided buffers or a stream, without per-cell output calls.
+ *
+ * Every cell row takes the same number of bytes, so any range of rows can be rendered on its own
+ * into its slice of a preallocated buffer. That lets huge mazes be streamed a band of rows at a
+ * time and lets bands be rendered in parallel. In ASCII, the player is 'X', the start 'o', the end
+ * 'O', doors 'D', food 'F', keys 'K', mud 'M', water 'W', walls '#', empty cells '.', the path '*'
+ * and unperceived cells ' '.
+ *
+ * The renderer keeps a reference to the maze, which must outlive it and not change meanwhile.
+ */
+class MazeRenderer {
+ public:
+  /**
+   * @brief Prepares rendering a maze, tracing the path and the perceived area once.
+   * @param maze The maze to render.
+   * @param options The options controlling format, scale and overlays.
+   * @throws std::invalid_argument If the scale is 0.
+   */
+  MazeRenderer(const Maze& maze, RenderOptions options = RenderOptions());
+
+  /**
+   * @brief Returns the size of the image header, 0 for ASCII.
+   * @return The size of the header in bytes.
+   */
+  std::size_t getHeaderSize() const;
+
+  /**
+   * @brief Returns the size of one rendered cell row, including all its pixel rows.
+   * @return The size of a cell row in bytes.
+   */
+  std::size_t getRowSize() const;
+
+  /**
+   * @brief Returns the size of the whole rendered maze.
+   * @return The size of the header and all rows in bytes.
+   */
+  std::size_t getSize() const;
+
+  /**
+   * @brief Writes the image header.
+   * @param out The buffer to write to, at least getHeaderSize() bytes.
+   */
+  void renderHeader(char* out) const;
+
+  /**
+   * @brief Renders a range of cell rows.
+   * @param first_row The first cell row to render.
+   * @param count The number of cell rows to render.
+   * @param out The buffer to write to, at least count * getRowSize() bytes.
+   */
+  void renderRows(uint32_t first_row, uint32_t count, char* out) const;
+
+  /**
+   * @brief Renders the whole maze, in parallel bands of rows if more than one thread is used.
+   * @param out The buffer to write to, at least getSize() bytes.
+   */
+  void render(char* out) const;
+
+  /**
+   * @brief Renders the whole maze into a string.
+   * @return The rendered maze.
+   */
+  std::string render() const;
+
+  /**
+   * @brief Streams the maze a band of rows at a time, reusing one buffer for all bands.
+   * @param out The stream to write to.
+   * @param band_rows The number of cell rows per band.
+   */
+  void write(std::ostream& out, uint32_t band_rows = 256) const;
+
+ private:
+  /**
+   * @brief The kinds of cells, each with its own character and colour.
+   */
+  enum Shade : uint8_t {
+    WALL, EMPTY, FOOD, DOOR, KEY, MUD, WATER, START, END, PLAYER, PATH, SHADE_COUNT
+  };
+
+  /**
+   * @brief Returns the shade of a cell, before fading it if it is not perceived.
+   * @param row The row of the cell.
+   * @param col The column of the cell.
+   * @return The shade of the cell.
+   */
+  Shade getShade(uint32_t row, uint32_t col) const;
+
+  /**
+   * @brief Returns whether or not the player perceives a cell, always true without a sight radius.
+   * @param row The row of the cell.
+   * @param col The column of the cell.
+   * @return True if the cell is perceived, false otherwise.
+   */
+  bool isPerceived(uint32_t row, uint32_t col) const;
+
+  const Maze& maze_; /**< The maze to render. */
+  const Grid& grid_; /**< The cells of the maze. */
+  Coordinates player_pos_; /**< The player position, drawn over everything else. */
+  Coordinates start_pos_; /**< The start position. */
+  Coordinates end_pos_; /**< The end position. */
+  RenderOptions options_; /**< The rendering options. */
+  uint32_t channels_; /**< Bytes per pixel, 0 for ASCII. */
+  std::vector<uint64_t> path_cells_; /**< A bit per cell, set for cells on the path. */
+  std::vector<Maze::PerceivedTile> perceived_; /**< The window of tiles the player perceives. */
+};
+
+}  // namespace maze
+
+#endif  // MAZE_RENDERER_HPP_
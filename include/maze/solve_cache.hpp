@@ -0,0 +1,103 @@
+/**
+ * @file solve_cache.hpp
+ * @brief Defines the SolveCache class, a bounded cache of maze solutions shared between mazes.
+ */
+
+#ifndef MAZE_SOLVE_CACHE_HPP_
+#define MAZE_SOLVE_CACHE_HPP_
+
+// Standard
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Private
+#include "maze.hpp"
+
+namespace maze {
+
+/**
+ * @class SolveCache
+ * @brief A thread-safe, bounded least-recently-used cache of solve results.
+ *
+ * Results are keyed by the state hash of a maze, which covers the layout, the player position and
+ * the carried food. Every move changes the key, so entries never have to be invalidated. Unsolvable
+ * states are cached as well. One cache can be shared by any number of mazes and threads.
+ */
+class SolveCache {
+ public:
+  /**
+   * @brief A cached result: the moves from the player to the end, or nothing if unsolvable.
+   */
+  using Result = std::optional<std::vector<Maze::Move>>;
+
+  /**
+   * @brief Constructs an empty cache.
+   * @param capacity The maximum number of results kept.
+   * @throws std::invalid_argument If the capacity is 0.
+   */
+  explicit SolveCache(std::size_t capacity);
+
+  /**
+   * @brief Looks up a result and marks it as most recently used.
+   * @param key The state hash to look up.
+   * @return The shared result, or a null pointer on a miss.
+   */
+  std::shared_ptr<const Result> find(uint64_t key);
+
+  /**
+   * @brief Stores a result, evicting the least recently used one if the cache is full.
+   * @param key The state hash the result belongs to.
+   * @param result The result to store.
+   */
+  void insert(uint64_t key, Result result);
+
+  /**
+   * @brief Removes all results. The hit and miss counters are kept.
+   */
+  void clear();
+
+  /**
+   * @brief Returns the number of results currently cached.
+   * @return The number of cached results.
+   */
+  std::size_t getSize() const;
+
+  /**
+   * @brief Returns the maximum number of results kept.
+   * @return The capacity of the cache.
+   */
+  std::size_t getCapacity() const;
+
+  /**
+   * @brief Returns the number of lookups that found a result.
+   * @return The number of hits.
+   */
+  uint64_t getHits() const;
+
+  /**
+   * @brief Returns the number of lookups that found no result.
+   * @return The number of misses.
+   */
+  uint64_t getMisses() const;
+
+ private:
+  using Entry = std::pair<uint64_t, std::shared_ptr<const Result>>;
+
+  std::size_t capacity_; /**< The maximum number of results kept. */
+  mutable std::mutex mutex_; /**< Guards the recency list and the index. */
+  std::list<Entry> entries_; /**< The results, most recently used first. */
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> index_; /**< Results by key. */
+  std::atomic<uint64_t> hits_; /**< The number of lookups that found a result. */
+  std::atomic<uint64_t> misses_; /**< The number of lookups that found no result. */
+};
+
+}  // namespace maze
+
+#endif  // MAZE_SOLVE_CACHE_HPP_
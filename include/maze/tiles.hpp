@@ -72,21 +72,151 @@ public:
 };
 
 /**
- * @brief A tile that can be passed through, but only when a condition is met.
+ * @brief A passable tile that costs more food to enter than an empty tile.
  */
-class DoorTile : public Tile {
+class TerrainTile : public Tile {
 public:
   /**
-   * @brief Returns true, indicating that this tile can be passed through.
+   * @brief Constructs a new TerrainTile with the given move cost.
+   * @param cost The food it costs to enter the tile.
+   */
+  explicit TerrainTile(uint32_t cost);
+
+  /**
+   * @brief Returns true, indicating that this tile can always be passed through.
    * @return True
    */
   bool isPassable() const override;
 
+  /**
+   * @brief Returns the food it costs to enter the tile.
+   * @return The move cost.
+   */
+  uint32_t getCost() const;
+
+private:
+  uint32_t cost; /**< The food it costs to enter the tile. */
+};
+
+/**
+ * @brief A mud tile, slow to cross.
+ */
+class MudTile : public TerrainTile {
+public:
+  /**
+   * @brief Constructs a new MudTile with the given move cost.
+   * @param cost The food it costs to enter the tile.
+   */
+  explicit MudTile(uint32_t cost);
+
+  /**
+   * @brief Creates a copy of the MudTile.
+   * @return A unique_ptr to a new MudTile that is a copy of the current tile.
+   */
+  std::unique_ptr<Tile> clone() const override;
+};
+
+/**
+ * @brief A water tile, slower to cross than mud by default.
+ */
+class WaterTile : public TerrainTile {
+public:
+  /**
+   * @brief Constructs a new WaterTile with the given move cost.
+   * @param cost The food it costs to enter the tile.
+   */
+  explicit WaterTile(uint32_t cost);
+
+  /**
+   * @brief Creates a copy of the WaterTile.
+   * @return A unique_ptr to a new WaterTile that is a copy of the current tile.
+   */
+  std::unique_ptr<Tile> clone() const override;
+};
+
+/**
+ * @brief A tile that can be passed through, but only with the key of its colour if it is locked.
+ */
+class DoorTile : public Tile {
+public:
+  /**
+   * @brief Constructs a new unlocked DoorTile.
+   */
+  DoorTile();
+
+  /**
+   * @brief Constructs a new DoorTile that is locked with a key colour.
+   * @param colour The colour of the key that opens the door.
+   */
+  explicit DoorTile(uint32_t colour);
+
+  /**
+   * @brief Returns whether the door can be passed through without any key.
+   * @return True if the door is unlocked, false otherwise.
+   */
+  bool isPassable() const override;
+
+  /**
+   * @brief Returns whether the door can be passed through by a player holding some keys.
+   * @param keys The held keys, bit c set for the key of colour c.
+   * @return True if the door is unlocked or its key is held, false otherwise.
+   */
+  bool isPassable(uint16_t keys) const;
+
+  /**
+   * @brief Returns whether the door is locked.
+   * @return True if the door needs a key, false otherwise.
+   */
+  bool isLocked() const;
+
+  /**
+   * @brief Returns the colour of the key that opens the door.
+   * @return The key colour, only meaningful for locked doors.
+   */
+  uint32_t getColour() const;
+
   /**
    * @brief Creates a copy of the DoorTile.
    * @return A unique_ptr to a new DoorTile that is a copy of the current tile.
    */
   std::unique_ptr<Tile> clone() const override;
+
+private:
+  bool locked; /**< Whether the door needs a key. */
+  uint32_t colour; /**< The colour of the key that opens the door. */
+};
+
+/**
+ * @brief A tile holding a key, which is picked up when the tile is entered.
+ */
+class KeyTile : public Tile {
+public:
+  /**
+   * @brief Constructs a new KeyTile with the given colour.
+   * @param colour The colour of the key.
+   */
+  explicit KeyTile(uint32_t colour);
+
+  /**
+   * @brief Returns true, indicating that this tile can always be passed through.
+   * @return True
+   */
+  bool isPassable() const override;
+
+  /**
+   * @brief Returns the colour of the key.
+   * @return The colour of the key.
+   */
+  uint32_t getColour() const;
+
+  /**
+   * @brief Creates a copy of the KeyTile.
+   * @return A unique_ptr to a new KeyTile that is a copy of the current tile.
+   */
+  std::unique_ptr<Tile> clone() const override;
+
+private:
+  uint32_t colour; /**< The colour of the key. */
 };
 
 /**
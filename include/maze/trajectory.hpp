@@ -0,0 +1,133 @@
+/**
+ * @file trajectory.hpp
+ * @brief Defines compact trajectory recordings and their parallel replay.
+ */
+
+#ifndef MAZE_TRAJECTORY_HPP_
+#define MAZE_TRAJECTORY_HPP_
+
+// Standard
+#include <cstdint>
+#include <vector>
+
+// Private
+#include "coordinates.hpp"
+#include "maze.hpp"
+
+namespace maze {
+
+/**
+ * @enum TrajectoryOutcome
+ * @brief How an episode ended.
+ */
+enum class TrajectoryOutcome : uint8_t {
+  UNFINISHED, /**< The moves ran out before the end was reached. */
+  REACHED_END, /**< The player reached the end. */
+  STARVED /**< The player ran out of food before reaching the end. */
+};
+
+/**
+ * @class Trajectory
+ * @brief The moves of one episode, packed into two bits each.
+ *
+ * The header holds the layout hash of the maze the episode was played on and its outcome, so a
+ * recording can be matched to its maze and verified later. Serialized, a trajectory takes 17 bytes
+ * plus a quarter byte per move.
+ */
+class Trajectory {
+ public:
+  /**
+   * @brief Constructs an empty trajectory.
+   * @param layout_hash The layout hash of the maze at the start of the episode.
+   */
+  explicit Trajectory(uint64_t layout_hash = 0);
+
+  /**
+   * @brief Appends a move.
+   * @param move The move to append.
+   */
+  void append(Maze::Move move);
+
+  /**
+   * @brief Returns a recorded move.
+   * @param index The index of the move.
+   * @return The move at the index.
+   */
+  Maze::Move getMove(std::size_t index) const;
+
+  /**
+   * @brief Returns the number of recorded moves.
+   * @return The number of moves.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Returns the layout hash of the maze the episode was played on.
+   * @return The layout hash.
+   */
+  uint64_t getLayoutHash() const;
+
+  /**
+   * @brief Returns the recorded outcome of the episode.
+   * @return The outcome.
+   */
+  TrajectoryOutcome getOutcome() const;
+
+  /**
+   * @brief Sets the recorded outcome of the episode.
+   * @param outcome The outcome.
+   */
+  void setOutcome(TrajectoryOutcome outcome);
+
+  /**
+   * @brief Serializes the header and packed moves into bytes, in little endian order.
+   * @return The serialized trajectory.
+   */
+  std::vector<uint8_t> serialize() const;
+
+  /**
+   * @brief Restores a trajectory from serialize()'s output.
+   * @param bytes The serialized trajectory.
+   * @return The restored trajectory.
+   * @throws std::invalid_argument If the bytes are not a valid trajectory.
+   */
+  static Trajectory deserialize(const std::vector<uint8_t>& bytes);
+
+ private:
+  uint64_t layout_hash_; /**< The layout hash of the maze the episode was played on. */
+  TrajectoryOutcome outcome_; /**< The outcome of the episode. */
+  uint32_t size_; /**< The number of moves. */
+  std::vector<uint8_t> packed_moves_; /**< Four moves per byte, the first in the low bits. */
+};
+
+/**
+ * @brief The state of a player after replaying a trajectory.
+ */
+struct ReplayResult {
+  bool maze_found = false; /**< Whether a maze with the recorded layout hash was given. */
+  Coordinates final_position = {0, 0}; /**< The position after the last replayed move. */
+  uint32_t food = 0; /**< The food carried after the last replayed move. */
+  std::size_t moves_replayed = 0; /**< The moves replayed until the episode ended. */
+  TrajectoryOutcome outcome = TrajectoryOutcome::UNFINISHED; /**< The outcome of the replay. */
+  bool matches_recording = false; /**< Whether the outcome equals the recorded one. */
+};
+
+/**
+ * @brief Replays trajectories against the mazes they were recorded on, in parallel.
+ *
+ * Moves follow the rules of Maze::movePlayer() from the start with full food, through the
+ * step() forward model. An episode ends when the end is reached or the food runs out. Each maze
+ * is turned into one Layout shared by its replays, which only keep their own game state.
+ *
+ * @param mazes The mazes, in their initial state, matched to trajectories by layout hash.
+ * @param trajectories The trajectories to replay.
+ * @param threads The number of threads to replay with, 0 for one per hardware thread.
+ * @return One result per trajectory, in the same order.
+ */
+std::vector<ReplayResult> replayTrajectories(const std::vector<const Maze*>& mazes,
+                                             const std::vector<Trajectory>& trajectories,
+                                             uint32_t threads = 0);
+
+}  // namespace maze
+
+#endif  // MAZE_TRAJECTORY_HPP_
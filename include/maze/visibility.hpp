@@ -0,0 +1,97 @@
+/**
+ * @file visibility.hpp
+ * @brief Defines the VisibilityIndex class, which stores the cells visible from every cell.
+ */
+
+#ifndef MAZE_VISIBILITY_HPP_
+#define MAZE_VISIBILITY_HPP_
+
+// Standard
+#include <cstdint>
+#include <vector>
+
+// Private
+#include "coordinates.hpp"
+
+namespace maze {
+
+class Maze;
+
+/**
+ * @brief A horizontal run of visible cells, relative to the cell they are visible from.
+ */
+struct VisibleRun {
+  int16_t row_offset; /**< The row of the run relative to the viewer. */
+  int16_t col_offset; /**< The first column of the run relative to the viewer. */
+  uint16_t length; /**< The number of visible cells in the run. */
+};
+
+/**
+ * @class VisibilityIndex
+ * @brief The cells visible from every passable cell of a maze within a fixed sight radius.
+ *
+ * Sight is only blocked by walls, which do not change once a maze is built, so the index stays
+ * valid while food is eaten. The visible cells of each viewer are stored as runs of a row, all
+ * runs in one array with an offset per cell. The index holds no reference to the maze and can be
+ * shared by all mazes with the same walls.
+ */
+class VisibilityIndex {
+ public:
+  /**
+   * @brief Computes the visible cells of every passable cell of a maze.
+   * @param maze The maze to index.
+   * @param radius The sight radius, as passed to Maze::perceiveTiles().
+   * @param threads The number of threads to build with, 0 for one per hardware thread.
+   * @throws std::invalid_argument If the radius is above 32767.
+   */
+  VisibilityIndex(const Maze& maze, uint32_t radius, uint32_t threads = 0);
+
+  /**
+   * @brief Returns the sight radius the index was built for.
+   * @return The sight radius.
+   */
+  uint32_t getRadius() const;
+
+  /**
+   * @brief Returns the number of rows of the indexed maze.
+   * @return The number of rows.
+   */
+  uint32_t getRows() const;
+
+  /**
+   * @brief Returns the number of columns of the indexed maze.
+   * @return The number of columns.
+   */
+  uint32_t getCols() const;
+
+  /**
+   * @brief Returns the first visible run of a viewer.
+   * @param viewer The position the cells are seen from.
+   * @return A pointer to the first run, up to getRunsEnd().
+   */
+  const VisibleRun* getRunsBegin(const Coordinates& viewer) const;
+
+  /**
+   * @brief Returns the end of the visible runs of a viewer.
+   * @param viewer The position the cells are seen from.
+   * @return A pointer past the last run.
+   */
+  const VisibleRun* getRunsEnd(const Coordinates& viewer) const;
+
+  /**
+   * @brief Returns the total number of stored runs.
+   * @return The number of runs.
+   */
+  std::size_t getRunCount() const;
+
+ private:
+  uint32_t radius_; /**< The sight radius. */
+  uint32_t rows_; /**< The number of rows of the indexed maze. */
+  uint32_t cols_; /**< The number of columns of the indexed maze. */
+  std::vector<uint64_t> offsets_; /**< The first run of each cell, plus the total at the end. */
+  std::vector<VisibleRun> runs_; /**< The runs of all cells, in cell order. */
+};
+
+}  // namespace maze
+
+#endif  // MAZE_VISIBILITY_HPP_
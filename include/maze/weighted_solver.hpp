@@ -0,0 +1,42 @@
+/**
+ * @file weighted_solver.hpp
+ * @brief Defines a shortest-path solver for mazes with weighted terrain.
+ */
+
+#ifndef MAZE_WEIGHTED_SOLVER_HPP_
+#define MAZE_WEIGHTED_SOLVER_HPP_
+
+// Standard
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Private
+#include "maze.hpp"
+
+namespace maze {
+
+/**
+ * @brief The cheapest way from the player to the end.
+ */
+struct WeightedPath {
+  std::vector<Maze::Move> moves; /**< The moves to the end. */
+  uint32_t cost = 0; /**< The food the moves cost, ignoring food picked up on the way. */
+};
+
+/**
+ * @brief Finds the path from the player to the end that costs the least food to walk.
+ *
+ * Entering a cell costs its move cost, so mud and water are avoided when a cheaper detour exists.
+ * The search is Dijkstra's algorithm on a radix heap, whose cost grows with the number of cells
+ * and the logarithm of the path cost rather than of the queue size. Locked doors are only passed
+ * with keys the player holds.
+ *
+ * @param maze The maze to solve, from the current player position.
+ * @return The cheapest path, or nothing if the end cannot be reached.
+ */
+std::optional<WeightedPath> solveWeighted(const Maze& maze);
+
+}  // namespace maze
+
+#endif  // MAZE_WEIGHTED_SOLVER_HPP_
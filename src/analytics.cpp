@@ -0,0 +1,159 @@
+#include <maze/analytics.hpp>
+
+// Standard
+#include <limits>
+#include <queue>
+
+// Private
+#include <maze/maze.hpp>
+
+namespace maze {
+
+namespace {
+constexpr int32_t kRowOffsets[] = {-1, 1, 0, 0};
+constexpr int32_t kColOffsets[] = {0, 0, -1, 1};
+} // namespace
+
+MazeAnalytics analyzeMaze(const Maze& maze, uint32_t sight_radius) {
+  const Grid& grid = maze.getGrid();
+  const uint32_t rows = grid.getRows();
+  const uint32_t cols = grid.getCols();
+  const auto flatIndex = [cols](uint32_t row, uint32_t col) {
+    return static_cast<std::size_t>(row) * cols + col;
+  };
+  const auto isOpen = [&](int64_t row, int64_t col) {
+    return row >= 0 && col >= 0 && row < rows && col < cols &&
+           isPassable(grid.get(static_cast<uint32_t>(row), static_cast<uint32_t>(col)).type);
+  };
+
+  MazeAnalytics analytics;
+  analytics.sight_radius = sight_radius;
+
+  // First pass: passable neighbour counts, dead ends and junctions.
+  std::vector<uint8_t> degrees(static_cast<std::size_t>(rows) * cols, 0);
+  for (uint32_t row = 0; row < rows; ++row) {
+    for (uint32_t col = 0; col < cols; ++col) {
+      if (!isOpen(row, col)) {
+        continue;
+      }
+      uint8_t degree = 0;
+      for (uint32_t direction = 0; direction < 4; ++direction) {
+        degree += isOpen(static_cast<int64_t>(row) + kRowOffsets[direction],
+                         static_cast<int64_t>(col) + kColOffsets[direction]) ? 1 : 0;
+      }
+      degrees[flatIndex(row, col)] = degree;
+      analytics.passable_cells++;
+      analytics.dead_ends += degree == 1 ? 1 : 0;
+      analytics.junctions += degree >= 3 ? 1 : 0;
+    }
+  }
+
+  // Walk every corridor once from its first unvisited cell, in both directions.
+  std::vector<bool> in_corridor(degrees.size(), false);
+  for (uint32_t row = 0; row < rows; ++row) {
+    for (uint32_t col = 0; col < cols; ++col) {
+      if (degrees[flatIndex(row, col)] != 2 || in_corridor[flatIndex(row, col)]) {
+        continue;
+      }
+      in_corridor[flatIndex(row, col)] = true;
+      uint32_t length = 1;
+      for (uint32_t direction = 0; direction < 4; ++direction) {
+        int64_t previous_row = row;
+        int64_t previous_col = col;
+        int64_t current_row = static_cast<int64_t>(row) + kRowOffsets[direction];
+        int64_t current_col = static_cast<int64_t>(col) + kColOffsets[direction];
+        while (isOpen(current_row, current_col)) {
+          const std::size_t current = flatIndex(static_cast<uint32_t>(current_row),
+                                                static_cast<uint32_t>(current_col));
+          if (degrees[current] != 2 || in_corridor[current]) {
+            break;
+          }
+          in_corridor[current] = true;
+          length++;
+          for (uint32_t next = 0; next < 4; ++next) {
+            const int64_t next_row = current_row + kRowOffsets[next];
+            const int64_t next_col = current_col + kColOffsets[next];
+            if ((next_row != previous_row || next_col != previous_col) &&
+                isOpen(next_row, next_col)) {
+              previous_row = current_row;
+              previous_col = current_col;
+              current_row = next_row;
+              current_col = next_col;
+              break;
+            }
+          }
+        }
+      }
+      if (analytics.corridor_lengths.size() <= length) {
+        analytics.corridor_lengths.resize(length + 1, 0);
+      }
+      analytics.corridor_lengths[length]++;
+    }
+  }
+
+  // Second pass: breadth-first search from the start, remembering where each cell was entered from.
+  const Coordinates start = maze.getStartPosition();
+  const Coordinates end = maze.getEndPosition();
+  constexpr uint8_t kUnvisited = std::numeric_limits<uint8_t>::max();
+  std::vector<uint8_t> entered_from(degrees.size(), kUnvisited);
+  std::vector<uint32_t> distances(degrees.size(), 0);
+  std::queue<Coordinates> open;
+  entered_from[flatIndex(start.row, start.col)] = 4;
+  open.push(start);
+  while (!open.empty()) {
+    const Coordinates current = open.front();
+    open.pop();
+    if (grid.get(current.row, current.col).type == TileType::FOOD) {
+      analytics.reachable_food++;
+    }
+    for (uint8_t direction = 0; direction < 4; ++direction) {
+      const int64_t next_row = static_cast<int64_t>(current.row) + kRowOffsets[direction];
+      const int64_t next_col = static_cast<int64_t>(current.col) + kColOffsets[direction];
+      if (!isOpen(next_row, next_col)) {
+        continue;
+      }
+      const Coordinates next{static_cast<uint32_t>(next_row), static_cast<uint32_t>(next_col)};
+      if (entered_from[flatIndex(next.row, next.col)] != kUnvisited) {
+        continue;
+      }
+      entered_from[flatIndex(next.row, next.col)] = direction;
+      distances[flatIndex(next.row, next.col)] = distances[flatIndex(current.row, current.col)] + 1;
+      open.push(next);
+    }
+  }
+
+  if (entered_from[flatIndex(end.row, end.col)] != kUnvisited) {
+    analytics.shortest_path_length = distances[flatIndex(end.row, end.col)];
+    for (Coordinates current = end; current != start;) {
+      if (grid.get(current.row, current.col).type == TileType::FOOD) {
+        analytics.food_on_path++;
+      }
+      const uint8_t direction = entered_from[flatIndex(current.row, current.col)];
+      current.row -= kRowOffsets[direction];
+      current.col -= kColOffsets[direction];
+    }
+  }
+
+  // Cells the player would perceive when standing on the start.
+  const int64_t radius = sight_radius;
+  for (int64_t row = static_cast<int64_t>(start.row) - radius; row <= start.row + radius; ++row) {
+    for (int64_t col = static_cast<int64_t>(start.col) - radius; col <= start.col + radius; ++col) {
+      if (row < 0 || col < 0 || row >= rows || col >= cols) {
+        continue;
+      }
+      const int64_t delta_row = row - start.row;
+      const int64_t delta_col = col - start.col;
+      if (delta_row * delta_row + delta_col * delta_col > radius * radius) {
+        continue;
+      }
+      const Coordinates target{static_cast<uint32_t>(row), static_cast<uint32_t>(col)};
+      if (maze.hasLineOfSight(start, target)) {
+        analytics.visible_from_start++;
+      }
+    }
+  }
+
+  return analytics;
+}
+
+}  // namespace maze
@@ -0,0 +1,187 @@
+#include <maze/belief_map.hpp>
+
+// Standard
+#include <algorithm>
+
+namespace maze {
+
+BeliefMap::BeliefMap(uint32_t rows, uint32_t cols)
+  : rows_(rows), cols_(cols), known_count_(0), keys_(0),
+    tiles_(static_cast<std::size_t>(rows) * cols, Maze::PerceivedTile::UNKNOWN),
+    frontier_slots_(tiles_.size(), kNotInFrontier), visit_marks_(tiles_.size(), 0),
+    parents_(tiles_.size()), search_mark_(0) {
+}
+
+uint32_t BeliefMap::merge(const Coordinates& center,
+                          const std::vector<std::vector<Maze::PerceivedTile>>& window) {
+  const int64_t radius = static_cast<int64_t>(window.size()) / 2;
+  uint32_t changed = 0;
+  for (std::size_t rel_row = 0; rel_row < window.size(); ++rel_row) {
+    const int64_t row = static_cast<int64_t>(center.row) - radius + static_cast<int64_t>(rel_row);
+    if (row < 0 || row >= rows_) {
+      continue;
+    }
+    for (std::size_t rel_col = 0; rel_col < window[rel_row].size(); ++rel_col) {
+      const int64_t col = static_cast<int64_t>(center.col) - radius + static_cast<int64_t>(rel_col);
+      const Maze::PerceivedTile tile = window[rel_row][rel_col];
+      if (col < 0 || col >= cols_ || tile == Maze::PerceivedTile::UNKNOWN) {
+        continue;
+      }
+
+      const uint32_t cell = static_cast<uint32_t>(row) * cols_ + static_cast<uint32_t>(col);
+      const Maze::PerceivedTile previous = tiles_[cell];
+      if (previous == tile) {
+        continue;
+      }
+      tiles_[cell] = tile;
+      ++changed;
+      if (previous == Maze::PerceivedTile::UNKNOWN) {
+        ++known_count_;
+      }
+      if (getDoorColour(tile) < kKeyColours && getDoorColour(previous) >= kKeyColours) {
+        locked_doors_.push_back(cell);
+      } else if (getDoorColour(tile) >= kKeyColours && getDoorColour(previous) < kKeyColours) {
+        locked_doors_.erase(std::find(locked_doors_.begin(), locked_doors_.end(), cell));
+      }
+
+      // Only the cell itself and its neighbours can enter or leave the frontier.
+      refreshFrontier(cell);
+      uint32_t neighbors[4];
+      const uint32_t neighbor_count = getNeighbors(cell, neighbors);
+      for (uint32_t i = 0; i < neighbor_count; ++i) {
+        refreshFrontier(neighbors[i]);
+      }
+    }
+  }
+  return changed;
+}
+
+void BeliefMap::setKeys(uint16_t keys) {
+  keys_ = keys;
+  // Whether its neighbours are frontier cells does not depend on a door, only the door itself.
+  for (const uint32_t cell : locked_doors_) {
+    refreshFrontier(cell);
+  }
+}
+
+Maze::PerceivedTile BeliefMap::getTile(const Coordinates& pos) const {
+  return tiles_[static_cast<std::size_t>(pos.row) * cols_ + pos.col];
+}
+
+std::size_t BeliefMap::getKnownCount() const {
+  return known_count_;
+}
+
+bool BeliefMap::isFrontier(const Coordinates& pos) const {
+  return frontier_slots_[static_cast<std::size_t>(pos.row) * cols_ + pos.col] != kNotInFrontier;
+}
+
+const std::vector<Coordinates>& BeliefMap::getFrontier() const {
+  return frontier_;
+}
+
+std::optional<FrontierPath> BeliefMap::findNearestFrontier(const Coordinates& from) {
+  const uint32_t start = from.row * cols_ + from.col;
+  if (frontier_.empty() || !isKnownPassable(tiles_[start])) {
+    return std::nullopt;
+  }
+
+  if (++search_mark_ == 0) {
+    std::fill(visit_marks_.begin(), visit_marks_.end(), 0);
+    search_mark_ = 1;
+  }
+  search_queue_.clear();
+  search_queue_.push_back(start);
+  visit_marks_[start] = search_mark_;
+  for (std::size_t head = 0; head < search_queue_.size(); ++head) {
+    const uint32_t cell = search_queue_[head];
+    if (frontier_slots_[cell] != kNotInFrontier) {
+      FrontierPath result;
+      result.target = {cell / cols_, cell % cols_};
+      for (uint32_t current = cell; current != start; current = parents_[current]) {
+        const uint32_t parent = parents_[current];
+        if (current + cols_ == parent) {
+          result.moves.push_back(Maze::Move::UP);
+        } else if (parent + cols_ == current) {
+          result.moves.push_back(Maze::Move::DOWN);
+        } else if (current + 1 == parent) {
+          result.moves.push_back(Maze::Move::LEFT);
+        } else {
+          result.moves.push_back(Maze::Move::RIGHT);
+        }
+      }
+      std::reverse(result.moves.begin(), result.moves.end());
+      return result;
+    }
+
+    uint32_t neighbors[4];
+    const uint32_t neighbor_count = getNeighbors(cell, neighbors);
+    for (uint32_t i = 0; i < neighbor_count; ++i) {
+      const uint32_t neighbor = neighbors[i];
+      if (visit_marks_[neighbor] != search_mark_ && isKnownPassable(tiles_[neighbor])) {
+        visit_marks_[neighbor] = search_mark_;
+        parents_[neighbor] = cell;
+        search_queue_.push_back(neighbor);
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+bool BeliefMap::isKnownPassable(Maze::PerceivedTile tile) const {
+  const uint32_t door_colour = getDoorColour(tile);
+  if (door_colour < kKeyColours) {
+    return (keys_ >> door_colour) & 1;
+  }
+  return tile != Maze::PerceivedTile::UNKNOWN && tile != Maze::PerceivedTile::WALL;
+}
+
+uint32_t BeliefMap::getDoorColour(Maze::PerceivedTile tile) {
+  // Tiles below LOCKED_DOOR wrap around to large colours.
+  return static_cast<uint32_t>(tile) - static_cast<uint32_t>(Maze::PerceivedTile::LOCKED_DOOR);
+}
+
+void BeliefMap::refreshFrontier(uint32_t cell) {
+  bool frontier = false;
+  if (isKnownPassable(tiles_[cell])) {
+    uint32_t neighbors[4];
+    const uint32_t neighbor_count = getNeighbors(cell, neighbors);
+    for (uint32_t i = 0; i < neighbor_count && !frontier; ++i) {
+      frontier = tiles_[neighbors[i]] == Maze::PerceivedTile::UNKNOWN;
+    }
+  }
+
+  uint32_t& slot = frontier_slots_[cell];
+  if (frontier && slot == kNotInFrontier) {
+    slot = static_cast<uint32_t>(frontier_.size());
+    frontier_.push_back({cell / cols_, cell % cols_});
+  } else if (!frontier && slot != kNotInFrontier) {
+    // Swap the last frontier cell into the freed slot.
+    const Coordinates last = frontier_.back();
+    frontier_[slot] = last;
+    frontier_slots_[static_cast<std::size_t>(last.row) * cols_ + last.col] = slot;
+    frontier_.pop_back();
+    slot = kNotInFrontier;
+  }
+}
+
+uint32_t BeliefMap::getNeighbors(uint32_t cell, uint32_t (&neighbors)[4]) const {
+  const uint32_t row = cell / cols_;
+  const uint32_t col = cell % cols_;
+  uint32_t count = 0;
+  if (row > 0) {
+    neighbors[count++] = cell - cols_;
+  }
+  if (row + 1 < rows_) {
+    neighbors[count++] = cell + cols_;
+  }
+  if (col > 0) {
+    neighbors[count++] = cell - 1;
+  }
+  if (col + 1 < cols_) {
+    neighbors[count++] = cell + 1;
+  }
+  return count;
+}
+
+}  // namespace maze
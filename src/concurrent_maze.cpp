@@ -0,0 +1,171 @@
+#include <maze/concurrent_maze.hpp>
+
+// Standard
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace maze {
+
+namespace {
+
+/**
+ * @brief Returns the reader slot the calling thread tries first, spreading threads over slots.
+ * @return A per-thread slot hint, to be reduced modulo the slot count.
+ */
+uint32_t slotHint() {
+  static std::atomic<uint32_t> next_thread(0);
+  thread_local const uint32_t hint = next_thread.fetch_add(1, std::memory_order_relaxed);
+  return hint;
+}
+
+constexpr std::size_t kMaxSpareVersions = 2; /**< Reclaimed versions kept for recycling. */
+
+} // namespace
+
+ConcurrentMaze::ReadGuard::ReadGuard(ReaderSlot* slot, const Version* version)
+  : slot_(slot), version_(version) {
+}
+
+ConcurrentMaze::ReadGuard::ReadGuard(ReadGuard&& other) noexcept
+  : slot_(other.slot_), version_(other.version_) {
+  other.slot_ = nullptr;
+}
+
+ConcurrentMaze::ReadGuard& ConcurrentMaze::ReadGuard::operator=(ReadGuard&& other) noexcept {
+  if (this != &other) {
+    if (slot_) {
+      slot_->epoch.store(kIdle, std::memory_order_release);
+    }
+    slot_ = other.slot_;
+    version_ = other.version_;
+    other.slot_ = nullptr;
+  }
+  return *this;
+}
+
+ConcurrentMaze::ReadGuard::~ReadGuard() {
+  if (slot_) {
+    slot_->epoch.store(kIdle, std::memory_order_release);
+  }
+}
+
+const Maze& ConcurrentMaze::ReadGuard::operator*() const {
+  return version_->maze;
+}
+
+const Maze* ConcurrentMaze::ReadGuard::operator->() const {
+  return &version_->maze;
+}
+
+uint64_t ConcurrentMaze::ReadGuard::getVersion() const {
+  return version_->number;
+}
+
+ConcurrentMaze::ConcurrentMaze(const Maze& maze, uint32_t reader_slots)
+  : maze_(maze), slot_count_(reader_slots), current_(nullptr), epoch_(0) {
+  if (reader_slots == 0) {
+    throw std::invalid_argument("A concurrent maze needs at least one reader slot.");
+  }
+  slots_ = std::make_unique<ReaderSlot[]>(reader_slots);
+  for (uint32_t i = 0; i < reader_slots; ++i) {
+    slots_[i].epoch.store(kIdle, std::memory_order_relaxed);
+  }
+  current_.store(new Version{maze_, 0}, std::memory_order_release);
+}
+
+ConcurrentMaze::~ConcurrentMaze() {
+  for (const Retired& retired : retired_) {
+    delete retired.version;
+  }
+  delete current_.load(std::memory_order_acquire);
+}
+
+ConcurrentMaze::ReadGuard ConcurrentMaze::read() const {
+  // The epoch is announced before the version is loaded. Both are sequentially consistent with the
+  // exchange and the epoch update in publish(), so a reader that still loads a replaced version
+  // has announced an epoch no later than the one the version was retired in.
+  const uint32_t first = slotHint() % slot_count_;
+  for (uint32_t attempt = 0;; ++attempt) {
+    ReaderSlot& slot = slots_[(first + attempt) % slot_count_];
+    uint64_t idle = kIdle;
+    if (slot.epoch.load(std::memory_order_relaxed) == kIdle
+        && slot.epoch.compare_exchange_strong(idle, epoch_.load())) {
+      return ReadGuard(&slot, current_.load());
+    }
+    if (attempt > 0 && attempt % slot_count_ == 0) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+bool ConcurrentMaze::movePlayer(Maze::Move move) {
+  if (!maze_.movePlayer(move)) {
+    return false;
+  }
+  publish();
+  return true;
+}
+
+void ConcurrentMaze::setTileType(uint32_t row, uint32_t col, TileType type, uint8_t value) {
+  maze_.setTileType(row, col, type, value);
+  publish();
+}
+
+void ConcurrentMaze::update(const std::function<void(Maze&)>& changes) {
+  changes(maze_);
+  publish();
+}
+
+const Maze& ConcurrentMaze::getWriterMaze() const {
+  return maze_;
+}
+
+uint64_t ConcurrentMaze::getVersion() const {
+  return current_.load(std::memory_order_relaxed)->number;
+}
+
+std::size_t ConcurrentMaze::getRetiredCount() const {
+  return retired_.size();
+}
+
+void ConcurrentMaze::publish() {
+  const uint64_t number = current_.load(std::memory_order_relaxed)->number + 1;
+  Version* next;
+  if (spare_.empty()) {
+    next = new Version{maze_, number};
+  } else {
+    // Copying into a reclaimed version reuses its chunk tables. The cells themselves are shared
+    // with the writer maze until it changes them.
+    next = spare_.back().release();
+    spare_.pop_back();
+    next->maze = maze_;
+    next->number = number;
+  }
+
+  Version* replaced = current_.exchange(next);
+  retired_.push_back({replaced, epoch_.load()});
+  epoch_.fetch_add(1);
+  reclaim();
+}
+
+void ConcurrentMaze::reclaim() {
+  uint64_t oldest = kIdle;
+  for (uint32_t i = 0; i < slot_count_; ++i) {
+    oldest = std::min(oldest, slots_[i].epoch.load());
+  }
+
+  // Versions are retired in epoch order, so the reclaimable ones form a prefix.
+  std::size_t reclaimed = 0;
+  while (reclaimed < retired_.size() && retired_[reclaimed].epoch < oldest) {
+    std::unique_ptr<Version> version(retired_[reclaimed].version);
+    if (spare_.size() < kMaxSpareVersions) {
+      spare_.push_back(std::move(version));
+    }
+    ++reclaimed;
+  }
+  retired_.erase(retired_.begin(), retired_.begin() + static_cast<std::ptrdiff_t>(reclaimed));
+}
+
+}  // namespace maze
@@ -0,0 +1,347 @@
+#include <maze/connectivity.hpp>
+
+// Standard
+#include <algorithm>
+
+namespace maze {
+
+namespace {
+constexpr uint32_t kDirections = 4;
+
+uint32_t getOpposite(uint32_t direction) {
+  return direction ^ 1;
+}
+} // namespace
+
+DynamicConnectivity::DynamicConnectivity(const Grid& grid)
+  : rows_(grid.getRows()), cols_(grid.getCols()),
+    open_(static_cast<std::size_t>(rows_) * cols_, false),
+    nodes_(static_cast<std::size_t>(rows_) * cols_),
+    edge_nodes_(static_cast<std::size_t>(rows_) * cols_ * kDirections, kNil), random_(0) {
+  const uint32_t cell_count = rows_ * cols_;
+  for (uint32_t cell = 0; cell < cell_count; ++cell) {
+    open_[cell] = isPassable(grid.get(cell / cols_, cell % cols_).type);
+    nodes_[cell].priority = static_cast<uint32_t>(random_());
+    nodes_[cell].cells = 1;
+  }
+
+  // Write the Euler tour of a depth-first spanning tree per component, then build its treap in
+  // linear time as the Cartesian tree of the priorities.
+  struct Frame {
+    uint32_t cell;
+    uint32_t next_direction;
+    uint32_t from_direction;
+  };
+  std::vector<bool> visited(cell_count, false);
+  std::vector<Frame> stack;
+  std::vector<uint32_t> tour;
+  std::vector<uint32_t> spine;
+  for (uint32_t source = 0; source < cell_count; ++source) {
+    if (!open_[source] || visited[source]) {
+      continue;
+    }
+    visited[source] = true;
+    tour.assign(1, source);
+    stack.push_back({source, 0, kNil});
+    while (!stack.empty()) {
+      Frame& top = stack.back();
+      if (top.next_direction < kDirections) {
+        const uint32_t cell = top.cell;
+        const uint32_t direction = top.next_direction++;
+        const uint32_t neighbor = getNeighbor(cell, direction);
+        if (neighbor != kNil && open_[neighbor] && !visited[neighbor]) {
+          visited[neighbor] = true;
+          edge_nodes_[cell * kDirections + direction] = allocateEdgeNode();
+          tour.push_back(edge_nodes_[cell * kDirections + direction]);
+          tour.push_back(neighbor);
+          stack.push_back({neighbor, 0, direction});
+        }
+        continue;
+      }
+      if (top.from_direction != kNil) {
+        const uint32_t back = getOpposite(top.from_direction);
+        edge_nodes_[top.cell * kDirections + back] = allocateEdgeNode();
+        tour.push_back(edge_nodes_[top.cell * kDirections + back]);
+      }
+      stack.pop_back();
+    }
+
+    spine.clear();
+    for (const uint32_t node : tour) {
+      uint32_t last = kNil;
+      while (!spine.empty() && nodes_[spine.back()].priority < nodes_[node].priority) {
+        last = spine.back();
+        spine.pop_back();
+      }
+      nodes_[node].left = last;
+      if (last != kNil) {
+        nodes_[last].parent = node;
+      }
+      if (!spine.empty()) {
+        nodes_[spine.back()].right = node;
+        nodes_[node].parent = spine.back();
+      }
+      spine.push_back(node);
+    }
+    // Children come after their parents in breadth-first order, so the reverse updates them first.
+    std::vector<uint32_t> order;
+    order.reserve(tour.size());
+    order.push_back(spine.front());
+    for (std::size_t index = 0; index < order.size(); ++index) {
+      if (nodes_[order[index]].left != kNil) {
+        order.push_back(nodes_[order[index]].left);
+      }
+      if (nodes_[order[index]].right != kNil) {
+        order.push_back(nodes_[order[index]].right);
+      }
+    }
+    for (auto node = order.rbegin(); node != order.rend(); ++node) {
+      update(*node);
+    }
+  }
+}
+
+bool DynamicConnectivity::isOpen(const Coordinates& pos) const {
+  return open_[pos.row * cols_ + pos.col];
+}
+
+void DynamicConnectivity::setOpen(const Coordinates& pos, bool open) {
+  const uint32_t cell = pos.row * cols_ + pos.col;
+  if (open_[cell] == open) {
+    return;
+  }
+  open_[cell] = open;
+
+  if (open) {
+    for (uint32_t direction = 0; direction < kDirections; ++direction) {
+      const uint32_t neighbor = getNeighbor(cell, direction);
+      if (neighbor != kNil && open_[neighbor] && findRoot(neighbor) != findRoot(cell)) {
+        link(cell, direction);
+      }
+    }
+    return;
+  }
+
+  // Cut the cell off, then join the pieces its tree fell into through replacement edges.
+  std::vector<uint32_t> pieces;
+  for (uint32_t direction = 0; direction < kDirections; ++direction) {
+    if (edge_nodes_[cell * kDirections + direction] != kNil) {
+      pieces.push_back(getNeighbor(cell, direction));
+      cut(cell, direction);
+    }
+  }
+  std::vector<uint32_t> cells;
+  while (pieces.size() > 1) {
+    const auto smallest = std::min_element(
+        pieces.begin(), pieces.end(), [&](uint32_t lhs, uint32_t rhs) {
+          return getCells(findRoot(lhs)) < getCells(findRoot(rhs));
+        });
+    const uint32_t root = findRoot(*smallest);
+    cells.clear();
+    collectCells(root, cells);
+    bool joined = false;
+    for (std::size_t index = 0; index < cells.size() && !joined; ++index) {
+      for (uint32_t direction = 0; direction < kDirections; ++direction) {
+        const uint32_t neighbor = getNeighbor(cells[index], direction);
+        if (neighbor != kNil && open_[neighbor] && findRoot(neighbor) != root) {
+          link(cells[index], direction);
+          joined = true;
+          break;
+        }
+      }
+    }
+    // Either the piece joined one of the others, or it is a component of its own now.
+    pieces.erase(smallest);
+  }
+}
+
+bool DynamicConnectivity::isConnected(const Coordinates& a, const Coordinates& b) const {
+  const uint32_t first = a.row * cols_ + a.col;
+  const uint32_t second = b.row * cols_ + b.col;
+  return open_[first] && open_[second] && findRoot(first) == findRoot(second);
+}
+
+uint32_t DynamicConnectivity::getComponentSize(const Coordinates& pos) const {
+  const uint32_t cell = pos.row * cols_ + pos.col;
+  return open_[cell] ? getCells(findRoot(cell)) : 0;
+}
+
+void DynamicConnectivity::update(uint32_t node) {
+  Node& current = nodes_[node];
+  current.size = 1 + getSize(current.left) + getSize(current.right);
+  current.cells = (node < open_.size() ? 1 : 0) + getCells(current.left) + getCells(current.right);
+}
+
+uint32_t DynamicConnectivity::merge(uint32_t left, uint32_t right) {
+  if (left == kNil) {
+    return right;
+  }
+  if (right == kNil) {
+    return left;
+  }
+  if (nodes_[left].priority > nodes_[right].priority) {
+    const uint32_t child = merge(nodes_[left].right, right);
+    nodes_[left].right = child;
+    nodes_[child].parent = left;
+    update(left);
+    return left;
+  }
+  const uint32_t child = merge(left, nodes_[right].left);
+  nodes_[right].left = child;
+  nodes_[child].parent = right;
+  update(right);
+  return right;
+}
+
+void DynamicConnectivity::split(uint32_t root, uint32_t count, uint32_t& left, uint32_t& right) {
+  if (root == kNil) {
+    left = kNil;
+    right = kNil;
+    return;
+  }
+  const uint32_t left_size = getSize(nodes_[root].left);
+  if (count <= left_size) {
+    uint32_t inner = kNil;
+    split(nodes_[root].left, count, left, inner);
+    nodes_[root].left = inner;
+    if (inner != kNil) {
+      nodes_[inner].parent = root;
+    }
+    right = root;
+  } else {
+    uint32_t inner = kNil;
+    split(nodes_[root].right, count - left_size - 1, inner, right);
+    nodes_[root].right = inner;
+    if (inner != kNil) {
+      nodes_[inner].parent = root;
+    }
+    left = root;
+  }
+  update(root);
+  if (left != kNil) {
+    nodes_[left].parent = kNil;
+  }
+  if (right != kNil) {
+    nodes_[right].parent = kNil;
+  }
+}
+
+uint32_t DynamicConnectivity::findRoot(uint32_t node) const {
+  while (nodes_[node].parent != kNil) {
+    node = nodes_[node].parent;
+  }
+  return node;
+}
+
+uint32_t DynamicConnectivity::getPosition(uint32_t node) const {
+  uint32_t position = getSize(nodes_[node].left);
+  for (uint32_t parent = nodes_[node].parent; parent != kNil;
+       node = parent, parent = nodes_[node].parent) {
+    if (nodes_[parent].right == node) {
+      position += getSize(nodes_[parent].left) + 1;
+    }
+  }
+  return position;
+}
+
+uint32_t DynamicConnectivity::reroot(uint32_t cell) {
+  uint32_t before = kNil;
+  uint32_t after = kNil;
+  split(findRoot(cell), getPosition(cell), before, after);
+  return merge(after, before);
+}
+
+void DynamicConnectivity::link(uint32_t cell, uint32_t direction) {
+  const uint32_t neighbor = getNeighbor(cell, direction);
+  const uint32_t first = reroot(cell);
+  const uint32_t second = reroot(neighbor);
+  const uint32_t forward = allocateEdgeNode();
+  const uint32_t backward = allocateEdgeNode();
+  edge_nodes_[cell * kDirections + direction] = forward;
+  edge_nodes_[neighbor * kDirections + getOpposite(direction)] = backward;
+  const uint32_t root = merge(merge(merge(first, forward), second), backward);
+  nodes_[root].parent = kNil;
+}
+
+void DynamicConnectivity::cut(uint32_t cell, uint32_t direction) {
+  const uint32_t neighbor = getNeighbor(cell, direction);
+  uint32_t first = edge_nodes_[cell * kDirections + direction];
+  uint32_t second = edge_nodes_[neighbor * kDirections + getOpposite(direction)];
+  uint32_t first_position = getPosition(first);
+  uint32_t second_position = getPosition(second);
+  if (first_position > second_position) {
+    std::swap(first, second);
+    std::swap(first_position, second_position);
+  }
+
+  // The tour reads before, first, inside, second, after. The subtree is inside, the rest is the
+  // other tree.
+  uint32_t before = kNil;
+  uint32_t rest = kNil;
+  split(findRoot(first), first_position, before, rest);
+  uint32_t edge = kNil;
+  split(rest, 1, edge, rest);
+  uint32_t inside = kNil;
+  split(rest, second_position - first_position - 1, inside, rest);
+  uint32_t after = kNil;
+  split(rest, 1, edge, after);
+  const uint32_t root = merge(before, after);
+  if (root != kNil) {
+    nodes_[root].parent = kNil;
+  }
+
+  edge_nodes_[cell * kDirections + direction] = kNil;
+  edge_nodes_[neighbor * kDirections + getOpposite(direction)] = kNil;
+  free_nodes_.push_back(first);
+  free_nodes_.push_back(second);
+}
+
+uint32_t DynamicConnectivity::getNeighbor(uint32_t cell, uint32_t direction) const {
+  const uint32_t row = cell / cols_;
+  const uint32_t col = cell % cols_;
+  switch (direction) {
+  case 0:
+    return row > 0 ? cell - cols_ : kNil;
+  case 1:
+    return row + 1 < rows_ ? cell + cols_ : kNil;
+  case 2:
+    return col > 0 ? cell - 1 : kNil;
+  default:
+    return col + 1 < cols_ ? cell + 1 : kNil;
+  }
+}
+
+uint32_t DynamicConnectivity::allocateEdgeNode() {
+  uint32_t node = static_cast<uint32_t>(nodes_.size());
+  if (!free_nodes_.empty()) {
+    node = free_nodes_.back();
+    free_nodes_.pop_back();
+    nodes_[node] = Node();
+  } else {
+    nodes_.emplace_back();
+  }
+  nodes_[node].priority = static_cast<uint32_t>(random_());
+  return node;
+}
+
+void DynamicConnectivity::collectCells(uint32_t root, std::vector<uint32_t>& cells) const {
+  std::vector<uint32_t> stack = {root};
+  while (!stack.empty()) {
+    const uint32_t node = stack.back();
+    stack.pop_back();
+    if (getCells(node) == 0) {
+      continue;
+    }
+    if (node < open_.size()) {
+      cells.push_back(node);
+    }
+    if (nodes_[node].left != kNil) {
+      stack.push_back(nodes_[node].left);
+    }
+    if (nodes_[node].right != kNil) {
+      stack.push_back(nodes_[node].right);
+    }
+  }
+}
+
+}  // namespace maze
@@ -0,0 +1,249 @@
+#include <maze/eller_generator.hpp>
+
+// Standard
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+
+// Private
+#include <maze/random.hpp>
+
+namespace maze {
+
+namespace {
+uint32_t findSet(std::vector<uint32_t>& parents, uint32_t element) {
+  while (parents[element] != element) {
+    parents[element] = parents[parents[element]];
+    element = parents[element];
+  }
+  return element;
+}
+} // namespace
+
+EllerGenerator::EllerGenerator(uint32_t rows, uint32_t cols, double difficulty, uint64_t seed,
+                               const PlacementOptions& placement)
+  : rows_(rows), cols_(cols), difficulty_(difficulty), seed_(seed), placement_(placement) {
+  if (rows < 3 || cols < 3) {
+    throw std::invalid_argument("A generated maze needs at least three rows and columns.");
+  }
+
+  // Start and end are drawn from the border cells next to a room, without listing them.
+  const uint64_t room_rows = (rows_ - 1) / 2;
+  const uint64_t room_cols = (cols_ - 1) / 2;
+  const uint64_t candidates = room_cols + (rows_ % 2 == 1 ? room_cols : 0)
+                              + room_rows + (cols_ % 2 == 1 ? room_rows : 0);
+  RandomGenerator rng = RandomGenerator::forStream(seed_, 0);
+  const uint64_t start_index = rng.below(candidates);
+  uint64_t end_index = rng.below(candidates - 1);
+  if (end_index >= start_index) {
+    end_index++;
+  }
+  start_pos_ = getBorderCandidate(start_index);
+  end_pos_ = getBorderCandidate(end_index);
+}
+
+void EllerGenerator::generate(const RowCallback& emit) const {
+  const uint32_t room_rows = (rows_ - 1) / 2;
+  const uint32_t room_cols = (cols_ - 1) / 2;
+  RandomGenerator rng(seed_);
+
+  // Place the item counts of generateMaze. The number of open cells in a perfect maze is known up
+  // front: every room plus one passage per spanning tree edge.
+  const double interior = static_cast<double>(rows_ - 2) * (cols_ - 2);
+  const uint32_t numWallsToAdd = static_cast<uint32_t>(
+      placement_.wall_density ? *placement_.wall_density * interior : difficulty_ * interior / 5);
+  const uint32_t numFoodItems = static_cast<uint32_t>(
+      placement_.food_density ? *placement_.food_density * interior
+                              : (1 - difficulty_) * interior / 5);
+  const uint32_t numDoors = static_cast<uint32_t>(
+      placement_.door_density ? *placement_.door_density * interior
+                              : difficulty_ * (rows_ + cols_) / 4);
+  const uint32_t numMud = static_cast<uint32_t>(placement_.mud_density * interior);
+  const uint32_t numWater = static_cast<uint32_t>(placement_.water_density * interior);
+  // Keep the rooms behind start and end open, so that both lead into the maze.
+  const auto inward = [&](const Coordinates& pos) -> Coordinates {
+    if (pos.row == 0) {
+      return {1, pos.col};
+    } else if (pos.row == rows_ - 1) {
+      return {rows_ - 2, pos.col};
+    } else if (pos.col == 0) {
+      return {pos.row, 1};
+    }
+    return {pos.row, cols_ - 2};
+  };
+  const Coordinates start_inward = inward(start_pos_);
+  const Coordinates end_inward = inward(end_pos_);
+
+  // Selection sampling: each eligible cell takes an item with the probability of the remaining
+  // items among the remaining cells, in the order generateMaze places them. Like there, later
+  // items get fewer cells, or none, in crowded mazes.
+  uint64_t remaining_cells =
+      2ull * room_rows * room_cols - 1 - (start_inward == end_inward ? 1 : 2);
+  uint64_t remaining[] = {numWallsToAdd, numFoodItems, numDoors, numMud, numWater};
+  uint64_t wanted = 0;
+  for (uint64_t& count : remaining) {
+    count = std::min(count, remaining_cells - wanted);
+    wanted += count;
+  }
+  const Cell items[] = {{TileType::WALL, 0},
+                        {TileType::FOOD, 0},
+                        {TileType::DOOR, 0},
+                        {TileType::MUD, placement_.mud_cost},
+                        {TileType::WATER, placement_.water_cost}};
+
+  std::vector<Cell> cells(cols_);
+  const auto finishRow = [&](uint32_t row) {
+    if (row > 0 && row < rows_ - 1) {
+      for (uint32_t col = 1; col < cols_ - 1; ++col) {
+        const Coordinates pos{row, col};
+        if (cells[col].type != TileType::EMPTY || pos == start_inward || pos == end_inward) {
+          continue;
+        }
+        uint64_t pick = rng.below(remaining_cells--);
+        for (std::size_t item = 0; item < std::size(items); ++item) {
+          if (pick < remaining[item]) {
+            remaining[item]--;
+            cells[col] = items[item];
+            if (items[item].type == TileType::FOOD) {
+              cells[col].value = static_cast<uint8_t>(10 + rng.below(11));
+            }
+            break;
+          }
+          pick -= remaining[item];
+        }
+      }
+    }
+    if (start_pos_.row == row) {
+      cells[start_pos_.col] = {TileType::EMPTY, 0};
+    }
+    if (end_pos_.row == row) {
+      cells[end_pos_.col] = {TileType::EMPTY, 0};
+    }
+    emit(row, cells);
+  };
+
+  std::fill(cells.begin(), cells.end(), Cell{TileType::WALL, 0});
+  finishRow(0);
+
+  // Set labels of the rooms in the current row. Labels are kept below room_cols between rows.
+  std::vector<uint32_t> labels(room_cols);
+  std::iota(labels.begin(), labels.end(), 0);
+  std::vector<uint32_t> parents(room_cols);
+  std::vector<uint32_t> members(room_cols);
+  std::vector<uint32_t> chosen(room_cols);
+  std::vector<bool> has_down(room_cols);
+  std::vector<bool> down(room_cols);
+  std::vector<uint32_t> remap(room_cols);
+
+  for (uint32_t room_row = 0; room_row < room_rows; ++room_row) {
+    const bool is_last_row = room_row + 1 == room_rows;
+
+    // Join neighbouring rooms of different sets at random, and all of them in the last row.
+    std::iota(parents.begin(), parents.end(), 0);
+    std::fill(cells.begin(), cells.end(), Cell{TileType::WALL, 0});
+    for (uint32_t room_col = 0; room_col < room_cols; ++room_col) {
+      cells[2 * room_col + 1] = {TileType::EMPTY, 0};
+      if (room_col + 1 == room_cols) {
+        break;
+      }
+      const uint32_t left = findSet(parents, labels[room_col]);
+      const uint32_t right = findSet(parents, labels[room_col + 1]);
+      if (left != right && (is_last_row || (rng() & 1) != 0)) {
+        parents[right] = left;
+        cells[2 * room_col + 2] = {TileType::EMPTY, 0};
+      }
+    }
+    for (uint32_t& label : labels) {
+      label = findSet(parents, label);
+    }
+    finishRow(2 * room_row + 1);
+
+    if (is_last_row) {
+      break;
+    }
+
+    // Every set continues downwards through at least one of its rooms.
+    std::fill(members.begin(), members.end(), 0);
+    std::fill(has_down.begin(), has_down.end(), false);
+    for (uint32_t room_col = 0; room_col < room_cols; ++room_col) {
+      const uint32_t label = labels[room_col];
+      down[room_col] = (rng() & 1) != 0;
+      has_down[label] = has_down[label] || down[room_col];
+      members[label]++;
+      if (rng.below(members[label]) == 0) {
+        chosen[label] = room_col;
+      }
+    }
+    std::fill(cells.begin(), cells.end(), Cell{TileType::WALL, 0});
+    for (uint32_t room_col = 0; room_col < room_cols; ++room_col) {
+      const uint32_t label = labels[room_col];
+      if (!has_down[label] && chosen[label] == room_col) {
+        down[room_col] = true;
+      }
+      if (down[room_col]) {
+        cells[2 * room_col + 1] = {TileType::EMPTY, 0};
+      }
+    }
+    finishRow(2 * room_row + 2);
+
+    // Rooms below a passage keep their set, all others start a new one.
+    std::fill(remap.begin(), remap.end(), room_cols);
+    uint32_t next_label = 0;
+    for (uint32_t room_col = 0; room_col < room_cols; ++room_col) {
+      if (down[room_col] && remap[labels[room_col]] == room_cols) {
+        remap[labels[room_col]] = next_label++;
+      }
+    }
+    for (uint32_t room_col = 0; room_col < room_cols; ++room_col) {
+      labels[room_col] = down[room_col] ? remap[labels[room_col]] : next_label++;
+    }
+  }
+
+  // Rows below the last room row are solid walls.
+  for (uint32_t row = 2 * room_rows; row < rows_; ++row) {
+    std::fill(cells.begin(), cells.end(), Cell{TileType::WALL, 0});
+    finishRow(row);
+  }
+}
+
+void EllerGenerator::generate(Grid& grid) const {
+  if (grid.getRows() != rows_ || grid.getCols() != cols_) {
+    throw std::invalid_argument("The grid needs to have the dimensions of the maze.");
+  }
+  generate([&grid](uint32_t row, const std::vector<Cell>& cells) {
+    for (uint32_t col = 0; col < cells.size(); ++col) {
+      grid.set(row, col, cells[col]);
+    }
+  });
+}
+
+Coordinates EllerGenerator::getStartPosition() const {
+  return start_pos_;
+}
+
+Coordinates EllerGenerator::getEndPosition() const {
+  return end_pos_;
+}
+
+Coordinates EllerGenerator::getBorderCandidate(uint64_t index) const {
+  const uint32_t room_rows = (rows_ - 1) / 2;
+  const uint32_t room_cols = (cols_ - 1) / 2;
+  if (index < room_cols) {
+    return {0, static_cast<uint32_t>(2 * index + 1)};
+  }
+  index -= room_cols;
+  if (rows_ % 2 == 1) {
+    if (index < room_cols) {
+      return {rows_ - 1, static_cast<uint32_t>(2 * index + 1)};
+    }
+    index -= room_cols;
+  }
+  if (index < room_rows) {
+    return {static_cast<uint32_t>(2 * index + 1), 0};
+  }
+  index -= room_rows;
+  return {static_cast<uint32_t>(2 * index + 1), cols_ - 1};
+}
+
+}  // namespace maze
@@ -0,0 +1,46 @@
+#include <maze/fitness.hpp>
+
+// Standard
+#include <limits>
+
+// Private
+#include <maze/game_state.hpp>
+#include <maze/parallel.hpp>
+#include <maze/parallel_bfs.hpp>
+
+namespace maze {
+
+std::vector<CandidateFitness> evaluateCandidates(
+    const Maze& maze, const std::vector<std::vector<Maze::Move>>& candidates, uint32_t threads) {
+  const uint32_t cols = maze.getCols();
+  const Layout layout(maze);
+  // Every door counts as open for the distance estimate, keys may be collected on the way.
+  const std::vector<uint32_t> distances =
+      breadthFirstDistances(maze.getGrid(), maze.getEndPosition(),
+                            std::numeric_limits<uint16_t>::max(), threads);
+
+  std::vector<CandidateFitness> results(candidates.size());
+  parallelFor(candidates.size(), threads, [&](std::size_t index) {
+    CandidateFitness& fitness = results[index];
+    visitInitialState(layout, [&](auto state) {
+      for (const Maze::Move move : candidates[index]) {
+        if (isTerminal(layout, state)) {
+          break;
+        }
+        ++fitness.steps_survived;
+        applyMove(layout, state, move);
+      }
+
+      fitness.food_collected = state.getEatenCount();
+      fitness.food = state.food;
+      fitness.reached_goal = state.position == layout.getEndPosition();
+      const uint32_t distance = distances[state.position.row * cols + state.position.col];
+      if (distance != kUnreachable) {
+        fitness.distance_to_goal = distance;
+      }
+    });
+  });
+  return results;
+}
+
+}  // namespace maze
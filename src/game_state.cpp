@@ -0,0 +1,42 @@
+#include <maze/game_state.hpp>
+
+// Standard
+#include <algorithm>
+
+namespace maze {
+
+Layout::Layout(const Maze& maze)
+  : grid_(maze.getGrid()), end_pos_(maze.getEndPosition()),
+    initial_position_(maze.getPlayerPosition()), initial_food_(maze.getPlayerCurrentFood()),
+    initial_keys_(maze.getPlayerKeys()) {
+  for (uint32_t row = 0; row < grid_.getRows(); ++row) {
+    for (uint32_t col = 0; col < grid_.getCols(); ++col) {
+      if (grid_.get(row, col).type == TileType::FOOD) {
+        food_cells_.push_back(static_cast<uint64_t>(row) * grid_.getCols() + col);
+      }
+    }
+  }
+}
+
+int32_t Layout::getFoodIndex(const Coordinates& pos) const {
+  const uint64_t cell = static_cast<uint64_t>(pos.row) * grid_.getCols() + pos.col;
+  const auto it = std::lower_bound(food_cells_.begin(), food_cells_.end(), cell);
+  if (it == food_cells_.end() || *it != cell) {
+    return -1;
+  }
+  return static_cast<int32_t>(it - food_cells_.begin());
+}
+
+uint32_t Layout::getFoodCount() const {
+  return static_cast<uint32_t>(food_cells_.size());
+}
+
+const Grid& Layout::getGrid() const {
+  return grid_;
+}
+
+Coordinates Layout::getEndPosition() const {
+  return end_pos_;
+}
+
+}  // namespace maze
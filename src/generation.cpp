@@ -0,0 +1,305 @@
+#include <maze/generation.hpp>
+
+// Standard
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// Private
+#include <maze/parallel.hpp>
+#include <maze/random.hpp>
+
+namespace maze {
+
+namespace {
+/**
+ * @brief A candidate opening between two neighbouring regions.
+ */
+struct RegionEdge {
+  uint32_t first; /**< The index of the region above or to the left. */
+  uint32_t second; /**< The index of the region below or to the right. */
+  uint32_t row; /**< The grid row of the wall cell to open. */
+  uint32_t col; /**< The grid column of the wall cell to open. */
+};
+
+/**
+ * @brief Union-find over room or region indices, with path halving and union by size.
+ */
+class DisjointSets {
+ public:
+  explicit DisjointSets(std::size_t count) : parents_(count), sizes_(count, 1) {
+    std::iota(parents_.begin(), parents_.end(), 0);
+  }
+
+  std::size_t find(std::size_t element) {
+    while (parents_[element] != element) {
+      parents_[element] = parents_[parents_[element]];
+      element = parents_[element];
+    }
+    return element;
+  }
+
+  bool unite(std::size_t first, std::size_t second) {
+    first = find(first);
+    second = find(second);
+    if (first == second) {
+      return false;
+    }
+    if (sizes_[first] < sizes_[second]) {
+      std::swap(first, second);
+    }
+    parents_[second] = first;
+    sizes_[first] += sizes_[second];
+    return true;
+  }
+
+ private:
+  std::vector<std::size_t> parents_;
+  std::vector<std::size_t> sizes_;
+};
+
+void openRoom(Grid& grid, const RoomRegion& region, uint32_t room) {
+  grid.set(2 * (region.first_row + room / region.cols) + 1,
+           2 * (region.first_col + room % region.cols) + 1, {TileType::EMPTY, 0});
+}
+
+void openPassage(Grid& grid, const RoomRegion& region, uint32_t room, uint32_t neighbor) {
+  grid.set(2 * region.first_row + room / region.cols + neighbor / region.cols + 1,
+           2 * region.first_col + room % region.cols + neighbor % region.cols + 1,
+           {TileType::EMPTY, 0});
+}
+
+uint32_t getNeighborRooms(const RoomRegion& region, uint32_t room, uint32_t (&neighbors)[4]) {
+  const uint32_t room_row = room / region.cols;
+  const uint32_t room_col = room % region.cols;
+  uint32_t count = 0;
+  if (room_row > 0) {
+    neighbors[count++] = room - region.cols;
+  }
+  if (room_row + 1 < region.rows) {
+    neighbors[count++] = room + region.cols;
+  }
+  if (room_col > 0) {
+    neighbors[count++] = room - 1;
+  }
+  if (room_col + 1 < region.cols) {
+    neighbors[count++] = room + 1;
+  }
+  return count;
+}
+
+class RecursiveBacktrackerCarver : public Carver {
+ public:
+  void carve(Grid& grid, const RoomRegion& region, RandomGenerator& rng) const override {
+    // Depth-first search with an explicit stack, so that huge regions cannot overflow the call
+    // stack.
+    std::vector<bool> visited(static_cast<std::size_t>(region.rows) * region.cols, false);
+    std::vector<uint32_t> stack;
+    const uint32_t first_room = static_cast<uint32_t>(rng.below(visited.size()));
+    stack.push_back(first_room);
+    visited[first_room] = true;
+    openRoom(grid, region, first_room);
+    while (!stack.empty()) {
+      const uint32_t room = stack.back();
+      uint32_t neighbors[4];
+      uint32_t candidates[4];
+      uint32_t candidate_count = 0;
+      const uint32_t neighbor_count = getNeighborRooms(region, room, neighbors);
+      for (uint32_t i = 0; i < neighbor_count; ++i) {
+        if (!visited[neighbors[i]]) {
+          candidates[candidate_count++] = neighbors[i];
+        }
+      }
+
+      if (candidate_count == 0) {
+        stack.pop_back();
+        continue;
+      }
+
+      // Remove the wall between the rooms and continue from the neighbour.
+      const uint32_t next = candidates[rng.below(candidate_count)];
+      openPassage(grid, region, room, next);
+      openRoom(grid, region, next);
+      visited[next] = true;
+      stack.push_back(next);
+    }
+  }
+};
+
+class KruskalCarver : public Carver {
+ public:
+  void carve(Grid& grid, const RoomRegion& region, RandomGenerator& rng) const override {
+    const uint32_t room_count = region.rows * region.cols;
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    edges.reserve(2 * static_cast<std::size_t>(room_count));
+    for (uint32_t room = 0; room < room_count; ++room) {
+      openRoom(grid, region, room);
+      if (room % region.cols + 1 < region.cols) {
+        edges.push_back({room, room + 1});
+      }
+      if (room / region.cols + 1 < region.rows) {
+        edges.push_back({room, room + region.cols});
+      }
+    }
+
+    // Join rooms along the shuffled edges unless they are connected already.
+    for (std::size_t i = edges.size(); i > 1; --i) {
+      std::swap(edges[i - 1], edges[rng.below(i)]);
+    }
+    DisjointSets rooms(room_count);
+    for (const auto& [room, neighbor] : edges) {
+      if (rooms.unite(room, neighbor)) {
+        openPassage(grid, region, room, neighbor);
+      }
+    }
+  }
+};
+
+class PrimCarver : public Carver {
+ public:
+  void carve(Grid& grid, const RoomRegion& region, RandomGenerator& rng) const override {
+    std::vector<bool> visited(static_cast<std::size_t>(region.rows) * region.cols, false);
+    std::vector<std::pair<uint32_t, uint32_t>> frontier;
+    const auto visit = [&](uint32_t room) {
+      visited[room] = true;
+      openRoom(grid, region, room);
+      uint32_t neighbors[4];
+      const uint32_t neighbor_count = getNeighborRooms(region, room, neighbors);
+      for (uint32_t i = 0; i < neighbor_count; ++i) {
+        if (!visited[neighbors[i]]) {
+          frontier.push_back({room, neighbors[i]});
+        }
+      }
+    };
+
+    // Grow the tree by a random frontier edge at a time.
+    visit(static_cast<uint32_t>(rng.below(visited.size())));
+    while (!frontier.empty()) {
+      const std::size_t index = rng.below(frontier.size());
+      const auto [room, neighbor] = frontier[index];
+      frontier[index] = frontier.back();
+      frontier.pop_back();
+      if (!visited[neighbor]) {
+        openPassage(grid, region, room, neighbor);
+        visit(neighbor);
+      }
+    }
+  }
+};
+
+class WilsonCarver : public Carver {
+ public:
+  void carve(Grid& grid, const RoomRegion& region, RandomGenerator& rng) const override {
+    const uint32_t room_count = region.rows * region.cols;
+    std::vector<bool> in_tree(room_count, false);
+    std::vector<uint32_t> next(room_count);
+    const uint32_t root = static_cast<uint32_t>(rng.below(room_count));
+    in_tree[root] = true;
+    openRoom(grid, region, root);
+
+    for (uint32_t start = 0; start < room_count; ++start) {
+      // Walk randomly until the tree is hit. Overwriting the exit of each room erases loops.
+      uint32_t room = start;
+      while (!in_tree[room]) {
+        uint32_t neighbors[4];
+        const uint32_t neighbor_count = getNeighborRooms(region, room, neighbors);
+        next[room] = neighbors[rng.below(neighbor_count)];
+        room = next[room];
+      }
+
+      // Add the loop-erased walk to the tree.
+      for (room = start; !in_tree[room]; room = next[room]) {
+        in_tree[room] = true;
+        openRoom(grid, region, room);
+        openPassage(grid, region, room, next[room]);
+      }
+    }
+  }
+};
+} // namespace
+
+std::unique_ptr<Carver> makeCarver(GenerationAlgorithm algorithm) {
+  switch (algorithm) {
+  case GenerationAlgorithm::KRUSKAL:
+    return std::make_unique<KruskalCarver>();
+  case GenerationAlgorithm::PRIM:
+    return std::make_unique<PrimCarver>();
+  case GenerationAlgorithm::WILSON:
+    return std::make_unique<WilsonCarver>();
+  case GenerationAlgorithm::RECURSIVE_BACKTRACKER:
+  default:
+    return std::make_unique<RecursiveBacktrackerCarver>();
+  }
+}
+
+void carvePerfectMaze(Grid& grid, uint64_t seed, const GenerationOptions& options) {
+  grid.fill({TileType::WALL, 0});
+
+  const uint32_t room_rows = grid.getRows() >= 3 ? (grid.getRows() - 1) / 2 : 0;
+  const uint32_t room_cols = grid.getCols() >= 3 ? (grid.getCols() - 1) / 2 : 0;
+  if (room_rows == 0 || room_cols == 0) {
+    return;
+  }
+
+  // Split the rooms into regions. The split only depends on the region size, which keeps the
+  // result independent of the number of threads.
+  const uint32_t region_rooms = options.region_size == 0
+                                    ? std::max(room_rows, room_cols)
+                                    : std::max<uint32_t>(options.region_size / 2, 1);
+  const uint32_t region_rows = (room_rows + region_rooms - 1) / region_rooms;
+  const uint32_t region_cols = (room_cols + region_rooms - 1) / region_rooms;
+  const auto getRegion = [&](uint32_t index) {
+    RoomRegion region;
+    region.first_row = (index / region_cols) * region_rooms;
+    region.first_col = (index % region_cols) * region_rooms;
+    region.rows = std::min(region_rooms, room_rows - region.first_row);
+    region.cols = std::min(region_rooms, room_cols - region.first_col);
+    return region;
+  };
+
+  std::shared_ptr<const Carver> carver = options.carver;
+  if (!carver) {
+    carver = makeCarver(options.algorithm);
+  }
+
+  const uint32_t region_count = region_rows * region_cols;
+  parallelFor(region_count, options.threads, [&](std::size_t index) {
+    RandomGenerator region_rng = RandomGenerator::forStream(seed, index + 1);
+    carver->carve(grid, getRegion(static_cast<uint32_t>(index)), region_rng);
+  });
+
+  if (region_count == 1) {
+    return;
+  }
+
+  // Pick one random opening on the border between each pair of neighbouring regions.
+  RandomGenerator rng = RandomGenerator::forStream(seed, 0);
+  std::vector<RegionEdge> edges;
+  for (uint32_t index = 0; index < region_count; ++index) {
+    const RoomRegion region = getRegion(index);
+    if (index % region_cols + 1 < region_cols) {
+      const uint32_t room_row = region.first_row + static_cast<uint32_t>(rng.below(region.rows));
+      const uint32_t room_col = region.first_col + region.cols - 1;
+      edges.push_back({index, index + 1, 2 * room_row + 1, 2 * room_col + 2});
+    }
+    if (index / region_cols + 1 < region_rows) {
+      const uint32_t room_row = region.first_row + region.rows - 1;
+      const uint32_t room_col = region.first_col + static_cast<uint32_t>(rng.below(region.cols));
+      edges.push_back({index, index + region_cols, 2 * room_row + 2, 2 * room_col + 1});
+    }
+  }
+
+  // Randomized Kruskal over the region graph keeps the joined maze free of loops.
+  for (std::size_t i = edges.size() - 1; i > 0; --i) {
+    std::swap(edges[i], edges[rng.below(i + 1)]);
+  }
+  DisjointSets regions(region_count);
+  for (const RegionEdge& edge : edges) {
+    if (regions.unite(edge.first, edge.second)) {
+      grid.set(edge.row, edge.col, {TileType::EMPTY, 0});
+    }
+  }
+}
+
+}  // namespace maze
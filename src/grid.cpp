@@ -0,0 +1,247 @@
+#include <maze/grid.hpp>
+
+// Standard
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// POSIX
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAZE_HAS_MMAP 1
+#endif
+
+namespace maze {
+
+std::shared_ptr<Tile> makeTile(const Cell& cell) {
+  // Stateless tiles are shared, only food, keys, locked doors and terrain carry a value.
+  static const std::shared_ptr<Tile> empty_tile = std::make_shared<EmptyTile>();
+  static const std::shared_ptr<Tile> wall_tile = std::make_shared<WallTile>();
+  static const std::shared_ptr<Tile> door_tile = std::make_shared<DoorTile>();
+
+  switch (cell.type) {
+  case TileType::WALL:
+    return wall_tile;
+  case TileType::DOOR:
+    return cell.value == 0 ? door_tile : std::make_shared<DoorTile>(cell.value - 1u);
+  case TileType::KEY:
+    return std::make_shared<KeyTile>(cell.value - 1u);
+  case TileType::MUD:
+    return std::make_shared<MudTile>(getMoveCost(cell));
+  case TileType::WATER:
+    return std::make_shared<WaterTile>(getMoveCost(cell));
+  case TileType::FOOD:
+    return std::make_shared<FoodTile>(cell.value);
+  case TileType::EMPTY:
+  default:
+    return empty_tile;
+  }
+}
+
+Grid::Grid()
+  : rows_(0), cols_(0), layout_(GridLayout::ROW_MAJOR), blocks_per_row_(0), size_(0),
+    mapping_(nullptr), file_descriptor_(-1) {
+}
+
+Grid::Grid(uint32_t rows, uint32_t cols, const GridStorage& storage)
+  : rows_(rows), cols_(cols), layout_(storage.layout), blocks_per_row_(0), size_(0),
+    mapping_(nullptr), file_descriptor_(-1) {
+  allocate(storage.file_path, storage.open_existing);
+}
+
+Grid::Grid(const Grid& other)
+  : rows_(0), cols_(0), layout_(GridLayout::ROW_MAJOR), blocks_per_row_(0), size_(0),
+    mapping_(nullptr), file_descriptor_(-1) {
+  share(other);
+}
+
+Grid::Grid(Grid&& other) noexcept
+  : rows_(other.rows_), cols_(other.cols_), layout_(other.layout_),
+    blocks_per_row_(other.blocks_per_row_), size_(other.size_),
+    chunks_(std::move(other.chunks_)), owned_(std::move(other.owned_)),
+    mapping_(other.mapping_), file_descriptor_(other.file_descriptor_) {
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.size_ = 0;
+  other.chunks_.clear();
+  other.owned_.clear();
+  other.mapping_ = nullptr;
+  other.file_descriptor_ = -1;
+}
+
+Grid& Grid::operator=(const Grid& other) {
+  if (this != &other) {
+    // Releasing first cannot free chunks of the other grid, it holds references of its own.
+    release();
+    share(other);
+  }
+  return *this;
+}
+
+Grid& Grid::operator=(Grid&& other) noexcept {
+  if (this != &other) {
+    release();
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    layout_ = other.layout_;
+    blocks_per_row_ = other.blocks_per_row_;
+    size_ = other.size_;
+    chunks_.swap(other.chunks_);
+    owned_.swap(other.owned_);
+    mapping_ = other.mapping_;
+    file_descriptor_ = other.file_descriptor_;
+
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.size_ = 0;
+    other.mapping_ = nullptr;
+    other.file_descriptor_ = -1;
+  }
+  return *this;
+}
+
+Grid::~Grid() {
+  release();
+}
+
+void Grid::fill(Cell cell) {
+  for (std::size_t chunk = 0; chunk < chunks_.size(); ++chunk) {
+    Cell* cells = writableChunk(chunk);
+    std::fill(cells, cells + std::min<std::size_t>(kChunkSize, size_ - (chunk << kChunkBits)),
+              cell);
+  }
+}
+
+void Grid::flush() {
+#ifdef MAZE_HAS_MMAP
+  if (mapping_ != nullptr) {
+    msync(mapping_, size_ * sizeof(Cell), MS_SYNC);
+  }
+#endif
+}
+
+Cell* Grid::unshare(std::size_t chunk) {
+  Chunk* copy = new Chunk;
+  copy->references.store(1, std::memory_order_relaxed);
+  std::copy(owned_[chunk]->cells, owned_[chunk]->cells + kChunkSize, copy->cells);
+  releaseChunk(owned_[chunk]);
+  owned_[chunk] = copy;
+  chunks_[chunk] = copy->cells;
+  return copy->cells;
+}
+
+void Grid::share(const Grid& other) {
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  layout_ = other.layout_;
+  if (other.mapping_ != nullptr) {
+    allocate("");
+    for (std::size_t chunk = 0; chunk < chunks_.size(); ++chunk) {
+      const Cell* cells = other.chunks_[chunk];
+      std::copy(cells, cells + std::min<std::size_t>(kChunkSize, size_ - (chunk << kChunkBits)),
+                chunks_[chunk]);
+    }
+    return;
+  }
+
+  blocks_per_row_ = other.blocks_per_row_;
+  size_ = other.size_;
+  chunks_ = other.chunks_;
+  owned_ = other.owned_;
+  for (Chunk* chunk : owned_) {
+    chunk->references.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void Grid::releaseChunk(Chunk* chunk) {
+  if (chunk->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete chunk;
+  }
+}
+
+void Grid::allocate(const std::string& file_path, bool open_existing) {
+  if (layout_ == GridLayout::ROW_MAJOR) {
+    size_ = static_cast<std::size_t>(rows_) * cols_;
+  } else {
+    // Pad the grid to whole blocks.
+    blocks_per_row_ = (static_cast<std::size_t>(cols_) + kBlockSize - 1) >> kBlockBits;
+    const std::size_t block_rows = (static_cast<std::size_t>(rows_) + kBlockSize - 1) >> kBlockBits;
+    size_ = (block_rows * blocks_per_row_) << (2 * kBlockBits);
+  }
+  const std::size_t chunk_count = (size_ + kChunkSize - 1) >> kChunkBits;
+  chunks_.reserve(chunk_count);
+
+  if (file_path.empty() || size_ == 0) {
+    owned_.reserve(chunk_count);
+    try {
+      for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        owned_.push_back(new Chunk);
+        owned_.back()->references.store(1, std::memory_order_relaxed);
+        std::fill(owned_.back()->cells, owned_.back()->cells + kChunkSize,
+                  Cell{TileType::EMPTY, 0});
+        chunks_.push_back(owned_.back()->cells);
+      }
+    } catch (...) {
+      release();
+      throw;
+    }
+    return;
+  }
+
+#ifdef MAZE_HAS_MMAP
+  const std::size_t bytes = size_ * sizeof(Cell);
+  file_descriptor_ = open(file_path.c_str(), open_existing ? O_RDWR : O_RDWR | O_CREAT | O_TRUNC,
+                          0644);
+  if (file_descriptor_ < 0) {
+    throw std::runtime_error("Failed to open grid file: " + file_path);
+  }
+  // A freshly truncated file reads as zeros, which is an empty tile in every cell.
+  if (open_existing) {
+    struct stat status;
+    if (fstat(file_descriptor_, &status) != 0 || static_cast<std::size_t>(status.st_size) != bytes) {
+      close(file_descriptor_);
+      file_descriptor_ = -1;
+      throw std::runtime_error("The grid file does not match the size of the grid: " + file_path);
+    }
+  } else if (ftruncate(file_descriptor_, static_cast<off_t>(bytes)) != 0) {
+    close(file_descriptor_);
+    file_descriptor_ = -1;
+    throw std::runtime_error("Failed to resize grid file: " + file_path);
+  }
+  void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor_, 0);
+  if (mapping == MAP_FAILED) {
+    close(file_descriptor_);
+    file_descriptor_ = -1;
+    throw std::runtime_error("Failed to map grid file: " + file_path);
+  }
+  mapping_ = mapping;
+  for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+    chunks_.push_back(static_cast<Cell*>(mapping_) + (chunk << kChunkBits));
+  }
+#else
+  throw std::runtime_error("Memory-mapped grids are not supported on this platform.");
+#endif
+}
+
+void Grid::release() {
+#ifdef MAZE_HAS_MMAP
+  if (mapping_ != nullptr) {
+    munmap(mapping_, size_ * sizeof(Cell));
+    close(file_descriptor_);
+  }
+#endif
+  mapping_ = nullptr;
+  file_descriptor_ = -1;
+  for (Chunk* chunk : owned_) {
+    releaseChunk(chunk);
+  }
+  // The vectors keep their capacity, so a grid assigned over and over does not reallocate them.
+  owned_.clear();
+  chunks_.clear();
+  size_ = 0;
+}
+
+}  // namespace maze
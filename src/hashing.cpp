@@ -0,0 +1,55 @@
+#include <maze/hashing.hpp>
+
+// Private
+#include <maze/random.hpp>
+
+namespace maze {
+
+namespace {
+constexpr uint64_t kCellSalt = 0x6A09E667F3BCC908ull;
+constexpr uint64_t kStartSalt = 0xBB67AE8584CAA73Bull;
+constexpr uint64_t kEndSalt = 0x3C6EF372FE94F82Bull;
+constexpr uint64_t kPlayerSalt = 0xA54FF53A5F1D36F1ull;
+constexpr uint64_t kFoodSalt = 0x510E527FADE682D1ull;
+constexpr uint64_t kSizeSalt = 0x9B05688C2B3E6C1Full;
+
+uint64_t positionKey(uint64_t salt, const Coordinates& pos) {
+  return splitMix64(salt ^ splitMix64((static_cast<uint64_t>(pos.row) << 32) | pos.col));
+}
+} // namespace
+
+uint64_t zobristCellKey(const Coordinates& pos, const Cell& cell) {
+  if (cell.type == TileType::EMPTY) {
+    return 0;
+  }
+  const uint64_t contents = (static_cast<uint64_t>(cell.type) << 8) | cell.value;
+  return splitMix64(positionKey(kCellSalt, pos) ^ contents);
+}
+
+uint64_t zobristStartKey(const Coordinates& pos) {
+  return positionKey(kStartSalt, pos);
+}
+
+uint64_t zobristEndKey(const Coordinates& pos) {
+  return positionKey(kEndSalt, pos);
+}
+
+uint64_t zobristPlayerKey(const Coordinates& pos) {
+  return positionKey(kPlayerSalt, pos);
+}
+
+uint64_t zobristFoodKey(uint32_t food) {
+  return splitMix64(kFoodSalt ^ food);
+}
+
+uint64_t hashLayout(const Grid& grid, const Coordinates& start, const Coordinates& end) {
+  uint64_t hash = positionKey(kSizeSalt, {grid.getRows(), grid.getCols()});
+  for (uint32_t row = 0; row < grid.getRows(); ++row) {
+    for (uint32_t col = 0; col < grid.getCols(); ++col) {
+      hash ^= zobristCellKey({row, col}, grid.get(row, col));
+    }
+  }
+  return hash ^ zobristStartKey(start) ^ zobristEndKey(end);
+}
+
+}  // namespace maze
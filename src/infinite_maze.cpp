@@ -0,0 +1,292 @@
+#include <maze/infinite_maze.hpp>
+
+// Standard
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+// Private
+#include <maze/random.hpp>
+
+namespace maze {
+
+namespace {
+int64_t floorDivide(int64_t value, int64_t divisor) {
+  const int64_t quotient = value / divisor;
+  return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+}
+
+int64_t squaredDistance(int64_t x1, int64_t y1, int64_t x2, int64_t y2) {
+  const int64_t deltaX = x2 - x1;
+  const int64_t deltaY = y2 - y1;
+  return deltaX * deltaX + deltaY * deltaY;
+}
+} // namespace
+
+std::size_t InfiniteMaze::ChunkHash::operator()(const WorldCoordinates& chunk) const {
+  return static_cast<std::size_t>(
+      splitMix64(static_cast<uint64_t>(chunk.row) ^ splitMix64(static_cast<uint64_t>(chunk.col))));
+}
+
+InfiniteMaze::InfiniteMaze(uint64_t seed, double difficulty, uint32_t chunk_size,
+                           uint32_t keep_radius)
+  : seed_(seed), difficulty_(difficulty), chunk_size_(chunk_size), keep_radius_(keep_radius) {
+  if (chunk_size < 4 || chunk_size % 2 != 0) {
+    throw std::invalid_argument("The chunk size needs to be even and at least 4.");
+  }
+}
+
+std::size_t InfiniteMaze::addPlayer() {
+  // Every player spawns in the first room of the chunk at the world origin.
+  players_.emplace_back(Maze::kMaxFood);
+  player_positions_.push_back({1, 1});
+  return players_.size() - 1;
+}
+
+std::size_t InfiniteMaze::getPlayerCount() const {
+  return players_.size();
+}
+
+bool InfiniteMaze::movePlayer(std::size_t player, Maze::Move move) {
+  WorldCoordinates newPos = player_positions_.at(player);
+  switch (move) {
+  case Maze::Move::LEFT:
+    newPos.col--;
+    break;
+  case Maze::Move::RIGHT:
+    newPos.col++;
+    break;
+  case Maze::Move::UP:
+    newPos.row--;
+    break;
+  case Maze::Move::DOWN:
+    newPos.row++;
+    break;
+  }
+
+  const Cell cell = getCell(newPos.row, newPos.col);
+  if (!isPassable(cell.type)) {
+    return false;
+  }
+
+  if (cell.type == TileType::FOOD) {
+    players_[player].pickFood(cell.value);
+    const WorldCoordinates chunk = chunkOf(newPos);
+    getChunk(chunk).set(static_cast<uint32_t>(newPos.row - chunk.row * chunk_size_),
+                        static_cast<uint32_t>(newPos.col - chunk.col * chunk_size_),
+                        {TileType::EMPTY, 0});
+  }
+
+  player_positions_[player] = newPos;
+  players_[player].consumeFood(getMoveCost(cell));
+  evictChunks();
+  return true;
+}
+
+WorldCoordinates InfiniteMaze::getPlayerPosition(std::size_t player) const {
+  return player_positions_.at(player);
+}
+
+uint32_t InfiniteMaze::getPlayerCurrentFood(std::size_t player) const {
+  return players_.at(player).getCurrentFood();
+}
+
+Cell InfiniteMaze::getCell(int64_t row, int64_t col) {
+  const WorldCoordinates chunk = chunkOf({row, col});
+  return getChunk(chunk).get(static_cast<uint32_t>(row - chunk.row * chunk_size_),
+                             static_cast<uint32_t>(col - chunk.col * chunk_size_));
+}
+
+std::vector<std::vector<Maze::PerceivedTile>> InfiniteMaze::perceiveTiles(std::size_t player,
+                                                                          uint32_t radius) {
+  const WorldCoordinates center = player_positions_.at(player);
+  const uint32_t vector_size = radius * 2 + 1;
+  std::vector<std::vector<Maze::PerceivedTile>> perceived_rows(
+      vector_size, std::vector<Maze::PerceivedTile>(vector_size, Maze::PerceivedTile::UNKNOWN));
+
+  const int64_t squaredRadius = static_cast<int64_t>(radius) * radius;
+  for (int64_t rel_row = 0; rel_row < vector_size; ++rel_row) {
+    for (int64_t rel_col = 0; rel_col < vector_size; ++rel_col) {
+      const WorldCoordinates target{center.row - radius + rel_row, center.col - radius + rel_col};
+      if (squaredDistance(center.col, center.row, target.col, target.row) > squaredRadius) {
+        continue;
+      }
+
+      if (!lineOfSight(center, target)) {
+        continue;
+      }
+
+      perceived_rows[rel_row][rel_col] = Maze::perceivedCell(getCell(target.row, target.col));
+    }
+  }
+
+  evictChunks();
+  return perceived_rows;
+}
+
+std::size_t InfiniteMaze::getLoadedChunkCount() const {
+  return chunks_.size();
+}
+
+Grid& InfiniteMaze::getChunk(const WorldCoordinates& chunk) {
+  auto iterator = chunks_.find(chunk);
+  if (iterator == chunks_.end()) {
+    iterator = chunks_.emplace(chunk, generateChunk(chunk)).first;
+  }
+  return iterator->second;
+}
+
+Grid InfiniteMaze::generateChunk(const WorldCoordinates& chunk) const {
+  const uint32_t size = chunk_size_;
+  const uint32_t rooms = size / 2;
+  RandomGenerator rng = RandomGenerator::forStream(
+      seed_, static_cast<uint64_t>(chunk.row) ^ splitMix64(static_cast<uint64_t>(chunk.col)));
+
+  Grid cells(size, size);
+  cells.fill({TileType::WALL, 0});
+
+  // Carve a perfect maze through the rooms at odd local coordinates, using an explicit stack.
+  std::vector<bool> visited(static_cast<std::size_t>(rooms) * rooms, false);
+  std::vector<uint32_t> stack;
+  const uint32_t first_room = static_cast<uint32_t>(rng.below(visited.size()));
+  stack.push_back(first_room);
+  visited[first_room] = true;
+  cells.set(2 * (first_room / rooms) + 1, 2 * (first_room % rooms) + 1, {TileType::EMPTY, 0});
+  while (!stack.empty()) {
+    const uint32_t room = stack.back();
+    const uint32_t room_row = room / rooms;
+    const uint32_t room_col = room % rooms;
+
+    uint32_t candidates[4];
+    uint32_t candidate_count = 0;
+    if (room_row > 0 && !visited[room - rooms]) {
+      candidates[candidate_count++] = room - rooms;
+    }
+    if (room_row + 1 < rooms && !visited[room + rooms]) {
+      candidates[candidate_count++] = room + rooms;
+    }
+    if (room_col > 0 && !visited[room - 1]) {
+      candidates[candidate_count++] = room - 1;
+    }
+    if (room_col + 1 < rooms && !visited[room + 1]) {
+      candidates[candidate_count++] = room + 1;
+    }
+
+    if (candidate_count == 0) {
+      stack.pop_back();
+      continue;
+    }
+
+    const uint32_t next = candidates[rng.below(candidate_count)];
+    const uint32_t next_row = next / rooms;
+    const uint32_t next_col = next % rooms;
+    cells.set(room_row + next_row + 1, room_col + next_col + 1, {TileType::EMPTY, 0});
+    cells.set(2 * next_row + 1, 2 * next_col + 1, {TileType::EMPTY, 0});
+    visited[next] = true;
+    stack.push_back(next);
+  }
+
+  // Open the border towards the chunk above and the chunk to the left. The chunks below and to
+  // the right open towards this one on their own, so every chunk joins its neighbours.
+  const uint32_t top_openings = 1 + static_cast<uint32_t>(rng.below(2));
+  for (uint32_t i = 0; i < top_openings; ++i) {
+    cells.set(0, 2 * static_cast<uint32_t>(rng.below(rooms)) + 1, {TileType::EMPTY, 0});
+  }
+  const uint32_t left_openings = 1 + static_cast<uint32_t>(rng.below(2));
+  for (uint32_t i = 0; i < left_openings; ++i) {
+    cells.set(2 * static_cast<uint32_t>(rng.below(rooms)) + 1, 0, {TileType::EMPTY, 0});
+  }
+
+  // Scatter walls, food and doors like generateMaze does, but keep the spawn cell free.
+  const bool is_spawn_chunk = chunk.row == 0 && chunk.col == 0;
+  const auto isFree = [&](uint32_t row, uint32_t col) {
+    return cells.get(row, col).type == TileType::EMPTY &&
+           !(is_spawn_chunk && row == 1 && col == 1);
+  };
+  const uint32_t interior = size - 1;
+  const uint32_t numWallsToAdd = static_cast<uint32_t>(difficulty_ * interior * interior / 5);
+  for (uint32_t i = 0; i < numWallsToAdd; i++) {
+    const uint32_t row = 1 + static_cast<uint32_t>(rng.below(interior));
+    const uint32_t col = 1 + static_cast<uint32_t>(rng.below(interior));
+    if (isFree(row, col)) {
+      cells.set(row, col, {TileType::WALL, 0});
+    }
+  }
+
+  const uint32_t numFoodItems = static_cast<uint32_t>((1 - difficulty_) * interior * interior / 5);
+  for (uint32_t i = 0; i < numFoodItems; i++) {
+    const uint32_t row = 1 + static_cast<uint32_t>(rng.below(interior));
+    const uint32_t col = 1 + static_cast<uint32_t>(rng.below(interior));
+    if (isFree(row, col)) {
+      cells.set(row, col, {TileType::FOOD, static_cast<uint8_t>(10 + rng.below(11))});
+    }
+  }
+
+  const uint32_t numDoors = static_cast<uint32_t>(difficulty_ * (size + size) / 4);
+  for (uint32_t i = 0; i < numDoors; i++) {
+    const uint32_t row = 1 + static_cast<uint32_t>(rng.below(interior));
+    const uint32_t col = 1 + static_cast<uint32_t>(rng.below(interior));
+    if (isFree(row, col)) {
+      cells.set(row, col, {TileType::DOOR, 0});
+    }
+  }
+
+  return cells;
+}
+
+void InfiniteMaze::evictChunks() {
+  std::vector<WorldCoordinates> player_chunks;
+  player_chunks.reserve(player_positions_.size());
+  for (const WorldCoordinates& position : player_positions_) {
+    player_chunks.push_back(chunkOf(position));
+  }
+
+  const int64_t keep_radius = keep_radius_;
+  for (auto iterator = chunks_.begin(); iterator != chunks_.end();) {
+    const WorldCoordinates& chunk = iterator->first;
+    const bool is_near = std::any_of(player_chunks.begin(), player_chunks.end(),
+                                     [&](const WorldCoordinates& player_chunk) {
+                                       return std::abs(chunk.row - player_chunk.row) <= keep_radius &&
+                                              std::abs(chunk.col - player_chunk.col) <= keep_radius;
+                                     });
+    if (is_near) {
+      ++iterator;
+    } else {
+      iterator = chunks_.erase(iterator);
+    }
+  }
+}
+
+WorldCoordinates InfiniteMaze::chunkOf(const WorldCoordinates& position) const {
+  return {floorDivide(position.row, chunk_size_), floorDivide(position.col, chunk_size_)};
+}
+
+bool InfiniteMaze::lineOfSight(const WorldCoordinates& from, const WorldCoordinates& to) {
+  int64_t x = from.col;
+  int64_t y = from.row;
+  const int64_t diffX = std::abs(to.col - x);
+  const int64_t diffY = std::abs(to.row - y);
+  const int64_t stepX = (x < to.col) ? 1 : -1;
+  const int64_t stepY = (y < to.row) ? 1 : -1;
+  int64_t error = diffX - diffY;
+
+  while (x != to.col || y != to.row) {
+    if (getCell(y, x).type == TileType::WALL) {
+      return false;
+    }
+
+    const int64_t error2 = error * 2;
+    if (error2 > -diffY) {
+      error -= diffY;
+      x += stepX;
+    }
+    if (error2 < diffX) {
+      error += diffX;
+      y += stepY;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace maze
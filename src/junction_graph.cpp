@@ -0,0 +1,263 @@
+#include <maze/junction_graph.hpp>
+
+// Standard
+#include <algorithm>
+
+// Private
+#include <maze/radix_heap.hpp>
+
+namespace maze {
+
+namespace {
+constexpr Maze::Move kMoves[] = {Maze::Move::LEFT, Maze::Move::RIGHT, Maze::Move::UP,
+                                 Maze::Move::DOWN};
+
+Maze::Move getOpposite(Maze::Move move) {
+  switch (move) {
+  case Maze::Move::LEFT:
+    return Maze::Move::RIGHT;
+  case Maze::Move::RIGHT:
+    return Maze::Move::LEFT;
+  case Maze::Move::UP:
+    return Maze::Move::DOWN;
+  case Maze::Move::DOWN:
+    break;
+  }
+  return Maze::Move::UP;
+}
+
+/**
+ * @brief Returns the neighbour of a cell in a direction.
+ * @param grid The grid the cell is in.
+ * @param cell The row-major index of the cell.
+ * @param move The direction.
+ * @return The row-major index of the neighbour, or the cell count if it lies outside the grid.
+ */
+uint32_t getNeighbor(const Grid& grid, uint32_t cell, Maze::Move move) {
+  const uint32_t cols = grid.getCols();
+  const uint32_t cells = grid.getRows() * cols;
+  switch (move) {
+  case Maze::Move::LEFT:
+    return cell % cols > 0 ? cell - 1 : cells;
+  case Maze::Move::RIGHT:
+    return cell % cols + 1 < cols ? cell + 1 : cells;
+  case Maze::Move::UP:
+    return cell >= cols ? cell - cols : cells;
+  case Maze::Move::DOWN:
+    break;
+  }
+  return cell + cols < cells ? cell + cols : cells;
+}
+
+bool isOpen(const Grid& grid, uint32_t cell) {
+  const uint32_t cols = grid.getCols();
+  return cell < grid.getRows() * cols && isPassable(grid.get(cell / cols, cell % cols).type);
+}
+
+uint32_t getFoodGain(const Cell& tile) {
+  return tile.type == TileType::FOOD ? tile.value : 0;
+}
+} // namespace
+
+JunctionGraph::JunctionGraph(const Grid& grid, const Coordinates& start, const Coordinates& end)
+  : rows_(grid.getRows()), cols_(grid.getCols()),
+    node_of_cell_(static_cast<std::size_t>(rows_) * cols_, kNone) {
+  const uint32_t cells = rows_ * cols_;
+  for (uint32_t cell = 0; cell < cells; ++cell) {
+    if (!isOpen(grid, cell)) {
+      continue;
+    }
+    const Cell tile = grid.get(cell / cols_, cell % cols_);
+    uint32_t degree = 0;
+    for (const Maze::Move move : kMoves) {
+      degree += isOpen(grid, getNeighbor(grid, cell, move));
+    }
+    const Coordinates pos = {cell / cols_, cell % cols_};
+    if (degree != 2 || tile.type == TileType::FOOD || tile.type == TileType::KEY
+        || tile.type == TileType::DOOR || pos == start || pos == end) {
+      node_of_cell_[cell] = static_cast<uint32_t>(nodes_.size());
+      nodes_.push_back({cell, tile});
+    }
+  }
+  end_node_ = node_of_cell_[end.row * cols_ + end.col];
+
+  // Walk every corridor from both of its ends, then pair the two directions up.
+  std::vector<Maze::Move> last_directions;
+  offsets_.reserve(nodes_.size() + 1);
+  for (const Node& node : nodes_) {
+    offsets_.push_back(static_cast<uint32_t>(edges_.size()));
+    for (const Maze::Move move : kMoves) {
+      if (!isOpen(grid, getNeighbor(grid, node.cell, move))) {
+        continue;
+      }
+      const Walk corridor = walk(grid, node.cell, move, nullptr);
+      edges_.push_back({corridor.node, corridor.length, corridor.cost, kNone, move});
+      last_directions.push_back(corridor.last_direction);
+    }
+  }
+  offsets_.push_back(static_cast<uint32_t>(edges_.size()));
+  for (uint32_t edge = 0; edge < edges_.size(); ++edge) {
+    const Maze::Move back = getOpposite(last_directions[edge]);
+    const uint32_t target = edges_[edge].target;
+    for (uint32_t other = offsets_[target]; other < offsets_[target + 1]; ++other) {
+      if (edges_[other].direction == back) {
+        edges_[edge].reverse = other;
+      }
+    }
+  }
+}
+
+bool JunctionGraph::isNode(const Coordinates& pos) const {
+  return pos.row < rows_ && pos.col < cols_ && node_of_cell_[pos.row * cols_ + pos.col] != kNone;
+}
+
+void JunctionGraph::clearCell(const Coordinates& pos) {
+  if (!isNode(pos)) {
+    return;
+  }
+  const uint32_t cell = pos.row * cols_ + pos.col;
+  const uint32_t node = node_of_cell_[cell];
+  nodes_[node].tile = {TileType::EMPTY, 0};
+  if (offsets_[node + 1] - offsets_[node] != 2 || node == end_node_) {
+    return;
+  }
+  const Edge first = edges_[offsets_[node]];
+  const Edge second = edges_[offsets_[node] + 1];
+  if (first.target == node || second.target == node) {
+    return;
+  }
+
+  // Join the corridors on both sides: the edges leading in now lead through to the other side.
+  const uint32_t into_from_first = first.reverse;
+  const uint32_t into_from_second = second.reverse;
+  Edge& from_first = edges_[into_from_first];
+  Edge& from_second = edges_[into_from_second];
+  from_first = {second.target, from_first.length + second.length, from_first.cost + second.cost,
+                into_from_second, from_first.direction};
+  from_second = {first.target, from_second.length + first.length,
+                 from_second.cost + first.cost, into_from_first, from_second.direction};
+  node_of_cell_[cell] = kNone;
+}
+
+JunctionGraph::Walk JunctionGraph::walk(const Grid& grid, uint32_t cell, Maze::Move direction,
+                                        std::vector<Maze::Move>* moves) const {
+  const uint32_t origin = cell;
+  Walk result = {kNone, 0, 0, direction};
+  for (;;) {
+    cell = getNeighbor(grid, cell, direction);
+    result.length++;
+    result.cost += getMoveCost(grid.get(cell / cols_, cell % cols_));
+    result.last_direction = direction;
+    if (moves) {
+      moves->push_back(direction);
+    }
+    if (node_of_cell_[cell] != kNone) {
+      result.node = node_of_cell_[cell];
+      return result;
+    }
+    if (cell == origin) {
+      return result;
+    }
+    // Inside a corridor exactly one open neighbour is not the way back.
+    const Maze::Move back = getOpposite(direction);
+    for (const Maze::Move move : kMoves) {
+      if (move != back && isOpen(grid, getNeighbor(grid, cell, move))) {
+        direction = move;
+        break;
+      }
+    }
+  }
+}
+
+std::optional<std::vector<Maze::Move>> JunctionGraph::solve(const Grid& grid,
+                                                            const Coordinates& from,
+                                                            uint32_t food, uint16_t keys) const {
+  const std::size_t node_count = nodes_.size();
+  std::vector<uint32_t> moves(node_count, kNone);
+  std::vector<int64_t> foods(node_count, 0);
+  std::vector<uint32_t> parent_edges(node_count, kNone);
+  std::vector<uint32_t> parents(node_count, kNone);
+  std::vector<Maze::Move> seed_directions(node_count, Maze::Move::LEFT);
+  std::vector<bool> settled(node_count, false);
+  RadixHeap<uint32_t> heap;
+
+  // Entering a node along an edge must leave food after every step, counting the food it holds.
+  const auto canEnter = [&](int64_t food_left, uint32_t cost, const Node& target) {
+    const int64_t corridor_cost = cost - getMoveCost(target.tile);
+    return isPassable(target.tile, keys) && food_left - corridor_cost > 0
+           && food_left - cost + getFoodGain(target.tile) > 0;
+  };
+
+  const uint32_t from_cell = from.row * cols_ + from.col;
+  if (node_of_cell_[from_cell] != kNone) {
+    const uint32_t node = node_of_cell_[from_cell];
+    moves[node] = 0;
+    foods[node] = food;
+    heap.push(0, node);
+  } else {
+    // Start from the nodes at both ends of the corridor the position lies in.
+    for (const Maze::Move move : kMoves) {
+      if (!isOpen(grid, getNeighbor(grid, from_cell, move))) {
+        continue;
+      }
+      const Walk corridor = walk(grid, from_cell, move, nullptr);
+      if (corridor.node == kNone || corridor.length >= moves[corridor.node]
+          || !canEnter(food, corridor.cost, nodes_[corridor.node])) {
+        continue;
+      }
+      moves[corridor.node] = corridor.length;
+      foods[corridor.node] =
+          int64_t(food) - corridor.cost + getFoodGain(nodes_[corridor.node].tile);
+      seed_directions[corridor.node] = move;
+      heap.push(corridor.length, corridor.node);
+    }
+  }
+
+  while (!heap.empty()) {
+    const auto [distance, node] = heap.pop();
+    if (settled[node]) {
+      continue;
+    }
+    settled[node] = true;
+    if (node == end_node_) {
+      break;
+    }
+    for (uint32_t edge = offsets_[node]; edge < offsets_[node + 1]; ++edge) {
+      const Edge& corridor = edges_[edge];
+      if (settled[corridor.target]
+          || !canEnter(foods[node], corridor.cost, nodes_[corridor.target])
+          || distance + corridor.length >= moves[corridor.target]) {
+        continue;
+      }
+      moves[corridor.target] = distance + corridor.length;
+      foods[corridor.target] =
+          foods[node] - corridor.cost + getFoodGain(nodes_[corridor.target].tile);
+      parents[corridor.target] = node;
+      parent_edges[corridor.target] = edge;
+      heap.push(moves[corridor.target], corridor.target);
+    }
+  }
+  if (end_node_ == kNone || !settled[end_node_]) {
+    return std::nullopt;
+  }
+
+  // Recover the node sequence, then walk its corridors for the moves.
+  std::vector<uint32_t> path_edges;
+  uint32_t first_node = end_node_;
+  while (parents[first_node] != kNone) {
+    path_edges.push_back(parent_edges[first_node]);
+    first_node = parents[first_node];
+  }
+  std::vector<Maze::Move> path;
+  path.reserve(moves[end_node_]);
+  if (node_of_cell_[from_cell] == kNone) {
+    walk(grid, from_cell, seed_directions[first_node], &path);
+  }
+  for (auto edge = path_edges.rbegin(); edge != path_edges.rend(); ++edge) {
+    const uint32_t source = parents[edges_[*edge].target];
+    walk(grid, nodes_[source].cell, edges_[*edge].direction, &path);
+  }
+  return path;
+}
+
+}  // namespace maze
@@ -0,0 +1,195 @@
+#include <maze/key_solver.hpp>
+
+// Standard
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+
+namespace maze {
+
+namespace {
+constexpr uint32_t kUnreached = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief Breadth-first search over the cells passable with a set of keys.
+ *
+ * Key tiles of colours that are not held end a path, since entering them picks up the key.
+ */
+class LayerSearch {
+ public:
+  explicit LayerSearch(const Maze& maze)
+    : maze_(maze), rows_(maze.getRows()), cols_(maze.getCols()),
+      distances_(static_cast<std::size_t>(rows_) * cols_, kUnreached),
+      parents_(distances_.size()) {
+  }
+
+  void run(uint32_t source, uint16_t keys) {
+    for (const uint32_t cell : queue_) {
+      distances_[cell] = kUnreached;
+    }
+    queue_.clear();
+    distances_[source] = 0;
+    queue_.push_back(source);
+    for (std::size_t head = 0; head < queue_.size(); ++head) {
+      const uint32_t cell = queue_[head];
+      const Cell tile = maze_.getCell(cell / cols_, cell % cols_);
+      if (cell != source && tile.type == TileType::KEY && !((keys >> (tile.value - 1)) & 1)) {
+        continue;
+      }
+      const uint32_t row = cell / cols_;
+      const uint32_t col = cell % cols_;
+      if (row > 0) {
+        visit(cell, cell - cols_, keys);
+      }
+      if (row + 1 < rows_) {
+        visit(cell, cell + cols_, keys);
+      }
+      if (col > 0) {
+        visit(cell, cell - 1, keys);
+      }
+      if (col + 1 < cols_) {
+        visit(cell, cell + 1, keys);
+      }
+    }
+  }
+
+  uint32_t getDistance(uint32_t cell) const {
+    return distances_[cell];
+  }
+
+  void appendMoves(uint32_t source, uint32_t target, std::vector<Maze::Move>& moves) const {
+    std::vector<Maze::Move> segment;
+    for (uint32_t cell = target; cell != source; cell = parents_[cell]) {
+      const uint32_t parent = parents_[cell];
+      if (parent == cell + cols_) {
+        segment.push_back(Maze::Move::UP);
+      } else if (cell == parent + cols_) {
+        segment.push_back(Maze::Move::DOWN);
+      } else if (parent == cell + 1) {
+        segment.push_back(Maze::Move::LEFT);
+      } else {
+        segment.push_back(Maze::Move::RIGHT);
+      }
+    }
+    moves.insert(moves.end(), segment.rbegin(), segment.rend());
+  }
+
+ private:
+  void visit(uint32_t cell, uint32_t next, uint16_t keys) {
+    if (distances_[next] == kUnreached
+        && isPassable(maze_.getCell(next / cols_, next % cols_), keys)) {
+      distances_[next] = distances_[cell] + 1;
+      parents_[next] = cell;
+      queue_.push_back(next);
+    }
+  }
+
+  const Maze& maze_;
+  uint32_t rows_;
+  uint32_t cols_;
+  std::vector<uint32_t> distances_;
+  std::vector<uint32_t> parents_;
+  std::vector<uint32_t> queue_;
+};
+
+/**
+ * @brief A target reachable from a state, with the distance to it.
+ */
+struct Transition {
+  uint32_t target; /**< The index of the target point, the end is the last point. */
+  uint32_t distance; /**< The moves to the target. */
+};
+} // namespace
+
+std::optional<std::vector<Maze::Move>> solveWithKeys(const Maze& maze) {
+  const uint32_t cols = maze.getCols();
+  const auto toCell = [cols](const Coordinates& pos) { return pos.row * cols + pos.col; };
+
+  // The points a path can go between: the player, every key tile and the end.
+  std::vector<uint32_t> points = {toCell(maze.getPlayerPosition())};
+  std::vector<uint16_t> point_keys = {0};
+  for (uint32_t row = 0; row < maze.getRows(); ++row) {
+    for (uint32_t col = 0; col < cols; ++col) {
+      const Cell cell = maze.getCell(row, col);
+      if (cell.type == TileType::KEY) {
+        points.push_back(row * cols + col);
+        point_keys.push_back(static_cast<uint16_t>(1u << (cell.value - 1)));
+      }
+    }
+  }
+  const uint32_t end_point = static_cast<uint32_t>(points.size());
+  points.push_back(toCell(maze.getEndPosition()));
+  point_keys.push_back(0);
+
+  // Dijkstra over (point, keys) states. The transitions of a state are one search in its layer.
+  using State = uint64_t;
+  const auto makeState = [](uint32_t point, uint16_t keys) {
+    return (static_cast<State>(point) << 16) | keys;
+  };
+  LayerSearch search(maze);
+  std::unordered_map<State, std::vector<Transition>> transitions;
+  std::unordered_map<State, std::pair<uint32_t, State>> best;  // Distance and previous state.
+  std::priority_queue<std::pair<uint32_t, State>, std::vector<std::pair<uint32_t, State>>,
+                      std::greater<>> queue;
+
+  const State initial = makeState(0, maze.getPlayerKeys());
+  best[initial] = {0, initial};
+  queue.push({0, initial});
+  std::optional<State> finished;
+  while (!queue.empty()) {
+    const auto [distance, state] = queue.top();
+    queue.pop();
+    if (best[state].first != distance) {
+      continue;
+    }
+    const uint32_t point = static_cast<uint32_t>(state >> 16);
+    const uint16_t keys = static_cast<uint16_t>(state & 0xFFFF);
+    if (point == end_point) {
+      finished = state;
+      break;
+    }
+
+    auto [it, inserted] = transitions.try_emplace(state);
+    if (inserted) {
+      search.run(points[point], keys);
+      for (uint32_t target = 1; target < points.size(); ++target) {
+        const uint32_t target_distance = search.getDistance(points[target]);
+        if (target != point && target_distance != kUnreached && !(point_keys[target] & keys)) {
+          it->second.push_back({target, target_distance});
+        }
+      }
+    }
+    for (const Transition& transition : it->second) {
+      const State next = makeState(transition.target, keys | point_keys[transition.target]);
+      const uint32_t next_distance = distance + transition.distance;
+      const auto found = best.find(next);
+      if (found == best.end() || next_distance < found->second.first) {
+        best[next] = {next_distance, state};
+        queue.push({next_distance, next});
+      }
+    }
+  }
+  if (!finished) {
+    return std::nullopt;
+  }
+
+  // Walk the chain of states back, then replay each leg in its layer.
+  std::vector<State> chain = {*finished};
+  while (chain.back() != initial) {
+    chain.push_back(best[chain.back()].second);
+  }
+  std::reverse(chain.begin(), chain.end());
+  std::vector<Maze::Move> moves;
+  for (std::size_t leg = 0; leg + 1 < chain.size(); ++leg) {
+    const uint32_t source = points[chain[leg] >> 16];
+    const uint32_t target = points[chain[leg + 1] >> 16];
+    search.run(source, static_cast<uint16_t>(chain[leg] & 0xFFFF));
+    search.appendMoves(source, target, moves);
+  }
+  return moves;
+}
+
+}  // namespace maze
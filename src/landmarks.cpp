@@ -0,0 +1,80 @@
+#include <maze/landmarks.hpp>
+
+// Standard
+#include <algorithm>
+#include <limits>
+
+// Private
+#include <maze/maze.hpp>
+#include <maze/parallel.hpp>
+#include <maze/parallel_bfs.hpp>
+
+namespace maze {
+
+LandmarkTable::LandmarkTable(const Maze& maze, uint32_t count, uint32_t threads)
+  : rows_(maze.getRows()), cols_(maze.getCols()) {
+  const std::size_t cells = static_cast<std::size_t>(rows_) * cols_;
+  const uint16_t all_keys = std::numeric_limits<uint16_t>::max();
+
+  // Farthest-point selection: every landmark maximizes the distance to the closest of the start
+  // and the landmarks before it. Each search also yields the distance table of its landmark.
+  std::vector<std::vector<uint32_t>> tables;
+  std::vector<uint32_t> closest =
+      breadthFirstDistances(maze.getGrid(), maze.getStartPosition(), all_keys, threads);
+  while (landmarks_.size() < count) {
+    std::size_t farthest = cells;
+    for (std::size_t cell = 0; cell < cells; ++cell) {
+      if (closest[cell] != kUnreachable && closest[cell] > 0
+          && (farthest == cells || closest[cell] > closest[farthest])) {
+        farthest = cell;
+      }
+    }
+    if (farthest == cells) {
+      break;
+    }
+
+    const Coordinates landmark = {static_cast<uint32_t>(farthest / cols_),
+                                  static_cast<uint32_t>(farthest % cols_)};
+    landmarks_.push_back(landmark);
+    tables.push_back(breadthFirstDistances(maze.getGrid(), landmark, all_keys, threads));
+    const std::vector<uint32_t>& table = tables.back();
+    parallelFor((cells + 4095) / 4096, threads, [&](std::size_t block) {
+      const std::size_t end = std::min(cells, (block + 1) * 4096);
+      for (std::size_t cell = block * 4096; cell < end; ++cell) {
+        closest[cell] = std::min(closest[cell], table[cell]);
+      }
+    });
+  }
+
+  // Interleave the tables, cell by cell.
+  const std::size_t landmark_count = landmarks_.size();
+  distances_.resize(cells * landmark_count);
+  parallelFor(landmark_count, threads, [&](std::size_t landmark) {
+    const std::vector<uint32_t>& table = tables[landmark];
+    for (std::size_t cell = 0; cell < cells; ++cell) {
+      distances_[cell * landmark_count + landmark] = table[cell];
+    }
+  });
+}
+
+uint32_t LandmarkTable::getLowerBound(const Coordinates& from, const Coordinates& to) const {
+  const std::size_t landmark_count = landmarks_.size();
+  if (landmark_count == 0) {
+    return 0;
+  }
+  const uint32_t* const from_distances = &distances_[getCell(from) * landmark_count];
+  const uint32_t* const to_distances = &distances_[getCell(to) * landmark_count];
+  uint32_t bound = 0;
+  for (std::size_t landmark = 0; landmark < landmark_count; ++landmark) {
+    const uint32_t from_distance = from_distances[landmark];
+    const uint32_t to_distance = to_distances[landmark];
+    if (from_distance == kUnreachable || to_distance == kUnreachable) {
+      continue;
+    }
+    bound = std::max(bound, from_distance > to_distance ? from_distance - to_distance
+                                                        : to_distance - from_distance);
+  }
+  return bound;
+}
+
+}  // namespace maze
@@ -6,34 +6,11 @@
 
 // Maze
 #include <maze/maze.hpp>
+#include <maze/renderer.hpp>
 
 void printMaze(const maze::Maze &maze) {
-  const uint32_t rows = maze.getRows();
-  const uint32_t cols = maze.getCols();
-
   std::cout << "Maze:\n";
-  for (uint32_t i = 0; i < rows; i++) {
-    for (uint32_t j = 0; j < cols; j++) {
-      if (maze.isPlayerAt(i, j)) {
-        std::cout << "X";
-      } else if (maze.isStartAt(i, j)) {
-        std::cout << "o";
-      } else if (maze.isEndAt(i, j)) {
-        std::cout << "O";
-      } else if (maze.getTile(i, j)->isPassable()) {
-        if (std::dynamic_pointer_cast<maze::FoodTile>(maze.getTile(i, j))) {
-          std::cout << "F";
-        } else if (std::dynamic_pointer_cast<maze::DoorTile>(maze.getTile(i, j))) {
-          std::cout << "D";
-        } else {
-          std::cout << ".";
-        }
-      } else {
-        std::cout << "#";
-      }
-    }
-    std::cout << "\n";
-  }
+  maze::MazeRenderer(maze).write(std::cout);
   std::cout << "\n";
 }
 
@@ -75,7 +52,7 @@ int main() {
 
   auto path = maze.solve();
   for (const auto &move : path) {
-    std::cout << moveToString(move) << std::endl;
+    std::cout << moveToString(move) << "\n";
   }
 
   for (const auto& move : path) {
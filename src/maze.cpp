@@ -1,8 +1,25 @@
 #include <maze/maze.hpp>
 
 // Standard
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <random>
 #include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// Private
+#include <maze/generation.hpp>
+#include <maze/connectivity.hpp>
+#include <maze/hashing.hpp>
+#include <maze/junction_graph.hpp>
+#include <maze/landmarks.hpp>
+#include <maze/parallel_bfs.hpp>
+#include <maze/placement.hpp>
+#include <maze/solve_cache.hpp>
+#include <maze/visibility.hpp>
 
 namespace maze {
 
@@ -12,16 +29,41 @@ int squaredDistance(int x1, int y1, int x2, int y2) {
   int deltaY = y2 - y1;
   return deltaX * deltaX + deltaY * deltaY;
 }
+
+/**
+ * @brief Checks that the storage of a new maze does not map the cells of an existing file.
+ * @param storage The storage requested for the maze.
+ * @return The storage.
+ * @throws std::invalid_argument If the storage opens an existing file, which the maze would
+ * overwrite.
+ */
+const GridStorage& checkNewStorage(const GridStorage& storage) {
+  if (storage.open_existing) {
+    throw std::invalid_argument("A maze writes all of its cells, so it cannot open an existing "
+                                "grid file without overwriting it.");
+  }
+  return storage;
+}
 } // namespace
 
-Maze::Maze(uint32_t rows, uint32_t cols, double difficulty)
-  : rows_(rows), cols_(cols), player_(100) {
-  grid_.resize(static_cast<std::vector<int>::size_type>(rows) * cols);
-  generateMaze(difficulty);
+Maze::Maze(uint32_t rows, uint32_t cols, double difficulty, const GridStorage& storage)
+  : Maze(rows, cols, difficulty, GenerationOptions(), storage) {
+}
+
+Maze::Maze(uint32_t rows, uint32_t cols, double difficulty, const GenerationOptions& generation,
+           const GridStorage& storage)
+  : rows_(rows), cols_(cols), grid_(rows, cols, checkNewStorage(storage)), player_(kMaxFood),
+    junction_search_(false) {
+  generateMaze(difficulty, generation);
+  initializeHashes();
+  countLockedDoors();
 }
 
-Maze::Maze(const std::vector<std::vector<PerceivedTile>>& maze_layout)
-  : player_(100) {
+Maze::Maze(const std::vector<std::vector<PerceivedTile>>& maze_layout,
+           const GridStorage& storage)
+  : player_(kMaxFood), junction_search_(false) {
+  checkNewStorage(storage);
+
   // Sanity check rows and cols counts.
   const uint32_t rows = maze_layout.size();
   if (rows == 0) {
@@ -40,7 +82,7 @@ Maze::Maze(const std::vector<std::vector<PerceivedTile>>& maze_layout)
   rows_ = rows;
   cols_ = cols;
 
-  grid_.resize(static_cast<std::vector<int>::size_type>(rows) * cols);
+  grid_ = Grid(rows, cols, storage);
   bool has_start = false;
   bool has_end = false;
   uint32_t row = 0;
@@ -51,35 +93,54 @@ Maze::Maze(const std::vector<std::vector<PerceivedTile>>& maze_layout)
       case PerceivedTile::START: {
         start_pos_ = {row, col};
         player_pos_ = start_pos_;
-        grid_[row * cols + col] = std::make_shared<EmptyTile>();
+        grid_.set(row, col, {TileType::EMPTY, 0});
         has_start = true;
       } break;
 
       case PerceivedTile::END: {
         end_pos_ = {row, col};
-        grid_[row * cols + col] = std::make_shared<EmptyTile>();
+        grid_.set(row, col, {TileType::EMPTY, 0});
         has_end = true;
       } break;
 
       case PerceivedTile::WALL: {
-        grid_[row * cols + col] = std::make_shared<WallTile>();
+        grid_.set(row, col, {TileType::WALL, 0});
       } break;
 
       case PerceivedTile::DOOR: {
-        grid_[row * cols + col] = std::make_shared<DoorTile>();
+        grid_.set(row, col, {TileType::DOOR, 0});
       } break;
 
       case PerceivedTile::FOOD: {
-        grid_[row * cols + col] = std::make_shared<FoodTile>(1);
+        grid_.set(row, col, {TileType::FOOD, 1});
+      } break;
+
+      case PerceivedTile::MUD: {
+        grid_.set(row, col, {TileType::MUD, kDefaultMudCost});
+      } break;
+
+      case PerceivedTile::WATER: {
+        grid_.set(row, col, {TileType::WATER, kDefaultWaterCost});
       } break;
 
       case PerceivedTile::UNKNOWN:
       case PerceivedTile::EMPTY: {
-        grid_[row * cols + col] = std::make_shared<EmptyTile>();
+        grid_.set(row, col, {TileType::EMPTY, 0});
       } break;
 
-      default:
-        break;
+      default: {
+        // Keys and locked doors carry their colour as an offset.
+        const uint32_t value = static_cast<uint32_t>(tile);
+        const uint32_t key = static_cast<uint32_t>(PerceivedTile::KEY);
+        const uint32_t locked_door = static_cast<uint32_t>(PerceivedTile::LOCKED_DOOR);
+        if (value >= key && value < key + kKeyColours) {
+          grid_.set(row, col, {TileType::KEY, static_cast<uint8_t>(value - key + 1)});
+        } else if (value >= locked_door && value < locked_door + kKeyColours) {
+          grid_.set(row, col, {TileType::DOOR, static_cast<uint8_t>(value - locked_door + 1)});
+        } else {
+          throw std::invalid_argument("Layout contains an invalid tile.");
+        }
+      } break;
       }
       col++;
     }
@@ -91,6 +152,8 @@ Maze::Maze(const std::vector<std::vector<PerceivedTile>>& maze_layout)
   if (!has_end) {
     throw std::invalid_argument("Layout has no end, which is required.");
   }
+  initializeHashes();
+  countLockedDoors();
 }
 
 bool Maze::isFinished() const {
@@ -98,7 +161,15 @@ bool Maze::isFinished() const {
 }
 
 std::shared_ptr<Tile> Maze::getTile(uint32_t row, uint32_t col) const {
-  return grid_[row * cols_ + col];
+  return makeTile(grid_.get(row, col));
+}
+
+Cell Maze::getCell(uint32_t row, uint32_t col) const {
+  return grid_.get(row, col);
+}
+
+const Grid& Maze::getGrid() const {
+  return grid_;
 }
 
 bool Maze::isPlayerAt(uint32_t row, uint32_t col) const {
@@ -149,18 +220,35 @@ bool Maze::movePlayer(Maze::Move move) {
 
   // Check if the new position is within bounds and passable.
   if (newPos.row >= 0 && newPos.row < rows_ && newPos.col >= 0 && newPos.col < cols_ &&
-      grid_[newPos.row * cols_ + newPos.col]->isPassable()) {
-    auto tile = grid_[newPos.row * cols_ + newPos.col];
+      isPassable(grid_.get(newPos.row, newPos.col), player_.getKeys())) {
+    const Cell cell = grid_.get(newPos.row, newPos.col);
 
     // Handle special tiles.
-    if (std::shared_ptr<FoodTile> foodTile = std::dynamic_pointer_cast<FoodTile>(tile)) {
-      player_.pickFood(foodTile->getWeight());
-      grid_[newPos.row * cols_ + newPos.col] = std::make_shared<EmptyTile>();
+    const uint32_t oldFood = player_.getCurrentFood();
+    if (cell.type == TileType::FOOD || cell.type == TileType::KEY) {
+      if (cell.type == TileType::FOOD) {
+        player_.pickFood(cell.value);
+      } else {
+        player_.pickKey(cell.value - 1u);
+      }
+      grid_.set(newPos.row, newPos.col, {TileType::EMPTY, 0});
+      analytics_.reset();
+      if (junctions_) {
+        if (junctions_.use_count() > 1) {
+          junctions_ = std::make_shared<JunctionGraph>(*junctions_);
+        }
+        junctions_->clearCell(newPos);
+      }
+      const uint64_t foodKey = zobristCellKey(newPos, cell);
+      layout_hash_ ^= foodKey;
+      state_hash_ ^= foodKey;
     }
 
     // Move the player and consume food.
+    state_hash_ ^= zobristPlayerKey(player_pos_) ^ zobristPlayerKey(newPos);
     player_pos_ = newPos;
-    player_.consumeFood(1);
+    player_.consumeFood(getMoveCost(cell));
+    state_hash_ ^= zobristFoodKey(oldFood) ^ zobristFoodKey(player_.getCurrentFood());
     return true;
   }
 
@@ -168,6 +256,30 @@ bool Maze::movePlayer(Maze::Move move) {
 }
 
 bool Maze::isSolvable() {
+  if (solve_cache_) {
+    if (const auto cached = solve_cache_->find(state_hash_)) {
+      return cached->has_value();
+    }
+  }
+
+  // Without a path that ignores food there is no need to search with food. Connectivity tracking
+  // treats every door as open, just like the search with all keys.
+  bool reachable = false;
+  if (connectivity_) {
+    reachable = connectivity_->isConnected(player_pos_, end_pos_);
+  } else {
+    const std::vector<uint32_t> distances =
+        breadthFirstDistances(grid_, player_pos_, std::numeric_limits<uint16_t>::max());
+    reachable =
+        distances[static_cast<std::size_t>(end_pos_.row) * cols_ + end_pos_.col] != kUnreachable;
+  }
+  if (!reachable) {
+    if (solve_cache_) {
+      solve_cache_->insert(state_hash_, std::nullopt);
+    }
+    return false;
+  }
+
   try {
     solve();
     return true;
@@ -177,36 +289,84 @@ bool Maze::isSolvable() {
 }
 
 std::vector<Maze::Move> Maze::solve() {
-  // Deep copy grid
-  std::vector<std::shared_ptr<Tile>> localGrid;
-  for (const auto& tile : grid_) {
-    localGrid.push_back(tile->clone());
+  if (!solve_cache_) {
+    return search();
   }
 
-  // Use local versions of player_, player_pos_, and start_pos_
-  Player localPlayer = player_;
-  Coordinates localPlayerPos = player_pos_;
-  Coordinates start_pos = localPlayerPos;
+  if (const auto cached = solve_cache_->find(state_hash_)) {
+    if (!*cached) {
+      throw std::runtime_error("Maze is not solvable");
+    }
+    return **cached;
+  }
+
+  try {
+    std::vector<Move> moves = search();
+    solve_cache_->insert(state_hash_, moves);
+    return moves;
+  } catch (const std::runtime_error&) {
+    solve_cache_->insert(state_hash_, std::nullopt);
+    throw;
+  }
+}
+
+void Maze::setSolveCache(std::shared_ptr<SolveCache> cache) {
+  solve_cache_ = std::move(cache);
+}
+
+const std::shared_ptr<SolveCache>& Maze::getSolveCache() const {
+  return solve_cache_;
+}
 
-  std::priority_queue<std::pair<int, Coordinates>, std::vector<std::pair<int, Coordinates>>, std::greater<>> openSet;
-  std::unordered_set<Coordinates, std::hash<Coordinates>> closedSet;
-  std::unordered_map<Coordinates, Coordinates, std::hash<Coordinates>> cameFrom;
-  std::unordered_map<Coordinates, int, std::hash<Coordinates>> gScore;
-  std::unordered_map<Coordinates, int, std::hash<Coordinates>> foodMap;
+std::vector<Maze::Move> Maze::search() {
+  // The junction graph only passes doors with the keys held, so locked doors need the cell search.
+  if (junction_search_ && locked_doors_ == 0) {
+    if (!junctions_) {
+      junctions_ = std::make_shared<JunctionGraph>(grid_, start_pos_, end_pos_);
+    }
+    if (auto path = junctions_->solve(grid_, player_pos_, player_.getCurrentFood(),
+                                      player_.getKeys())) {
+      return std::move(*path);
+    }
+    throw std::runtime_error("Maze is not solvable");
+  }
 
-  openSet.push({manhattanDistance(start_pos, end_pos_) + localPlayer.getCurrentFood(), start_pos});
-  gScore[start_pos] = 0;
-  foodMap[start_pos] = localPlayer.getCurrentFood();
+  // Food tiles that were consumed during the search, instead of a copy of the whole grid.
+  std::unordered_set<Coordinates, std::hash<Coordinates>> eatenFood;
+
+  // Search states are a cell and the keys held on arrival, packed as keys << 32 | cell.
+  const auto stateOf = [this](const Coordinates& pos, uint16_t keys) {
+    return (static_cast<uint64_t>(keys) << 32) | (static_cast<uint64_t>(pos.row) * cols_ + pos.col);
+  };
+  const auto positionOf = [this](uint64_t state) -> Coordinates {
+    const uint32_t cell = static_cast<uint32_t>(state);
+    return {cell / cols_, cell % cols_};
+  };
+
+  const uint64_t start = stateOf(player_pos_, player_.getKeys());
+  std::priority_queue<std::pair<int, uint64_t>, std::vector<std::pair<int, uint64_t>>,
+                      std::greater<>> openSet;
+  std::unordered_set<uint64_t> closedSet;
+  std::unordered_map<uint64_t, uint64_t> cameFrom;
+  std::unordered_map<uint64_t, int> gScore;
+  std::unordered_map<uint64_t, int> foodMap;
+
+  openSet.push({static_cast<int>(estimateDistanceToEnd(player_pos_) + player_.getCurrentFood()),
+                start});
+  gScore[start] = 0;
+  foodMap[start] = player_.getCurrentFood();
 
   while (!openSet.empty()) {
-    Coordinates current = openSet.top().second;
+    uint64_t current = openSet.top().second;
     openSet.pop();
+    const Coordinates current_pos = positionOf(current);
+    const uint16_t keys = static_cast<uint16_t>(current >> 32);
 
-    if (current == end_pos_) {
+    if (current_pos == end_pos_) {
       std::vector<Move> path;
-      while (cameFrom.count(current) > 0) {
-        Coordinates previous = cameFrom[current];
-        path.push_back(getMoveFromCoords(previous, current));
+      while (current != start) {
+        const uint64_t previous = cameFrom[current];
+        path.push_back(getMoveFromCoords(positionOf(previous), positionOf(current)));
         current = previous;
       }
 
@@ -214,22 +374,24 @@ std::vector<Maze::Move> Maze::solve() {
       return path;
     }
 
-    if (closedSet.count(current) > 0) {
+    if (!closedSet.insert(current).second) {
       continue;
     }
 
-    closedSet.insert(current);
-
-    for (const auto& neighbor : getNeighbors(current)) {
+    for (const auto& neighbor_pos : getNeighbors(current_pos, keys)) {
+      const Cell cell = grid_.get(neighbor_pos.row, neighbor_pos.col);
+      const uint16_t neighbor_keys =
+          cell.type == TileType::KEY ? static_cast<uint16_t>(keys | (1u << (cell.value - 1)))
+                                     : keys;
+      const uint64_t neighbor = stateOf(neighbor_pos, neighbor_keys);
       if (closedSet.count(neighbor) == 0) {
         int tentativeGScore = gScore[current] + 1;
-        int food = foodMap[current] - 1;
+        int food = foodMap[current] - static_cast<int>(getMoveCost(cell));
 
-        auto tile = localGrid[neighbor.row * cols_ + neighbor.col].get();
-        if (FoodTile* foodTile = dynamic_cast<FoodTile*>(tile)) {
-          food += foodTile->getWeight();
-          // Update the tile to an empty tile after the food is consumed
-          localGrid[neighbor.row * cols_ + neighbor.col] = std::make_shared<EmptyTile>();
+        if (cell.type == TileType::FOOD && eatenFood.count(neighbor_pos) == 0) {
+          food += cell.value;
+          // Treat the tile as an empty tile after the food is consumed
+          eatenFood.insert(neighbor_pos);
         }
 
         if (food <= 0) {
@@ -240,7 +402,7 @@ std::vector<Maze::Move> Maze::solve() {
           cameFrom[neighbor] = current;
           gScore[neighbor] = tentativeGScore;
           foodMap[neighbor] = food;
-          int fScore = tentativeGScore + manhattanDistance(neighbor, end_pos_) + food;
+          int fScore = tentativeGScore + estimateDistanceToEnd(neighbor_pos) + food;
           openSet.push({fScore, neighbor});
         }
       }
@@ -250,8 +412,8 @@ std::vector<Maze::Move> Maze::solve() {
   throw std::runtime_error("Maze is not solvable");
 }
 
-bool Maze::blocksLineOfSight(const std::shared_ptr<Tile>& tile) const {
-  return std::dynamic_pointer_cast<WallTile>(tile) != nullptr;
+bool Maze::blocksLineOfSight(const Cell& cell) const {
+  return cell.type == TileType::WALL;
 }
 
 bool Maze::lineOfSight(int startX, int startY, int endX, int endY) const {
@@ -266,7 +428,7 @@ bool Maze::lineOfSight(int startX, int startY, int endX, int endY) const {
       break;
     }
 
-    if ((startX != endX || startY != endY) && blocksLineOfSight(grid_[startY * cols_ + startX])) {
+    if ((startX != endX || startY != endY) && blocksLineOfSight(grid_.get(startY, startX))) {
       return false;
     }
 
@@ -284,6 +446,41 @@ bool Maze::lineOfSight(int startX, int startY, int endX, int endY) const {
   return true;
 }
 
+bool Maze::hasLineOfSight(const Coordinates& from, const Coordinates& to) const {
+  return lineOfSight(from.col, from.row, to.col, to.row);
+}
+
+const MazeAnalytics& Maze::getAnalytics(uint32_t sight_radius) const {
+  if (!analytics_ || analytics_->sight_radius != sight_radius) {
+    analytics_ = analyzeMaze(*this, sight_radius);
+  }
+  return *analytics_;
+}
+
+uint64_t Maze::getLayoutHash() const {
+  return layout_hash_;
+}
+
+uint64_t Maze::getStateHash() const {
+  return state_hash_;
+}
+
+void Maze::countLockedDoors() {
+  locked_doors_ = 0;
+  for (uint32_t row = 0; row < rows_; ++row) {
+    for (uint32_t col = 0; col < cols_; ++col) {
+      const Cell cell = grid_.get(row, col);
+      locked_doors_ += cell.type == TileType::DOOR && cell.value != 0 ? 1 : 0;
+    }
+  }
+}
+
+void Maze::initializeHashes() {
+  layout_hash_ = hashLayout(grid_, start_pos_, end_pos_);
+  state_hash_ = layout_hash_ ^ zobristPlayerKey(player_pos_)
+                ^ zobristFoodKey(player_.getCurrentFood());
+}
+
 Maze::Move Maze::getMoveFromCoords(const Coordinates& from, const Coordinates& to) {
   if (from.row == to.row) {
     if (from.col < to.col) {
@@ -314,10 +511,36 @@ Coordinates Maze::getPlayerPosition() const {
 
 std::vector<std::vector<Maze::PerceivedTile>> Maze::perceiveTiles(uint32_t radius) {
   const uint32_t vector_size = radius * 2 + 1;
+  std::vector<PerceivedTile> window(static_cast<std::size_t>(vector_size) * vector_size);
+  perceiveTiles(radius, window.data());
+
   std::vector<std::vector<PerceivedTile>> perceived_rows;
-  perceived_rows.resize(vector_size);
-  for (std::vector<PerceivedTile>& perceived_col : perceived_rows) {
-    perceived_col.resize(vector_size, PerceivedTile::UNKNOWN);
+  perceived_rows.reserve(vector_size);
+  for (uint32_t row = 0; row < vector_size; ++row) {
+    perceived_rows.emplace_back(window.begin() + row * vector_size,
+                                window.begin() + (row + 1) * vector_size);
+  }
+  return perceived_rows;
+}
+
+void Maze::perceiveTiles(uint32_t radius, PerceivedTile* out) const {
+  const uint32_t vector_size = radius * 2 + 1;
+  std::fill(out, out + static_cast<std::size_t>(vector_size) * vector_size,
+            PerceivedTile::UNKNOWN);
+
+  if (visibility_ && visibility_->getRadius() == radius) {
+    // The visible cells are known, only their tiles need to be looked up.
+    const VisibleRun* const runs_end = visibility_->getRunsEnd(player_pos_);
+    for (const VisibleRun* run = visibility_->getRunsBegin(player_pos_); run != runs_end; ++run) {
+      const uint32_t row = player_pos_.row + run->row_offset;
+      const uint32_t first_col = player_pos_.col + run->col_offset;
+      PerceivedTile* const out_row = out + (radius + run->row_offset) * vector_size + radius;
+      for (uint32_t index = 0; index < run->length; ++index) {
+        out_row[run->col_offset + static_cast<int32_t>(index)] =
+            perceiveCell(row, first_col + index);
+      }
+    }
+    return;
   }
 
   const uint32_t squaredRadius = radius * radius;
@@ -344,116 +567,208 @@ std::vector<std::vector<Maze::PerceivedTile>> Maze::perceiveTiles(uint32_t radiu
 
       int32_t rel_row = row - start_row;
       int32_t rel_col = col - start_col;
-      auto& current_perceived_tile = perceived_rows[rel_row][rel_col];
-      if (start_pos_.row == row && start_pos_.col == col) {
-        current_perceived_tile = PerceivedTile::START;
-      } else if (end_pos_.row == row && end_pos_.col == col) {
-        current_perceived_tile = PerceivedTile::END;
-      } else {
-        const std::shared_ptr<Tile> tile = grid_[row * cols_ + col];
-        if (std::dynamic_pointer_cast<WallTile>(tile)) {
-          current_perceived_tile = PerceivedTile::WALL;
-        } else if (std::dynamic_pointer_cast<DoorTile>(tile)) {
-          current_perceived_tile = PerceivedTile::DOOR;
-        } else if (std::dynamic_pointer_cast<FoodTile>(tile)) {
-          current_perceived_tile = PerceivedTile::FOOD;
-        } else if (std::dynamic_pointer_cast<EmptyTile>(tile)) {
-          current_perceived_tile = PerceivedTile::EMPTY;
-        }
-      }
+      out[rel_row * vector_size + rel_col] = perceiveCell(row, col);
     }
   }
+}
 
-  return perceived_rows;
+Maze::PerceivedTile Maze::perceiveCell(uint32_t row, uint32_t col) const {
+  if (start_pos_.row == row && start_pos_.col == col) {
+    return PerceivedTile::START;
+  } else if (end_pos_.row == row && end_pos_.col == col) {
+    return PerceivedTile::END;
+  }
+  return perceivedCell(grid_.get(row, col));
 }
 
-void Maze::generateMaze(double difficulty) {
-  // Fill the grid with wall tiles.
-  for (uint32_t i = 0; i < rows_; i++) {
-    for (uint32_t j = 0; j < cols_; j++) {
-      if (j == 0 || i == 0 || j == cols_ - 1 || i == rows_ - 1) {
-        grid_[i * cols_ + j] = std::make_shared<WallTile>();
-      } else {
-        grid_[i * cols_ + j] = std::make_shared<EmptyTile>();
+Maze::PerceivedTile Maze::perceivedCell(const Cell& cell) {
+  switch (cell.type) {
+  case TileType::WALL:
+    return PerceivedTile::WALL;
+  case TileType::DOOR:
+    return cell.value == 0 ? PerceivedTile::DOOR : perceivedLockedDoor(cell.value - 1u);
+  case TileType::FOOD:
+    return PerceivedTile::FOOD;
+  case TileType::KEY:
+    return perceivedKey(cell.value - 1u);
+  case TileType::MUD:
+    return PerceivedTile::MUD;
+  case TileType::WATER:
+    return PerceivedTile::WATER;
+  case TileType::EMPTY:
+  default:
+    return PerceivedTile::EMPTY;
+  }
+}
+
+Maze::PerceivedTile Maze::perceivedKey(uint32_t colour) {
+  if (colour >= kKeyColours) {
+    throw std::invalid_argument("There are only " + std::to_string(kKeyColours) + " key colours.");
+  }
+  return static_cast<PerceivedTile>(static_cast<uint32_t>(PerceivedTile::KEY) + colour);
+}
+
+Maze::PerceivedTile Maze::perceivedLockedDoor(uint32_t colour) {
+  if (colour >= kKeyColours) {
+    throw std::invalid_argument("There are only " + std::to_string(kKeyColours) + " key colours.");
+  }
+  return static_cast<PerceivedTile>(static_cast<uint32_t>(PerceivedTile::LOCKED_DOOR) + colour);
+}
+
+uint16_t Maze::getPlayerKeys() const {
+  return player_.getKeys();
+}
+
+std::shared_ptr<const VisibilityIndex> Maze::getVisibilityIndex(uint32_t radius,
+                                                                uint32_t threads) {
+  if (!visibility_ || visibility_->getRadius() != radius) {
+    visibility_ = std::make_shared<const VisibilityIndex>(*this, radius, threads);
+  }
+  return visibility_;
+}
+
+void Maze::setVisibilityIndex(std::shared_ptr<const VisibilityIndex> index) {
+  if (index && (index->getRows() != rows_ || index->getCols() != cols_)) {
+    throw std::invalid_argument("The visibility index was built for a maze of another size.");
+  }
+  visibility_ = std::move(index);
+}
+
+void Maze::setTileType(uint32_t row, uint32_t col, TileType type, uint8_t value) {
+  if (row >= rows_ || col >= cols_) {
+    throw std::invalid_argument("The cell lies outside the maze.");
+  }
+  const Coordinates pos = {row, col};
+  if (type == TileType::WALL && pos == player_pos_) {
+    throw std::invalid_argument("A wall cannot be placed on the player.");
+  }
+  if ((type == TileType::KEY && (value == 0 || value > kKeyColours))
+      || (type == TileType::DOOR && value > kKeyColours)) {
+    throw std::invalid_argument("Keys hold a colour + 1 from 1 to " + std::to_string(kKeyColours)
+                                + ", doors 0 or a colour + 1.");
+  }
+  const Cell old_cell = grid_.get(row, col);
+  const Cell new_cell = {type, value};
+  if (old_cell.type == new_cell.type && old_cell.value == new_cell.value) {
+    return;
+  }
+
+  grid_.set(row, col, new_cell);
+  locked_doors_ -= old_cell.type == TileType::DOOR && old_cell.value != 0 ? 1 : 0;
+  locked_doors_ += new_cell.type == TileType::DOOR && new_cell.value != 0 ? 1 : 0;
+  const uint64_t cell_keys = zobristCellKey(pos, old_cell) ^ zobristCellKey(pos, new_cell);
+  layout_hash_ ^= cell_keys;
+  state_hash_ ^= cell_keys;
+  analytics_.reset();
+  if (isPassable(old_cell.type) != isPassable(new_cell.type)) {
+    visibility_.reset();
+    landmarks_.reset();
+    if (connectivity_) {
+      if (connectivity_.use_count() > 1) {
+        connectivity_ = std::make_shared<DynamicConnectivity>(*connectivity_);
       }
+      connectivity_->setOpen(pos, isPassable(new_cell.type));
     }
   }
+  // Rebuilt on the next search, so a batch of changes costs one rebuild.
+  junctions_.reset();
+}
 
-  // Lambda function for recursive depth-first search maze generation.
-  const std::function<void(uint32_t, uint32_t)> dfs =
-      [&](uint32_t row, uint32_t col) {
-        // Set the current cell as an empty tile.
-        grid_[row * cols_ + col] = std::make_shared<EmptyTile>();
+void Maze::setConnectivityTracking(bool enabled) {
+  if (!enabled) {
+    connectivity_.reset();
+  } else if (!connectivity_) {
+    connectivity_ = std::make_shared<DynamicConnectivity>(grid_);
+  }
+}
 
-        // Randomly choose the order in which to visit neighbors.
-        std::vector<std::pair<uint32_t, uint32_t>> neighbors = {{-2, 0}, {2, 0}, {0, -2}, {0, 2}};
-        std::shuffle(neighbors.begin(), neighbors.end(), std::mt19937(std::random_device()()));
+bool Maze::isReachable(const Coordinates& pos) const {
+  if (pos.row >= rows_ || pos.col >= cols_) {
+    return false;
+  }
+  if (connectivity_) {
+    return connectivity_->isConnected(player_pos_, pos);
+  }
+  return isPassable(grid_.get(pos.row, pos.col).type)
+         && breadthFirstDistances(grid_, player_pos_, std::numeric_limits<uint16_t>::max())
+                    [static_cast<std::size_t>(pos.row) * cols_ + pos.col]
+                != kUnreachable;
+}
 
-        // Visit neighbors.
-        for (const auto& [dr, dc] : neighbors) {
-          const uint32_t newRow = row + dr;
-          const uint32_t newCol = col + dc;
-          if (newRow > 0 && newRow < rows_ - 1 && newCol > 0 && newCol < cols_ - 1 &&
-              std::dynamic_pointer_cast<WallTile>(getTile(newRow, newCol))) {
-            // Remove the wall between cells.
-            grid_[(row + newRow) / 2 * cols_ + (col + newCol) / 2] = std::make_shared<EmptyTile>();
+void Maze::setLandmarkTable(std::shared_ptr<const LandmarkTable> landmarks) {
+  if (landmarks && (landmarks->getRows() != rows_ || landmarks->getCols() != cols_)) {
+    throw std::invalid_argument("The landmark table was built for a maze of another size.");
+  }
+  landmarks_ = std::move(landmarks);
+}
 
-            // Continue generating the maze from the neighbor.
-            dfs(newRow, newCol);
-          }
-        }
-      };
+const std::shared_ptr<const LandmarkTable>& Maze::getLandmarkTable() const {
+  return landmarks_;
+}
 
-  // Generate the maze layout.
-  dfs(1, 1);
+void Maze::setJunctionSearch(bool enabled) {
+  junction_search_ = enabled;
+  if (!enabled) {
+    junctions_.reset();
+  } else if (!junctions_) {
+    junctions_ = std::make_shared<JunctionGraph>(grid_, start_pos_, end_pos_);
+  }
+}
 
-  // Add random walls based on the difficulty.
-  const uint32_t numWallsToAdd = static_cast<uint32_t>(difficulty * (rows_ - 2) * (cols_ - 2) / 5);
-  std::random_device random_device;
-  std::mt19937 rng(random_device());
-  for (uint32_t i = 0; i < numWallsToAdd; i++) {
-    uint32_t row = 1 + rng() % (rows_ - 2);
-    uint32_t col = 1 + rng() % (cols_ - 2);
-    if (std::dynamic_pointer_cast<EmptyTile>(getTile(row, col))) {
-      grid_[row * cols_ + col] = std::make_shared<WallTile>();
-    }
+std::shared_ptr<const JunctionGraph> Maze::getJunctionGraph() const {
+  if (junction_search_ && !junctions_) {
+    junctions_ = std::make_shared<JunctionGraph>(grid_, start_pos_, end_pos_);
   }
+  return junctions_;
+}
 
-  // Place special tiles.
-  const uint32_t numFoodItems = static_cast<int>((1 - difficulty) * (rows_ - 2) * (cols_ - 2) / 5);
-  for (uint32_t i = 0; i < numFoodItems; i++) {
-    uint32_t row, col;
-    do {
-      row = 1 + rng() % (rows_ - 2);
-      col = 1 + rng() % (cols_ - 2);
-    } while (!std::dynamic_pointer_cast<EmptyTile>(getTile(row, col)));
-    grid_[row * cols_ + col] = std::make_shared<FoodTile>(10 + rng() % 11);
+void Maze::generateMaze(double difficulty, const GenerationOptions& generation) {
+  if (rows_ < 3 || cols_ < 3) {
+    throw std::invalid_argument("A generated maze needs at least three rows and columns.");
   }
 
-  // Place random doors based on difficulty.
-  const uint32_t numDoors = static_cast<int>(difficulty * (rows_ + cols_) / 4);
-  for (uint32_t i = 0; i < numDoors; i++) {
-    uint32_t row, col;
-    do {
-      row = 1 + rng() % (rows_ - 2);
-      col = 1 + rng() % (cols_ - 2);
-    } while (!std::dynamic_pointer_cast<EmptyTile>(getTile(row, col)));
-    grid_[row * cols_ + col] = std::make_shared<DoorTile>();
+  // Carve a perfect maze, surrounded by walls.
+  std::random_device random_device;
+  const uint64_t seed =
+      generation.seed ? *generation.seed
+                      : (static_cast<uint64_t>(random_device()) << 32) | random_device();
+  carvePerfectMaze(grid_, seed, generation);
+
+  // Add random walls based on the difficulty. Items are drawn without replacement from the
+  // empty interior cells, so placement always terminates even in crowded mazes.
+  const PlacementOptions& placement = generation.placement;
+  const double interior = static_cast<double>(rows_ - 2) * (cols_ - 2);
+  const uint32_t numWallsToAdd = static_cast<uint32_t>(
+      placement.wall_density ? *placement.wall_density * interior : difficulty * interior / 5);
+  RandomGenerator rng(seed);
+  PlacementEngine placement_engine(grid_, rng);
+  for (const Coordinates& pos : placement_engine.take(numWallsToAdd, PlacementOptions(), {0, 0})) {
+    grid_.set(pos.row, pos.col, {TileType::WALL, 0});
   }
 
-  // Set random start and end positions on outer walls (excluding corners).
+  // Set random start and end positions on outer walls (excluding corners) that lead into the maze.
   std::vector<Coordinates> candidatePositions;
   for (uint32_t col = 1; col < cols_ - 1; col++) {
-    candidatePositions.push_back({0, col});
-    candidatePositions.push_back({rows_ - 1, col});
+    if (isPassable(grid_.get(1, col).type)) {
+      candidatePositions.push_back({0, col});
+    }
+    if (isPassable(grid_.get(rows_ - 2, col).type)) {
+      candidatePositions.push_back({rows_ - 1, col});
+    }
   }
   for (uint32_t row = 1; row < rows_ - 1; row++) {
-    candidatePositions.push_back({row, 0});
-    candidatePositions.push_back({row, cols_ - 1});
+    if (isPassable(grid_.get(row, 1).type)) {
+      candidatePositions.push_back({row, 0});
+    }
+    if (isPassable(grid_.get(row, cols_ - 2).type)) {
+      candidatePositions.push_back({row, cols_ - 1});
+    }
   }
 
-  // Shuffle candidate positions.
-  std::shuffle(candidatePositions.begin(), candidatePositions.end(), std::mt19937(random_device()));
+  // Shuffle candidate positions. Unlike std::shuffle, the order is the same on every platform.
+  for (std::size_t i = candidatePositions.size(); i > 1; --i) {
+    std::swap(candidatePositions[i - 1], candidatePositions[rng.below(i)]);
+  }
 
   start_pos_ = {0, 0};
   end_pos_ = {0, 0};
@@ -461,22 +776,136 @@ void Maze::generateMaze(double difficulty) {
   // Assign start and end positions.
   for (const auto& pos : candidatePositions) {
     if (start_pos_.row == 0 && start_pos_.col == 0 &&
-        std::dynamic_pointer_cast<WallTile>(getTile(pos.row, pos.col))) {
+        grid_.get(pos.row, pos.col).type == TileType::WALL) {
       start_pos_ = pos;
-      grid_[start_pos_.row * cols_ + start_pos_.col] = std::make_shared<EmptyTile>();
+      grid_.set(start_pos_.row, start_pos_.col, {TileType::EMPTY, 0});
     } else if (end_pos_.row == 0 && end_pos_.col == 0 &&
-               std::dynamic_pointer_cast<WallTile>(getTile(pos.row, pos.col)) && pos != start_pos_) {
+               grid_.get(pos.row, pos.col).type == TileType::WALL && pos != start_pos_) {
       end_pos_ = pos;
-      grid_[end_pos_.row * cols_ + end_pos_.col] = std::make_shared<EmptyTile>();
+      grid_.set(end_pos_.row, end_pos_.col, {TileType::EMPTY, 0});
       break;
     }
   }
 
+  // Place special tiles.
+  const uint32_t numFoodItems = static_cast<uint32_t>(
+      placement.food_density ? *placement.food_density * interior
+                             : (1 - difficulty) * interior / 5);
+  for (const Coordinates& pos : placement_engine.take(numFoodItems, placement, start_pos_)) {
+    grid_.set(pos.row, pos.col, {TileType::FOOD, static_cast<uint8_t>(10 + rng.below(11))});
+  }
+
+  // Place random doors based on difficulty.
+  const uint32_t numDoors = static_cast<uint32_t>(
+      placement.door_density ? *placement.door_density * interior
+                             : difficulty * (rows_ + cols_) / 4);
+  for (const Coordinates& pos : placement_engine.take(numDoors, placement, start_pos_)) {
+    grid_.set(pos.row, pos.col, {TileType::DOOR, 0});
+  }
+
+  // Place weighted terrain.
+  for (const Coordinates& pos : placement_engine.take(
+           static_cast<uint32_t>(placement.mud_density * interior), placement, start_pos_)) {
+    grid_.set(pos.row, pos.col, {TileType::MUD, placement.mud_cost});
+  }
+  for (const Coordinates& pos : placement_engine.take(
+           static_cast<uint32_t>(placement.water_density * interior), placement, start_pos_)) {
+    grid_.set(pos.row, pos.col, {TileType::WATER, placement.water_cost});
+  }
+
+  placeKeysAndDoors(std::min(placement.key_colours, kKeyColours), rng);
+
   // Place the player at the start position.
   player_pos_ = start_pos_;
 }
 
-std::vector<Coordinates> Maze::getNeighbors(const Coordinates& pos) {
+void Maze::placeKeysAndDoors(uint32_t colours, RandomGenerator& rng) {
+  if (colours == 0) {
+    return;
+  }
+
+  // Breadth-first search from the start through the cells passable with some keys.
+  std::vector<uint32_t> parents(static_cast<std::size_t>(rows_) * cols_);
+  std::vector<bool> visited(parents.size());
+  std::vector<uint32_t> queue;
+  const auto search = [&](uint16_t keys) {
+    std::fill(visited.begin(), visited.end(), false);
+    queue.clear();
+    const uint32_t start = start_pos_.row * cols_ + start_pos_.col;
+    visited[start] = true;
+    queue.push_back(start);
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      const uint32_t cell = queue[head];
+      const uint32_t row = cell / cols_;
+      const uint32_t col = cell % cols_;
+      const auto visit = [&](uint32_t next_row, uint32_t next_col) {
+        const uint32_t next = next_row * cols_ + next_col;
+        if (!visited[next] && isPassable(grid_.get(next_row, next_col), keys)) {
+          visited[next] = true;
+          parents[next] = cell;
+          queue.push_back(next);
+        }
+      };
+      if (row > 0) {
+        visit(row - 1, col);
+      }
+      if (row + 1 < rows_) {
+        visit(row + 1, col);
+      }
+      if (col > 0) {
+        visit(row, col - 1);
+      }
+      if (col + 1 < cols_) {
+        visit(row, col + 1);
+      }
+    }
+  };
+
+  // Lock doors along one shortest path, in the order of their colours.
+  search(0);
+  const uint32_t end = end_pos_.row * cols_ + end_pos_.col;
+  if (!visited[end]) {
+    return;
+  }
+  std::vector<Coordinates> path;
+  for (uint32_t cell = parents[end]; cell != start_pos_.row * cols_ + start_pos_.col;
+       cell = parents[cell]) {
+    if (grid_.get(cell / cols_, cell % cols_).type == TileType::EMPTY) {
+      path.push_back({cell / cols_, cell % cols_});
+    }
+  }
+  std::reverse(path.begin(), path.end());
+  colours = std::min<uint32_t>(colours, static_cast<uint32_t>(path.size()) / 2);
+  for (uint32_t colour = 0; colour < colours; ++colour) {
+    const Coordinates& door = path[(colour + 1) * path.size() / (colours + 1)];
+    grid_.set(door.row, door.col, {TileType::DOOR, static_cast<uint8_t>(colour + 1)});
+  }
+
+  // Every key lies where it can be reached with the keys of the colours before it.
+  for (uint32_t colour = 0; colour < colours; ++colour) {
+    search(static_cast<uint16_t>((1u << colour) - 1));
+    std::vector<Coordinates> candidates;
+    for (const uint32_t cell : queue) {
+      const Coordinates pos = {cell / cols_, cell % cols_};
+      if (grid_.get(pos.row, pos.col).type == TileType::EMPTY && pos != start_pos_
+          && pos != end_pos_) {
+        candidates.push_back(pos);
+      }
+    }
+    if (candidates.empty()) {
+      // Unlock the doors that cannot get a key.
+      for (uint32_t unlocked = colour; unlocked < colours; ++unlocked) {
+        const Coordinates& door = path[(unlocked + 1) * path.size() / (colours + 1)];
+        grid_.set(door.row, door.col, {TileType::EMPTY, 0});
+      }
+      return;
+    }
+    const Coordinates& key = candidates[rng.below(candidates.size())];
+    grid_.set(key.row, key.col, {TileType::KEY, static_cast<uint8_t>(colour + 1)});
+  }
+}
+
+std::vector<Coordinates> Maze::getNeighbors(const Coordinates& pos, uint16_t keys) {
   std::vector<Coordinates> neighbors;
   std::vector<std::pair<int32_t, int32_t>> directions = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
 
@@ -491,7 +920,7 @@ std::vector<Coordinates> Maze::getNeighbors(const Coordinates& pos) {
     const uint32_t newRow = static_cast<uint32_t>(newRow_signed);
     const uint32_t newCol = static_cast<uint32_t>(newCol_signed);
 
-    if (isInBounds(newRow, newCol) && getTile(newRow, newCol)->isPassable()) {
+    if (isInBounds(newRow, newCol) && isPassable(grid_.get(newRow, newCol), keys)) {
       neighbors.push_back({newRow, newCol});
     }
   }
@@ -505,4 +934,9 @@ uint32_t Maze::manhattanDistance(const Coordinates& a, const Coordinates& b) {
                             std::abs(static_cast<int32_t>(a.col - b.col)));
 }
 
+uint32_t Maze::estimateDistanceToEnd(const Coordinates& pos) {
+  const uint32_t manhattan = manhattanDistance(pos, end_pos_);
+  return landmarks_ ? std::max(manhattan, landmarks_->getLowerBound(pos, end_pos_)) : manhattan;
+}
+
 }  // namespace maze
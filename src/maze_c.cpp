@@ -0,0 +1,161 @@
+#include <maze/maze_c.h>
+
+// Standard
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Private
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+#include <maze/parallel.hpp>
+
+struct maze_env {
+  uint32_t rows; /**< The number of rows of the maze. */
+  uint32_t cols; /**< The number of columns of the maze. */
+  double difficulty; /**< The difficulty the maze was generated with. */
+  uint64_t seed; /**< The seed the maze was generated from. */
+  std::unique_ptr<maze::Maze> maze; /**< The current maze. */
+  bool done; /**< Whether the episode has ended. */
+};
+
+namespace {
+static_assert(sizeof(maze::Maze::PerceivedTile) == sizeof(uint8_t),
+              "Observations are written to byte buffers in place.");
+static_assert(static_cast<int>(maze::Maze::PerceivedTile::KEY) == MAZE_TILE_KEY
+                  && static_cast<int>(maze::Maze::PerceivedTile::LOCKED_DOOR)
+                         == MAZE_TILE_LOCKED_DOOR
+                  && static_cast<int>(maze::Maze::PerceivedTile::WATER) == MAZE_TILE_WATER,
+              "The C tile values mirror Maze::PerceivedTile.");
+
+thread_local std::string last_error;
+
+std::unique_ptr<maze::Maze> generate(const maze_env& env) {
+  maze::GenerationOptions options;
+  options.seed = env.seed;
+  return std::make_unique<maze::Maze>(env.rows, env.cols, env.difficulty, options);
+}
+
+maze::Maze::PerceivedTile* asTiles(uint8_t* observation) {
+  return reinterpret_cast<maze::Maze::PerceivedTile*>(observation);
+}
+} // namespace
+
+extern "C" {
+
+maze_env* maze_env_create(uint32_t rows, uint32_t cols, double difficulty, uint64_t seed) {
+  try {
+    auto env = std::make_unique<maze_env>();
+    env->rows = rows;
+    env->cols = cols;
+    env->difficulty = difficulty;
+    env->seed = seed;
+    env->maze = generate(*env);
+    env->done = false;
+    return env.release();
+  } catch (const std::exception& error) {
+    last_error = error.what();
+    return nullptr;
+  }
+}
+
+void maze_env_destroy(maze_env* env) {
+  delete env;
+}
+
+int maze_env_reset(maze_env* env) {
+  if (env == nullptr) {
+    last_error = "The environment is NULL.";
+    return -1;
+  }
+  try {
+    env->maze = generate(*env);
+    env->done = false;
+    return 0;
+  } catch (const std::exception& error) {
+    last_error = error.what();
+    return -1;
+  }
+}
+
+size_t maze_observation_size(uint32_t radius) {
+  const size_t side = 2 * static_cast<size_t>(radius) + 1;
+  return side * side;
+}
+
+int maze_env_observe(const maze_env* env, uint32_t radius, uint8_t* observation) {
+  if (env == nullptr || observation == nullptr) {
+    last_error = "The environment and observation buffer must not be NULL.";
+    return -1;
+  }
+  try {
+    env->maze->perceiveTiles(radius, asTiles(observation));
+    return 0;
+  } catch (const std::exception& error) {
+    last_error = error.what();
+    return -1;
+  }
+}
+
+int maze_env_step_batch(maze_env* const* envs, size_t count, const uint8_t* moves,
+                        uint32_t radius, uint8_t* observations, float* rewards, uint8_t* dones,
+                        uint32_t threads) {
+  if (count > 0 && (envs == nullptr || moves == nullptr)) {
+    last_error = "The environments and moves must not be NULL.";
+    return -1;
+  }
+  for (size_t index = 0; index < count; ++index) {
+    if (envs[index] == nullptr || moves[index] > MAZE_MOVE_DOWN) {
+      last_error = "Environment " + std::to_string(index) + " is NULL or has an invalid move.";
+      return -1;
+    }
+  }
+
+  try {
+    // The same environment twice in a batch would be stepped by two threads at once.
+    std::vector<maze_env*> sorted(envs, envs + count);
+    std::sort(sorted.begin(), sorted.end());
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+      last_error = "An environment appears more than once in the batch.";
+      return -1;
+    }
+
+    const size_t observation_size = maze_observation_size(radius);
+    maze::parallelFor(count, threads, [&](size_t index) {
+      maze_env& env = *envs[index];
+      float reward = 0.0f;
+      if (!env.done) {
+        env.maze->movePlayer(static_cast<maze::Maze::Move>(moves[index]));
+        if (env.maze->isFinished()) {
+          reward = 1.0f;
+          env.done = true;
+        } else if (env.maze->getPlayerCurrentFood() == 0) {
+          reward = -1.0f;
+          env.done = true;
+        }
+      }
+
+      if (observations != nullptr) {
+        env.maze->perceiveTiles(radius, asTiles(observations + index * observation_size));
+      }
+      if (rewards != nullptr) {
+        rewards[index] = reward;
+      }
+      if (dones != nullptr) {
+        dones[index] = env.done ? 1 : 0;
+      }
+    });
+    return 0;
+  } catch (const std::exception& error) {
+    last_error = error.what();
+    return -1;
+  }
+}
+
+const char* maze_last_error(void) {
+  return last_error.c_str();
+}
+
+}  // extern "C"
@@ -0,0 +1,311 @@
+#include <maze/parallel_bfs.hpp>
+
+// Standard
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+// Private
+#include <maze/parallel.hpp>
+
+namespace maze {
+
+namespace {
+constexpr std::size_t kWordBits = 64;
+
+// Grids with fewer cells are searched on the calling thread only.
+constexpr std::size_t kParallelCells = std::size_t(1) << 16;
+
+// Top-down levels with fewer frontier cells per thread are expanded on the calling thread only.
+constexpr std::size_t kParallelFrontier = 512;
+
+// Go bottom-up once the frontier exceeds 1 / kAlpha of the unvisited cells, and back top-down
+// once it shrinks below 1 / kBeta of all cells.
+constexpr std::size_t kAlpha = 14;
+constexpr std::size_t kBeta = 24;
+
+/**
+ * @brief A fixed set of threads that run one task after another, without being recreated.
+ *
+ * A breadth-first search on a maze can have millions of levels, so starting threads per level as
+ * parallelFor() does would cost more than the search itself.
+ */
+class WorkerTeam {
+ public:
+  /**
+   * @brief Starts the worker threads.
+   * @param threads The number of threads including the calling one.
+   */
+  explicit WorkerTeam(uint32_t threads) {
+    for (uint32_t thread = 1; thread < threads; ++thread) {
+      workers_.emplace_back([this, thread]() { work(thread); });
+    }
+  }
+
+  WorkerTeam(const WorkerTeam&) = delete;
+  WorkerTeam& operator=(const WorkerTeam&) = delete;
+
+  ~WorkerTeam() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    start_.notify_all();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  /**
+   * @brief Calls a task on every thread of the team, and waits until all calls returned.
+   * @param task The task to run, called with the index of the thread. It must not throw.
+   */
+  void run(const std::function<void(uint32_t)>& task) {
+    if (workers_.empty()) {
+      task(0);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ = &task;
+      pending_ = workers_.size();
+      ++generation_;
+    }
+    start_.notify_all();
+    task(0);
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() { return pending_ == 0; });
+  }
+
+ private:
+  /**
+   * @brief The loop of a worker thread, running every task once until the team stops.
+   * @param thread The index of the thread.
+   */
+  void work(uint32_t thread) {
+    uint64_t last_generation = 0;
+    for (;;) {
+      const std::function<void(uint32_t)>* task = nullptr;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        start_.wait(lock, [&]() { return stopping_ || generation_ != last_generation; });
+        if (stopping_) {
+          return;
+        }
+        last_generation = generation_;
+        task = task_;
+      }
+      (*task)(thread);
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--pending_ == 0) {
+        done_.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> workers_; /**< The threads besides the calling one. */
+  std::mutex mutex_; /**< Guards the members below. */
+  std::condition_variable start_; /**< Signals a new task or stopping to the workers. */
+  std::condition_variable done_; /**< Signals that the last worker finished the task. */
+  const std::function<void(uint32_t)>* task_ = nullptr; /**< The task being run. */
+  std::size_t pending_ = 0; /**< The workers still running the task. */
+  uint64_t generation_ = 0; /**< The number of tasks started. */
+  bool stopping_ = false; /**< Whether the workers should exit. */
+};
+
+bool testBit(const std::vector<uint64_t>& bits, std::size_t cell) {
+  return (bits[cell / kWordBits] >> (cell % kWordBits)) & 1;
+}
+} // namespace
+
+std::vector<uint32_t> breadthFirstDistances(const Grid& grid, const Coordinates& source,
+                                            uint16_t keys, uint32_t threads) {
+  const uint32_t rows = grid.getRows();
+  const uint32_t cols = grid.getCols();
+  if (source.row >= rows || source.col >= cols) {
+    throw std::invalid_argument("The source lies outside the grid.");
+  }
+  const std::size_t cells = static_cast<std::size_t>(rows) * cols;
+  const std::size_t words = (cells + kWordBits - 1) / kWordBits;
+  const uint32_t thread_count = cells < kParallelCells ? 1 : resolveThreadCount(threads);
+  WorkerTeam team(thread_count);
+  const auto sliceBegin = [&](std::size_t count, uint32_t thread) {
+    return count * thread / thread_count;
+  };
+
+  // Pack the passable cells into a bitmap, so that the bottom-up scans skip walls 64 at a time.
+  std::vector<uint64_t> open(words, 0);
+  std::vector<std::size_t> counts(thread_count, 0);
+  team.run([&](uint32_t thread) {
+    for (std::size_t word = sliceBegin(words, thread); word < sliceBegin(words, thread + 1);
+         ++word) {
+      const std::size_t first = word * kWordBits;
+      uint32_t row = static_cast<uint32_t>(first / cols);
+      uint32_t col = static_cast<uint32_t>(first % cols);
+      uint64_t bits = 0;
+      for (std::size_t bit = 0; bit < kWordBits && first + bit < cells; ++bit) {
+        if (isPassable(grid.get(row, col), keys)) {
+          bits |= uint64_t(1) << bit;
+          counts[thread]++;
+        }
+        if (++col == cols) {
+          col = 0;
+          ++row;
+        }
+      }
+      open[word] = bits;
+    }
+  });
+  std::size_t unvisited = 0;
+  for (const std::size_t count : counts) {
+    unvisited += count;
+  }
+
+  std::vector<uint32_t> distances(cells, kUnreachable);
+  std::vector<std::atomic<uint64_t>> visited(words);
+  const std::size_t source_cell = static_cast<std::size_t>(source.row) * cols + source.col;
+  distances[source_cell] = 0;
+  visited[source_cell / kWordBits].store(uint64_t(1) << (source_cell % kWordBits));
+  if (testBit(open, source_cell)) {
+    unvisited--;
+  }
+
+  std::vector<uint32_t> frontier = {static_cast<uint32_t>(source_cell)};
+  std::vector<std::vector<uint32_t>> next_frontiers(thread_count);
+  std::vector<uint64_t> frontier_bits(words, 0);
+  std::vector<uint64_t> next_bits(words, 0);
+  std::size_t frontier_size = 1;
+  bool bottom_up = false;
+
+  // Top-down: claim the unvisited neighbours of a slice of the frontier.
+  const auto expand = [&](uint32_t level, std::size_t begin, std::size_t end,
+                          std::vector<uint32_t>& next) {
+    const auto claim = [&](std::size_t cell) {
+      const uint64_t mask = uint64_t(1) << (cell % kWordBits);
+      std::atomic<uint64_t>& word = visited[cell / kWordBits];
+      if (testBit(open, cell) && (word.load(std::memory_order_relaxed) & mask) == 0
+          && (word.fetch_or(mask, std::memory_order_relaxed) & mask) == 0) {
+        distances[cell] = level + 1;
+        next.push_back(static_cast<uint32_t>(cell));
+      }
+    };
+    for (std::size_t index = begin; index < end; ++index) {
+      const std::size_t cell = frontier[index];
+      const uint32_t col = static_cast<uint32_t>(cell % cols);
+      if (cell >= cols) {
+        claim(cell - cols);
+      }
+      if (cell + cols < cells) {
+        claim(cell + cols);
+      }
+      if (col > 0) {
+        claim(cell - 1);
+      }
+      if (col + 1 < cols) {
+        claim(cell + 1);
+      }
+    }
+  };
+
+  for (uint32_t level = 0; frontier_size > 0; ++level) {
+    if (!bottom_up && frontier_size > unvisited / kAlpha) {
+      // Switch to bottom-up, marking the frontier cells in a bitmap.
+      bottom_up = true;
+      team.run([&](uint32_t thread) {
+        for (std::size_t word = sliceBegin(words, thread); word < sliceBegin(words, thread + 1);
+             ++word) {
+          uint64_t bits = 0;
+          for (std::size_t bit = 0; bit < kWordBits && word * kWordBits + bit < cells; ++bit) {
+            if (distances[word * kWordBits + bit] == level) {
+              bits |= uint64_t(1) << bit;
+            }
+          }
+          frontier_bits[word] = bits;
+        }
+      });
+    } else if (bottom_up && frontier_size < cells / kBeta) {
+      // Switch back to top-down, listing the frontier cells.
+      bottom_up = false;
+      team.run([&](uint32_t thread) {
+        std::vector<uint32_t>& next = next_frontiers[thread];
+        next.clear();
+        for (std::size_t word = sliceBegin(words, thread); word < sliceBegin(words, thread + 1);
+             ++word) {
+          for (std::size_t bit = 0; frontier_bits[word] != 0 && bit < kWordBits; ++bit) {
+            if ((frontier_bits[word] >> bit) & 1) {
+              next.push_back(static_cast<uint32_t>(word * kWordBits + bit));
+            }
+          }
+        }
+      });
+      frontier.clear();
+      for (const std::vector<uint32_t>& next : next_frontiers) {
+        frontier.insert(frontier.end(), next.begin(), next.end());
+      }
+    }
+
+    if (bottom_up) {
+      // Bottom-up: every unvisited cell of a thread's words looks for a parent in the frontier.
+      // Each thread only writes its own words, so no atomic read-modify-writes are needed.
+      team.run([&](uint32_t thread) {
+        std::size_t found_count = 0;
+        for (std::size_t word = sliceBegin(words, thread); word < sliceBegin(words, thread + 1);
+             ++word) {
+          const uint64_t candidates = open[word] & ~visited[word].load(std::memory_order_relaxed);
+          uint64_t found = 0;
+          for (std::size_t bit = 0; bit < kWordBits && (candidates >> bit) != 0; ++bit) {
+            if (((candidates >> bit) & 1) == 0) {
+              continue;
+            }
+            const std::size_t cell = word * kWordBits + bit;
+            const uint32_t col = static_cast<uint32_t>(cell % cols);
+            if ((cell >= cols && testBit(frontier_bits, cell - cols))
+                || (cell + cols < cells && testBit(frontier_bits, cell + cols))
+                || (col > 0 && testBit(frontier_bits, cell - 1))
+                || (col + 1 < cols && testBit(frontier_bits, cell + 1))) {
+              found |= uint64_t(1) << bit;
+              distances[cell] = level + 1;
+              found_count++;
+            }
+          }
+          next_bits[word] = found;
+          if (found != 0) {
+            visited[word].fetch_or(found, std::memory_order_relaxed);
+          }
+        }
+        counts[thread] = found_count;
+      });
+      frontier_bits.swap(next_bits);
+      frontier_size = 0;
+      for (const std::size_t count : counts) {
+        frontier_size += count;
+      }
+    } else {
+      if (thread_count == 1 || frontier_size < kParallelFrontier * thread_count) {
+        std::vector<uint32_t>& next = next_frontiers[0];
+        next.clear();
+        expand(level, 0, frontier_size, next);
+        frontier.swap(next);
+      } else {
+        team.run([&](uint32_t thread) {
+          std::vector<uint32_t>& next = next_frontiers[thread];
+          next.clear();
+          expand(level, sliceBegin(frontier_size, thread), sliceBegin(frontier_size, thread + 1),
+                 next);
+        });
+        frontier.clear();
+        for (const std::vector<uint32_t>& next : next_frontiers) {
+          frontier.insert(frontier.end(), next.begin(), next.end());
+        }
+      }
+      frontier_size = frontier.size();
+    }
+    unvisited -= frontier_size;
+  }
+  return distances;
+}
+
+}  // namespace maze
@@ -0,0 +1,144 @@
+#include <maze/placement.hpp>
+
+// Standard
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace maze {
+
+PlacementEngine::PlacementEngine(const Grid& grid, RandomGenerator& rng)
+  : grid_(grid), rng_(rng), taken_(0) {
+  for (uint32_t row = 1; row + 1 < grid_.getRows(); ++row) {
+    for (uint32_t col = 1; col + 1 < grid_.getCols(); ++col) {
+      if (grid_.get(row, col).type == TileType::EMPTY) {
+        cells_.push_back({row, col});
+      }
+    }
+  }
+}
+
+std::size_t PlacementEngine::getAvailableCount() const {
+  return cells_.size() - taken_;
+}
+
+std::vector<Coordinates> PlacementEngine::take(std::size_t count, const PlacementOptions& options,
+                                               const Coordinates& start) {
+  count = std::min(count, getAvailableCount());
+  const std::size_t first = taken_;
+
+  if (options.distribution == PlacementDistribution::UNIFORM) {
+    // Partial Fisher-Yates shuffle: swap a random remaining cell to the front of the remainder.
+    for (std::size_t i = 0; i < count; ++i) {
+      const std::size_t chosen = taken_ + rng_.below(cells_.size() - taken_);
+      std::swap(cells_[taken_], cells_[chosen]);
+      if (!weights_.empty()) {
+        std::swap(weights_[taken_], weights_[chosen]);
+      }
+      taken_++;
+    }
+  } else if (count > 0) {
+    if (weighted_for_ != options.distribution) {
+      computeWeights(options, start);
+    }
+
+    // Weighted sampling without replacement: the cells with the largest log(u) / w keys win.
+    // The uniform draws are filled in one go, 1 - u keeps them away from log(0).
+    std::vector<double> units(cells_.size() - taken_);
+    rng_.fillUnit(units.data(), units.size());
+    std::vector<std::pair<double, std::size_t>> keys;
+    keys.reserve(cells_.size() - taken_);
+    for (std::size_t index = taken_; index < cells_.size(); ++index) {
+      const double weight = weights_[index];
+      keys.push_back({weight > 0.0 ? std::log(1.0 - units[index - taken_]) / weight
+                                   : -std::numeric_limits<double>::infinity(),
+                      index});
+    }
+    std::nth_element(keys.begin(), keys.begin() + (count - 1), keys.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+    std::vector<Coordinates> reordered_cells;
+    std::vector<double> reordered_weights;
+    reordered_cells.reserve(keys.size());
+    reordered_weights.reserve(keys.size());
+    for (const auto& key : keys) {
+      reordered_cells.push_back(cells_[key.second]);
+      reordered_weights.push_back(weights_[key.second]);
+    }
+    std::copy(reordered_cells.begin(), reordered_cells.end(), cells_.begin() + taken_);
+    std::copy(reordered_weights.begin(), reordered_weights.end(), weights_.begin() + taken_);
+    taken_ += count;
+  }
+
+  return std::vector<Coordinates>(cells_.begin() + first, cells_.begin() + taken_);
+}
+
+void PlacementEngine::computeWeights(const PlacementOptions& options, const Coordinates& start) {
+  const uint32_t rows = grid_.getRows();
+  const uint32_t cols = grid_.getCols();
+  weights_.assign(cells_.size(), 1.0);
+  weighted_for_ = options.distribution;
+
+  if (options.distribution == PlacementDistribution::DISTANCE_FROM_START) {
+    // Breadth-first search from the start; unreachable cells keep the smallest weight.
+    std::vector<uint32_t> distances(static_cast<std::size_t>(rows) * cols,
+                                    std::numeric_limits<uint32_t>::max());
+    std::queue<Coordinates> open;
+    distances[static_cast<std::size_t>(start.row) * cols + start.col] = 0;
+    open.push(start);
+    while (!open.empty()) {
+      const Coordinates current = open.front();
+      open.pop();
+      const uint32_t distance = distances[static_cast<std::size_t>(current.row) * cols + current.col];
+      const Coordinates neighbors[] = {{current.row - 1, current.col},
+                                       {current.row + 1, current.col},
+                                       {current.row, current.col - 1},
+                                       {current.row, current.col + 1}};
+      for (const Coordinates& neighbor : neighbors) {
+        if (neighbor.row >= rows || neighbor.col >= cols ||
+            !isPassable(grid_.get(neighbor.row, neighbor.col).type)) {
+          continue;
+        }
+        uint32_t& neighbor_distance = distances[static_cast<std::size_t>(neighbor.row) * cols
+                                                + neighbor.col];
+        if (neighbor_distance == std::numeric_limits<uint32_t>::max()) {
+          neighbor_distance = distance + 1;
+          open.push(neighbor);
+        }
+      }
+    }
+
+    for (std::size_t index = 0; index < cells_.size(); ++index) {
+      const uint32_t distance =
+          distances[static_cast<std::size_t>(cells_[index].row) * cols + cells_[index].col];
+      if (distance != std::numeric_limits<uint32_t>::max()) {
+        weights_[index] = distance + 1.0;
+      }
+    }
+  } else if (options.distribution == PlacementDistribution::CLUSTERED) {
+    // Gaussian falloff around the nearest of a few random centres, with a small floor so that
+    // every cell stays eligible once the clusters are full.
+    const double radius = options.cluster_radius > 0.0
+                              ? options.cluster_radius
+                              : std::max(1.0, std::max(rows, cols) / 10.0);
+    std::vector<Coordinates> centres;
+    const std::size_t remaining = cells_.size() - taken_;
+    for (uint32_t i = 0; i < options.cluster_count && remaining > 0; ++i) {
+      centres.push_back(cells_[taken_ + rng_.below(remaining)]);
+    }
+
+    for (std::size_t index = 0; index < cells_.size(); ++index) {
+      double nearest = std::numeric_limits<double>::infinity();
+      for (const Coordinates& centre : centres) {
+        const double delta_row = static_cast<double>(cells_[index].row) - centre.row;
+        const double delta_col = static_cast<double>(cells_[index].col) - centre.col;
+        nearest = std::min(nearest, delta_row * delta_row + delta_col * delta_col);
+      }
+      weights_[index] = std::exp(-nearest / (2.0 * radius * radius)) + 1e-6;
+    }
+  }
+}
+
+}  // namespace maze
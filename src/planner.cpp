@@ -0,0 +1,293 @@
+#include <maze/planner.hpp>
+
+// Standard
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace maze {
+
+namespace {
+constexpr uint32_t kInfinity = std::numeric_limits<uint32_t>::max() / 4;
+
+uint32_t addCost(uint32_t distance, uint32_t cost) {
+  return distance >= kInfinity ? kInfinity : distance + cost;
+}
+} // namespace
+
+IncrementalPlanner::IncrementalPlanner(uint32_t rows, uint32_t cols, const Coordinates& start,
+                                       const Coordinates& goal)
+  : rows_(rows), cols_(cols), key_modifier_(0), expanded_(0), keys_(0) {
+  if (start.row >= rows || start.col >= cols || goal.row >= rows || goal.col >= cols) {
+    throw std::invalid_argument("The start and goal need to be inside of the maze.");
+  }
+  const std::size_t size = static_cast<std::size_t>(rows) * cols;
+  start_ = start.row * cols + start.col;
+  last_start_ = start_;
+  goal_ = goal.row * cols + goal.col;
+  knowledge_.assign(size, Knowledge::UNKNOWN);
+  g_.assign(size, kInfinity);
+  rhs_.assign(size, kInfinity);
+  queued_keys_.resize(size);
+  queued_.assign(size, false);
+
+  rhs_[goal_] = 0;
+  queued_keys_[goal_] = calculateKey(goal_);
+  queued_[goal_] = true;
+  queue_.push({queued_keys_[goal_], goal_});
+}
+
+void IncrementalPlanner::setStart(const Coordinates& start) {
+  start_ = start.row * cols_ + start.col;
+}
+
+bool IncrementalPlanner::setKnowledge(const Coordinates& pos, Knowledge knowledge) {
+  const uint32_t cell = pos.row * cols_ + pos.col;
+  const Knowledge previous = knowledge_[cell];
+  if (previous == knowledge) {
+    return false;
+  }
+  knowledge_[cell] = knowledge;
+  if ((previous == Knowledge::BLOCKED) == (knowledge == Knowledge::BLOCKED)) {
+    return true;
+  }
+
+  // Fold the agent moves since the last change into the key modifier, so that queued keys stay
+  // valid lower bounds without re-keying the queue.
+  key_modifier_ += heuristic(last_start_, start_);
+  last_start_ = start_;
+
+  // Only the edges around the cell changed.
+  updateVertex(cell);
+  const uint32_t row = cell / cols_;
+  const uint32_t col = cell % cols_;
+  if (row > 0) {
+    updateVertex(cell - cols_);
+  }
+  if (row + 1 < rows_) {
+    updateVertex(cell + cols_);
+  }
+  if (col > 0) {
+    updateVertex(cell - 1);
+  }
+  if (col + 1 < cols_) {
+    updateVertex(cell + 1);
+  }
+  return true;
+}
+
+uint32_t IncrementalPlanner::setKeys(uint16_t keys) {
+  keys_ = keys;
+  uint32_t changed = 0;
+  for (const auto& [cell, colour] : door_colours_) {
+    const Knowledge knowledge =
+        ((keys_ >> colour) & 1) ? Knowledge::PASSABLE : Knowledge::BLOCKED;
+    if (setKnowledge({cell / cols_, cell % cols_}, knowledge)) {
+      ++changed;
+    }
+  }
+  return changed;
+}
+
+uint32_t IncrementalPlanner::observe(const Coordinates& center,
+                                     const std::vector<std::vector<Maze::PerceivedTile>>& window) {
+  const int64_t radius = static_cast<int64_t>(window.size()) / 2;
+  uint32_t changed = 0;
+  for (std::size_t rel_row = 0; rel_row < window.size(); ++rel_row) {
+    const int64_t row = static_cast<int64_t>(center.row) - radius + static_cast<int64_t>(rel_row);
+    if (row < 0 || row >= rows_) {
+      continue;
+    }
+    for (std::size_t rel_col = 0; rel_col < window[rel_row].size(); ++rel_col) {
+      const int64_t col = static_cast<int64_t>(center.col) - radius + static_cast<int64_t>(rel_col);
+      if (col < 0 || col >= cols_) {
+        continue;
+      }
+
+      const uint32_t cell = static_cast<uint32_t>(row) * cols_ + static_cast<uint32_t>(col);
+      const Maze::PerceivedTile tile = window[rel_row][rel_col];
+      const uint32_t door_colour =
+          static_cast<uint32_t>(tile) - static_cast<uint32_t>(Maze::PerceivedTile::LOCKED_DOOR);
+      if (door_colour < kKeyColours) {
+        // Remembered, so that the door opens once setKeys() hands over its key.
+        door_colours_[cell] = door_colour;
+      } else if (tile != Maze::PerceivedTile::UNKNOWN && !door_colours_.empty()) {
+        door_colours_.erase(cell);
+      }
+
+      Knowledge knowledge;
+      switch (tile) {
+      case Maze::PerceivedTile::UNKNOWN:
+        continue;
+      case Maze::PerceivedTile::WALL:
+        knowledge = Knowledge::BLOCKED;
+        break;
+      case Maze::PerceivedTile::FOOD:
+        knowledge = Knowledge::FOOD;
+        break;
+      default:
+        knowledge = door_colour < kKeyColours && !((keys_ >> door_colour) & 1)
+                        ? Knowledge::BLOCKED
+                        : Knowledge::PASSABLE;
+        break;
+      }
+      if (setKnowledge({static_cast<uint32_t>(row), static_cast<uint32_t>(col)}, knowledge)) {
+        ++changed;
+      }
+    }
+  }
+  return changed;
+}
+
+std::optional<std::vector<Maze::Move>> IncrementalPlanner::plan() {
+  computeShortestPath();
+  if (g_[start_] >= kInfinity) {
+    return std::nullopt;
+  }
+
+  // Follow the steepest descent of the distances, which is a shortest path on the known map.
+  std::vector<Maze::Move> moves;
+  uint32_t cell = start_;
+  while (cell != goal_) {
+    uint32_t neighbors[4];
+    const uint32_t neighbor_count = getNeighbors(cell, neighbors);
+    uint32_t best = cell;
+    uint32_t best_distance = kInfinity;
+    for (uint32_t i = 0; i < neighbor_count; ++i) {
+      if (g_[neighbors[i]] < best_distance) {
+        best = neighbors[i];
+        best_distance = g_[neighbors[i]];
+      }
+    }
+    if (best == cell || moves.size() >= g_.size()) {
+      return std::nullopt;
+    }
+
+    if (best == cell - cols_) {
+      moves.push_back(Maze::Move::UP);
+    } else if (best == cell + cols_) {
+      moves.push_back(Maze::Move::DOWN);
+    } else if (best == cell - 1) {
+      moves.push_back(Maze::Move::LEFT);
+    } else {
+      moves.push_back(Maze::Move::RIGHT);
+    }
+    cell = best;
+  }
+  return moves;
+}
+
+IncrementalPlanner::Knowledge IncrementalPlanner::getKnowledge(const Coordinates& pos) const {
+  return knowledge_[pos.row * cols_ + pos.col];
+}
+
+uint64_t IncrementalPlanner::getExpandedCount() const {
+  return expanded_;
+}
+
+IncrementalPlanner::Key IncrementalPlanner::calculateKey(uint32_t cell) const {
+  const uint32_t distance = std::min(g_[cell], rhs_[cell]);
+  return {addCost(distance, heuristic(start_, cell) + key_modifier_), distance};
+}
+
+void IncrementalPlanner::updateVertex(uint32_t cell) {
+  if (cell != goal_) {
+    uint32_t best = kInfinity;
+    if (knowledge_[cell] != Knowledge::BLOCKED) {
+      uint32_t neighbors[4];
+      const uint32_t neighbor_count = getNeighbors(cell, neighbors);
+      for (uint32_t i = 0; i < neighbor_count; ++i) {
+        best = std::min(best, addCost(g_[neighbors[i]], 1));
+      }
+    }
+    rhs_[cell] = best;
+  }
+
+  // Queue entries are removed lazily, a cell is only live with the key it was last queued with.
+  queued_[cell] = false;
+  if (g_[cell] != rhs_[cell]) {
+    queued_keys_[cell] = calculateKey(cell);
+    queued_[cell] = true;
+    queue_.push({queued_keys_[cell], cell});
+  }
+}
+
+void IncrementalPlanner::computeShortestPath() {
+  key_modifier_ += heuristic(last_start_, start_);
+  last_start_ = start_;
+
+  dropStaleEntries();
+  while (!queue_.empty()
+         && (queue_.top().first < calculateKey(start_) || rhs_[start_] != g_[start_])) {
+    const auto [old_key, cell] = queue_.top();
+    queue_.pop();
+    queued_[cell] = false;
+    ++expanded_;
+
+    const Key new_key = calculateKey(cell);
+    uint32_t neighbors[4];
+    const uint32_t neighbor_count = getNeighbors(cell, neighbors);
+    if (old_key < new_key) {
+      queued_keys_[cell] = new_key;
+      queued_[cell] = true;
+      queue_.push({new_key, cell});
+    } else if (g_[cell] > rhs_[cell]) {
+      g_[cell] = rhs_[cell];
+      for (uint32_t i = 0; i < neighbor_count; ++i) {
+        updateVertex(neighbors[i]);
+      }
+    } else {
+      g_[cell] = kInfinity;
+      updateVertex(cell);
+      for (uint32_t i = 0; i < neighbor_count; ++i) {
+        updateVertex(neighbors[i]);
+      }
+    }
+    dropStaleEntries();
+  }
+}
+
+void IncrementalPlanner::dropStaleEntries() {
+  while (!queue_.empty()) {
+    const auto& [key, cell] = queue_.top();
+    if (queued_[cell] && queued_keys_[cell] == key) {
+      return;
+    }
+    queue_.pop();
+  }
+}
+
+uint32_t IncrementalPlanner::getNeighbors(uint32_t cell, uint32_t (&neighbors)[4]) const {
+  const uint32_t row = cell / cols_;
+  const uint32_t col = cell % cols_;
+  uint32_t count = 0;
+  const auto add = [&](uint32_t neighbor) {
+    if (knowledge_[neighbor] != Knowledge::BLOCKED) {
+      neighbors[count++] = neighbor;
+    }
+  };
+  if (row > 0) {
+    add(cell - cols_);
+  }
+  if (row + 1 < rows_) {
+    add(cell + cols_);
+  }
+  if (col > 0) {
+    add(cell - 1);
+  }
+  if (col + 1 < cols_) {
+    add(cell + 1);
+  }
+  return count;
+}
+
+uint32_t IncrementalPlanner::heuristic(uint32_t first, uint32_t second) const {
+  const uint32_t first_row = first / cols_;
+  const uint32_t first_col = first % cols_;
+  const uint32_t second_row = second / cols_;
+  const uint32_t second_col = second % cols_;
+  return (first_row > second_row ? first_row - second_row : second_row - first_row)
+         + (first_col > second_col ? first_col - second_col : second_col - first_col);
+}
+
+}  // namespace maze
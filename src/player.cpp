@@ -3,7 +3,7 @@
 namespace maze {
 
 Player::Player(uint32_t maxWeight)
-  : maxWeight(maxWeight), currentWeight(maxWeight)
+  : maxWeight(maxWeight), currentWeight(maxWeight), keys(0)
 {
 }
 
@@ -15,7 +15,8 @@ void Player::pickFood(uint32_t weight) {
 }
 
 bool Player::consumeFood(uint32_t amount) {
-  currentWeight -= amount;
+  // Terrain can cost more than the food left, so the amount never drops below zero.
+  currentWeight -= amount < currentWeight ? amount : currentWeight;
   return currentWeight > 0;
 }
 
@@ -23,4 +24,12 @@ uint32_t Player::getCurrentFood() const {
   return currentWeight;
 }
 
+void Player::pickKey(uint32_t colour) {
+  keys |= static_cast<uint16_t>(1u << colour);
+}
+
+uint16_t Player::getKeys() const {
+  return keys;
+}
+
 } // namespace maze
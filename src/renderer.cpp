@@ -0,0 +1,227 @@
+#include <maze/renderer.hpp>
+
+// Standard
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+// Private
+#include <maze/parallel.hpp>
+
+namespace maze {
+
+namespace {
+// The rows of a band rendered by one thread in render().
+constexpr uint32_t kBandRows = 64;
+
+// Per shade, in the order of MazeRenderer::Shade: wall, empty, food, door, key, mud, water,
+// start, end, player and path.
+constexpr char kCharacters[] = {'#', '.', 'F', 'D', 'K', 'M', 'W', 'o', 'O', 'X', '*'};
+constexpr uint8_t kGreys[] = {0, 255, 170, 90, 210, 120, 60, 40, 40, 20, 150};
+constexpr uint8_t kColours[][3] = {{0, 0, 0},     {255, 255, 255}, {60, 180, 75},  {140, 90, 40},
+                                   {240, 200, 0}, {120, 90, 60},   {50, 110, 220}, {220, 40, 40},
+                                   {220, 40, 40}, {200, 0, 200},   {255, 140, 0}};
+
+std::string getHeader(RenderFormat format, std::size_t width, std::size_t height) {
+  if (format == RenderFormat::ASCII) {
+    return "";
+  }
+  return std::string(format == RenderFormat::PGM ? "P5\n" : "P6\n") + std::to_string(width) + " "
+         + std::to_string(height) + "\n255\n";
+}
+} // namespace
+
+MazeRenderer::MazeRenderer(const Maze& maze, RenderOptions options)
+  : maze_(maze), grid_(maze.getGrid()), player_pos_(maze.getPlayerPosition()),
+    start_pos_(maze.getStartPosition()), end_pos_(maze.getEndPosition()),
+    options_(std::move(options)),
+    channels_(options_.format == RenderFormat::ASCII ? 0
+              : options_.format == RenderFormat::PGM ? 1 : 3) {
+  if (options_.scale == 0) {
+    throw std::invalid_argument("The render scale must be positive.");
+  }
+  if (options_.format == RenderFormat::ASCII) {
+    options_.scale = 1;
+  }
+
+  const uint32_t cols = maze_.getCols();
+  if (!options_.path.empty()) {
+    path_cells_.assign((static_cast<std::size_t>(maze_.getRows()) * cols + 63) / 64, 0);
+    Coordinates pos = player_pos_;
+    for (const Maze::Move move : options_.path) {
+      // Wrapping below zero leaves the grid just like running past its end.
+      switch (move) {
+      case Maze::Move::UP:
+        pos.row--;
+        break;
+      case Maze::Move::DOWN:
+        pos.row++;
+        break;
+      case Maze::Move::LEFT:
+        pos.col--;
+        break;
+      case Maze::Move::RIGHT:
+        pos.col++;
+        break;
+      }
+      if (pos.row >= maze_.getRows() || pos.col >= cols) {
+        break;
+      }
+      const std::size_t cell = static_cast<std::size_t>(pos.row) * cols + pos.col;
+      path_cells_[cell / 64] |= uint64_t(1) << (cell % 64);
+    }
+  }
+  if (options_.sight_radius) {
+    const std::size_t window = 2 * static_cast<std::size_t>(*options_.sight_radius) + 1;
+    perceived_.resize(window * window);
+    maze_.perceiveTiles(*options_.sight_radius, perceived_.data());
+  }
+}
+
+std::size_t MazeRenderer::getHeaderSize() const {
+  return getHeader(options_.format, static_cast<std::size_t>(maze_.getCols()) * options_.scale,
+                   static_cast<std::size_t>(maze_.getRows()) * options_.scale)
+      .size();
+}
+
+std::size_t MazeRenderer::getRowSize() const {
+  if (options_.format == RenderFormat::ASCII) {
+    return static_cast<std::size_t>(maze_.getCols()) + 1;
+  }
+  return static_cast<std::size_t>(maze_.getCols()) * options_.scale * options_.scale * channels_;
+}
+
+std::size_t MazeRenderer::getSize() const {
+  return getHeaderSize() + getRowSize() * maze_.getRows();
+}
+
+void MazeRenderer::renderHeader(char* out) const {
+  const std::string header =
+      getHeader(options_.format, static_cast<std::size_t>(maze_.getCols()) * options_.scale,
+                static_cast<std::size_t>(maze_.getRows()) * options_.scale);
+  std::memcpy(out, header.data(), header.size());
+}
+
+void MazeRenderer::renderRows(uint32_t first_row, uint32_t count, char* out) const {
+  const uint32_t cols = maze_.getCols();
+  const uint32_t scale = options_.scale;
+  const std::size_t pixel_row_size = static_cast<std::size_t>(cols) * scale * channels_;
+  for (uint32_t row = first_row; row < first_row + count; ++row) {
+    char* row_out = out + static_cast<std::size_t>(row - first_row) * getRowSize();
+    char* pixel = row_out;
+    for (uint32_t col = 0; col < cols; ++col) {
+      const Shade shade = getShade(row, col);
+      const bool perceived = isPerceived(row, col);
+      if (options_.format == RenderFormat::ASCII) {
+        *pixel++ = perceived ? kCharacters[shade] : ' ';
+        continue;
+      }
+      // Unperceived cells fade to a quarter of their brightness.
+      const uint8_t* colour = options_.format == RenderFormat::PGM ? &kGreys[shade]
+                                                                    : kColours[shade];
+      for (uint32_t repeat = 0; repeat < scale; ++repeat) {
+        for (uint32_t channel = 0; channel < channels_; ++channel) {
+          *pixel++ = static_cast<char>(perceived ? colour[channel] : colour[channel] / 4);
+        }
+      }
+    }
+    if (options_.format == RenderFormat::ASCII) {
+      *pixel = '\n';
+      continue;
+    }
+    // The other pixel rows of the cell row repeat the first one.
+    for (uint32_t repeat = 1; repeat < scale; ++repeat) {
+      std::memcpy(row_out + repeat * pixel_row_size, row_out, pixel_row_size);
+    }
+  }
+}
+
+void MazeRenderer::render(char* out) const {
+  renderHeader(out);
+  char* rows_out = out + getHeaderSize();
+  const uint32_t rows = maze_.getRows();
+  const uint32_t bands = (rows + kBandRows - 1) / kBandRows;
+  parallelFor(bands, options_.threads, [&](std::size_t band) {
+    const uint32_t first_row = static_cast<uint32_t>(band) * kBandRows;
+    renderRows(first_row, std::min(kBandRows, rows - first_row),
+               rows_out + first_row * getRowSize());
+  });
+}
+
+std::string MazeRenderer::render() const {
+  std::string rendered(getSize(), '\0');
+  render(&rendered[0]);
+  return rendered;
+}
+
+void MazeRenderer::write(std::ostream& out, uint32_t band_rows) const {
+  band_rows = std::max<uint32_t>(band_rows, 1);
+  std::vector<char> buffer(std::max(getHeaderSize(), getRowSize() * band_rows));
+  renderHeader(buffer.data());
+  out.write(buffer.data(), static_cast<std::streamsize>(getHeaderSize()));
+
+  const uint32_t rows = maze_.getRows();
+  for (uint32_t first_row = 0; first_row < rows; first_row += band_rows) {
+    const uint32_t count = std::min(band_rows, rows - first_row);
+    const uint32_t bands = (count + kBandRows - 1) / kBandRows;
+    parallelFor(bands, options_.threads, [&](std::size_t band) {
+      const uint32_t offset = static_cast<uint32_t>(band) * kBandRows;
+      renderRows(first_row + offset, std::min(kBandRows, count - offset),
+                 buffer.data() + offset * getRowSize());
+    });
+    out.write(buffer.data(), static_cast<std::streamsize>(count * getRowSize()));
+  }
+}
+
+MazeRenderer::Shade MazeRenderer::getShade(uint32_t row, uint32_t col) const {
+  const Coordinates pos = {row, col};
+  if (pos == player_pos_) {
+    return PLAYER;
+  }
+  if (pos == start_pos_) {
+    return START;
+  }
+  if (pos == end_pos_) {
+    return END;
+  }
+  if (!path_cells_.empty()) {
+    const std::size_t cell = static_cast<std::size_t>(row) * maze_.getCols() + col;
+    if ((path_cells_[cell / 64] >> (cell % 64)) & 1) {
+      return PATH;
+    }
+  }
+  switch (grid_.get(row, col).type) {
+  case TileType::WALL:
+    return WALL;
+  case TileType::DOOR:
+    return DOOR;
+  case TileType::FOOD:
+    return FOOD;
+  case TileType::KEY:
+    return KEY;
+  case TileType::MUD:
+    return MUD;
+  case TileType::WATER:
+    return WATER;
+  case TileType::EMPTY:
+    break;
+  }
+  return EMPTY;
+}
+
+bool MazeRenderer::isPerceived(uint32_t row, uint32_t col) const {
+  if (!options_.sight_radius) {
+    return true;
+  }
+  const uint32_t radius = *options_.sight_radius;
+  // Offsets outside the window wrap around to large values and fail the bound check.
+  const uint32_t window_row = row + radius - player_pos_.row;
+  const uint32_t window_col = col + radius - player_pos_.col;
+  const uint32_t window = 2 * radius + 1;
+  return window_row < window && window_col < window
+         && perceived_[static_cast<std::size_t>(window_row) * window + window_col]
+                != Maze::PerceivedTile::UNKNOWN;
+}
+
+}  // namespace maze
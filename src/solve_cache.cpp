@@ -0,0 +1,66 @@
+#include <maze/solve_cache.hpp>
+
+// Standard
+#include <stdexcept>
+
+namespace maze {
+
+SolveCache::SolveCache(std::size_t capacity) : capacity_(capacity), hits_(0), misses_(0) {
+  if (capacity == 0) {
+    throw std::invalid_argument("A solve cache needs a capacity of at least one result.");
+  }
+}
+
+std::shared_ptr<const SolveCache::Result> SolveCache::find(uint64_t key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++misses_;
+    return nullptr;
+  }
+  ++hits_;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->second;
+}
+
+void SolveCache::insert(uint64_t key, Result result) {
+  auto shared = std::make_shared<const Result>(std::move(result));
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = index_.find(key);
+  if (it != index_.end()) {
+    it->second->second = std::move(shared);
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return;
+  }
+  if (entries_.size() == capacity_) {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+  entries_.emplace_front(key, std::move(shared));
+  index_.emplace(key, entries_.begin());
+}
+
+void SolveCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+}
+
+std::size_t SolveCache::getSize() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+std::size_t SolveCache::getCapacity() const {
+  return capacity_;
+}
+
+uint64_t SolveCache::getHits() const {
+  return hits_;
+}
+
+uint64_t SolveCache::getMisses() const {
+  return misses_;
+}
+
+}  // namespace maze
@@ -14,12 +14,50 @@ std::unique_ptr<Tile> WallTile::clone() const {
   return std::make_unique<WallTile>(*this);
 }
 
-bool DoorTile::isPassable() const { return true; }
+TerrainTile::TerrainTile(uint32_t cost) : cost(cost) {}
+
+bool TerrainTile::isPassable() const { return true; }
+
+uint32_t TerrainTile::getCost() const { return cost; }
+
+MudTile::MudTile(uint32_t cost) : TerrainTile(cost) {}
+
+std::unique_ptr<Tile> MudTile::clone() const {
+  return std::make_unique<MudTile>(*this);
+}
+
+WaterTile::WaterTile(uint32_t cost) : TerrainTile(cost) {}
+
+std::unique_ptr<Tile> WaterTile::clone() const {
+  return std::make_unique<WaterTile>(*this);
+}
+
+DoorTile::DoorTile() : locked(false), colour(0) {}
+
+DoorTile::DoorTile(uint32_t colour) : locked(true), colour(colour) {}
+
+bool DoorTile::isPassable() const { return !locked; }
+
+bool DoorTile::isPassable(uint16_t keys) const { return !locked || ((keys >> colour) & 1); }
+
+bool DoorTile::isLocked() const { return locked; }
+
+uint32_t DoorTile::getColour() const { return colour; }
 
 std::unique_ptr<Tile> DoorTile::clone() const {
   return std::make_unique<DoorTile>(*this);
 }
 
+KeyTile::KeyTile(uint32_t colour) : colour(colour) {}
+
+bool KeyTile::isPassable() const { return true; }
+
+uint32_t KeyTile::getColour() const { return colour; }
+
+std::unique_ptr<Tile> KeyTile::clone() const {
+  return std::make_unique<KeyTile>(*this);
+}
+
 FoodTile::FoodTile(uint32_t weight) : weight(weight) {}
 
 bool FoodTile::isPassable() const { return true; }
@@ -0,0 +1,144 @@
+#include <maze/trajectory.hpp>
+
+// Standard
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+// Private
+#include <maze/game_state.hpp>
+#include <maze/parallel.hpp>
+
+namespace maze {
+
+namespace {
+constexpr uint8_t kMagic[4] = {'M', 'Z', 'T', '1'};
+constexpr std::size_t kHeaderSize = 17;
+
+ReplayResult replay(const Layout& layout, const Coordinates& start,
+                    const Trajectory& trajectory) {
+  ReplayResult result;
+  result.maze_found = true;
+
+  visitInitialState(layout, [&](auto state) {
+    state.position = start;
+    state.food = Maze::kMaxFood;
+    state.keys = 0;
+    for (std::size_t index = 0; index < trajectory.size() && !isTerminal(layout, state);
+         ++index) {
+      ++result.moves_replayed;
+      applyMove(layout, state, trajectory.getMove(index));
+    }
+    result.final_position = state.position;
+    result.food = state.food;
+  });
+
+  if (result.final_position == layout.getEndPosition()) {
+    result.outcome = TrajectoryOutcome::REACHED_END;
+  } else if (result.food == 0) {
+    result.outcome = TrajectoryOutcome::STARVED;
+  }
+  result.matches_recording = result.outcome == trajectory.getOutcome();
+  return result;
+}
+} // namespace
+
+Trajectory::Trajectory(uint64_t layout_hash)
+  : layout_hash_(layout_hash), outcome_(TrajectoryOutcome::UNFINISHED), size_(0) {
+}
+
+void Trajectory::append(Maze::Move move) {
+  if (size_ % 4 == 0) {
+    packed_moves_.push_back(0);
+  }
+  packed_moves_.back() |= static_cast<uint8_t>(static_cast<uint8_t>(move) << (2 * (size_ % 4)));
+  ++size_;
+}
+
+Maze::Move Trajectory::getMove(std::size_t index) const {
+  return static_cast<Maze::Move>((packed_moves_[index / 4] >> (2 * (index % 4))) & 3);
+}
+
+std::size_t Trajectory::size() const {
+  return size_;
+}
+
+uint64_t Trajectory::getLayoutHash() const {
+  return layout_hash_;
+}
+
+TrajectoryOutcome Trajectory::getOutcome() const {
+  return outcome_;
+}
+
+void Trajectory::setOutcome(TrajectoryOutcome outcome) {
+  outcome_ = outcome;
+}
+
+std::vector<uint8_t> Trajectory::serialize() const {
+  std::vector<uint8_t> bytes(kMagic, kMagic + 4);
+  bytes.reserve(kHeaderSize + packed_moves_.size());
+  for (uint32_t shift = 0; shift < 64; shift += 8) {
+    bytes.push_back(static_cast<uint8_t>(layout_hash_ >> shift));
+  }
+  for (uint32_t shift = 0; shift < 32; shift += 8) {
+    bytes.push_back(static_cast<uint8_t>(size_ >> shift));
+  }
+  bytes.push_back(static_cast<uint8_t>(outcome_));
+  bytes.insert(bytes.end(), packed_moves_.begin(), packed_moves_.end());
+  return bytes;
+}
+
+Trajectory Trajectory::deserialize(const std::vector<uint8_t>& bytes) {
+  if (bytes.size() < kHeaderSize || !std::equal(kMagic, kMagic + 4, bytes.begin())) {
+    throw std::invalid_argument("The bytes do not start with a trajectory header.");
+  }
+
+  uint64_t layout_hash = 0;
+  for (uint32_t byte = 0; byte < 8; ++byte) {
+    layout_hash |= static_cast<uint64_t>(bytes[4 + byte]) << (8 * byte);
+  }
+  uint32_t size = 0;
+  for (uint32_t byte = 0; byte < 4; ++byte) {
+    size |= static_cast<uint32_t>(bytes[12 + byte]) << (8 * byte);
+  }
+  if (bytes[16] > static_cast<uint8_t>(TrajectoryOutcome::STARVED)
+      || bytes.size() != kHeaderSize + (static_cast<std::size_t>(size) + 3) / 4) {
+    throw std::invalid_argument("The trajectory header does not match its moves.");
+  }
+
+  Trajectory trajectory(layout_hash);
+  trajectory.outcome_ = static_cast<TrajectoryOutcome>(bytes[16]);
+  trajectory.size_ = size;
+  trajectory.packed_moves_.assign(bytes.begin() + kHeaderSize, bytes.end());
+  return trajectory;
+}
+
+std::vector<ReplayResult> replayTrajectories(const std::vector<const Maze*>& mazes,
+                                             const std::vector<Trajectory>& trajectories,
+                                             uint32_t threads) {
+  // Layouts are shared by all trajectories of a maze, each replay only keeps its own state.
+  std::unordered_map<uint64_t, const Maze*> mazes_by_hash;
+  for (const Maze* maze : mazes) {
+    mazes_by_hash.emplace(maze->getLayoutHash(), maze);
+  }
+  std::unordered_map<uint64_t, Layout> layouts;
+  for (const Trajectory& trajectory : trajectories) {
+    const auto it = mazes_by_hash.find(trajectory.getLayoutHash());
+    if (it != mazes_by_hash.end()) {
+      layouts.try_emplace(it->first, *it->second);
+    }
+  }
+
+  std::vector<ReplayResult> results(trajectories.size());
+  parallelFor(trajectories.size(), threads, [&](std::size_t index) {
+    const auto it = layouts.find(trajectories[index].getLayoutHash());
+    if (it != layouts.end()) {
+      results[index] = replay(it->second, mazes_by_hash.at(it->first)->getStartPosition(),
+                              trajectories[index]);
+    }
+  });
+  return results;
+}
+
+}  // namespace maze
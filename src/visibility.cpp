@@ -0,0 +1,98 @@
+#include <maze/visibility.hpp>
+
+// Standard
+#include <algorithm>
+#include <stdexcept>
+
+// Private
+#include <maze/maze.hpp>
+#include <maze/parallel.hpp>
+
+namespace maze {
+
+VisibilityIndex::VisibilityIndex(const Maze& maze, uint32_t radius, uint32_t threads)
+  : radius_(radius), rows_(maze.getRows()), cols_(maze.getCols()) {
+  if (radius > 32767) {
+    throw std::invalid_argument("The sight radius of a visibility index is at most 32767.");
+  }
+
+  // Every row of viewers is indexed on its own, then the rows are concatenated.
+  std::vector<std::vector<VisibleRun>> row_runs(rows_);
+  std::vector<std::vector<uint32_t>> row_counts(rows_);
+  const int64_t squared_radius = static_cast<int64_t>(radius) * radius;
+  const int64_t signed_radius = radius;
+  parallelFor(rows_, threads, [&](std::size_t viewer_row) {
+    std::vector<VisibleRun>& runs = row_runs[viewer_row];
+    std::vector<uint32_t>& counts = row_counts[viewer_row];
+    counts.assign(cols_, 0);
+    for (uint32_t viewer_col = 0; viewer_col < cols_; ++viewer_col) {
+      if (!isPassable(maze.getCell(static_cast<uint32_t>(viewer_row), viewer_col).type)) {
+        continue;
+      }
+      const Coordinates viewer = {static_cast<uint32_t>(viewer_row), viewer_col};
+      const std::size_t first_run = runs.size();
+      for (int64_t row_offset = -signed_radius; row_offset <= signed_radius; ++row_offset) {
+        const int64_t row = static_cast<int64_t>(viewer_row) + row_offset;
+        if (row < 0 || row >= rows_) {
+          continue;
+        }
+        bool in_run = false;
+        for (int64_t col_offset = -signed_radius; col_offset <= signed_radius; ++col_offset) {
+          const int64_t col = static_cast<int64_t>(viewer_col) + col_offset;
+          const bool visible =
+              col >= 0 && col < cols_
+              && row_offset * row_offset + col_offset * col_offset <= squared_radius
+              && maze.hasLineOfSight(viewer, {static_cast<uint32_t>(row),
+                                              static_cast<uint32_t>(col)});
+          if (visible && in_run) {
+            ++runs.back().length;
+          } else if (visible) {
+            runs.push_back({static_cast<int16_t>(row_offset), static_cast<int16_t>(col_offset), 1});
+          }
+          in_run = visible;
+        }
+      }
+      counts[viewer_col] = static_cast<uint32_t>(runs.size() - first_run);
+    }
+  });
+
+  offsets_.resize(static_cast<std::size_t>(rows_) * cols_ + 1);
+  offsets_[0] = 0;
+  for (uint32_t row = 0; row < rows_; ++row) {
+    for (uint32_t col = 0; col < cols_; ++col) {
+      const std::size_t cell = static_cast<std::size_t>(row) * cols_ + col;
+      offsets_[cell + 1] = offsets_[cell] + row_counts[row][col];
+    }
+  }
+  runs_.resize(offsets_.back());
+  parallelFor(rows_, threads, [&](std::size_t row) {
+    std::copy(row_runs[row].begin(), row_runs[row].end(),
+              runs_.begin() + static_cast<std::ptrdiff_t>(offsets_[row * cols_]));
+  });
+}
+
+uint32_t VisibilityIndex::getRadius() const {
+  return radius_;
+}
+
+uint32_t VisibilityIndex::getRows() const {
+  return rows_;
+}
+
+uint32_t VisibilityIndex::getCols() const {
+  return cols_;
+}
+
+const VisibleRun* VisibilityIndex::getRunsBegin(const Coordinates& viewer) const {
+  return runs_.data() + offsets_[static_cast<std::size_t>(viewer.row) * cols_ + viewer.col];
+}
+
+const VisibleRun* VisibilityIndex::getRunsEnd(const Coordinates& viewer) const {
+  return runs_.data() + offsets_[static_cast<std::size_t>(viewer.row) * cols_ + viewer.col + 1];
+}
+
+std::size_t VisibilityIndex::getRunCount() const {
+  return runs_.size();
+}
+
+}  // namespace maze
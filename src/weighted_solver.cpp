@@ -0,0 +1,86 @@
+#include <maze/weighted_solver.hpp>
+
+// Standard
+#include <algorithm>
+#include <limits>
+
+// Private
+#include <maze/radix_heap.hpp>
+
+namespace maze {
+
+std::optional<WeightedPath> solveWeighted(const Maze& maze) {
+  constexpr uint32_t kUnreached = std::numeric_limits<uint32_t>::max();
+  const uint32_t rows = maze.getRows();
+  const uint32_t cols = maze.getCols();
+  const uint16_t keys = maze.getPlayerKeys();
+  const Coordinates start_pos = maze.getPlayerPosition();
+  const Coordinates end_pos = maze.getEndPosition();
+  const uint32_t start = start_pos.row * cols + start_pos.col;
+  const uint32_t end = end_pos.row * cols + end_pos.col;
+
+  std::vector<uint32_t> costs(static_cast<std::size_t>(rows) * cols, kUnreached);
+  std::vector<uint32_t> parents(costs.size());
+  RadixHeap<uint32_t> heap;
+  costs[start] = 0;
+  heap.push(0, start);
+  while (!heap.empty()) {
+    const auto [cost, cell] = heap.pop();
+    if (cost != costs[cell]) {
+      continue;
+    }
+    if (cell == end) {
+      break;
+    }
+
+    const uint32_t row = cell / cols;
+    const uint32_t col = cell % cols;
+    const auto relax = [&, cost = cost, cell = cell](uint32_t next_row, uint32_t next_col) {
+      const Cell tile = maze.getCell(next_row, next_col);
+      if (!isPassable(tile, keys)) {
+        return;
+      }
+      const uint32_t next = next_row * cols + next_col;
+      const uint32_t next_cost = cost + getMoveCost(tile);
+      if (next_cost < costs[next]) {
+        costs[next] = next_cost;
+        parents[next] = cell;
+        heap.push(next_cost, next);
+      }
+    };
+    if (row > 0) {
+      relax(row - 1, col);
+    }
+    if (row + 1 < rows) {
+      relax(row + 1, col);
+    }
+    if (col > 0) {
+      relax(row, col - 1);
+    }
+    if (col + 1 < cols) {
+      relax(row, col + 1);
+    }
+  }
+  if (costs[end] == kUnreached) {
+    return std::nullopt;
+  }
+
+  WeightedPath path;
+  path.cost = costs[end];
+  for (uint32_t cell = end; cell != start; cell = parents[cell]) {
+    const uint32_t parent = parents[cell];
+    if (parent == cell + cols) {
+      path.moves.push_back(Maze::Move::UP);
+    } else if (cell == parent + cols) {
+      path.moves.push_back(Maze::Move::DOWN);
+    } else if (parent == cell + 1) {
+      path.moves.push_back(Maze::Move::LEFT);
+    } else {
+      path.moves.push_back(Maze::Move::RIGHT);
+    }
+  }
+  std::reverse(path.moves.begin(), path.moves.end());
+  return path;
+}
+
+}  // namespace maze
@@ -0,0 +1,41 @@
+#include <catch2/catch.hpp>
+
+#include <maze/analytics.hpp>
+#include <maze/maze.hpp>
+
+TEST_CASE("analytics") {
+  using namespace maze;
+  const std::vector<std::vector<Maze::PerceivedTile>> layout = {
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL},
+    {Maze::PerceivedTile::START, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::FOOD, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::WALL},
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::WALL, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::WALL},
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::WALL, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::END},
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL}
+  };
+
+  SECTION("The metrics of a layout are computed correctly") {
+    const Maze layouted_maze(layout);
+
+    const MazeAnalytics analytics = analyzeMaze(layouted_maze, 1);
+
+    REQUIRE(analytics.passable_cells == 9);
+    REQUIRE(analytics.dead_ends == 3);
+    REQUIRE(analytics.junctions == 1);
+    REQUIRE(analytics.corridor_lengths == std::vector<uint32_t>{0, 1, 0, 0, 1});
+    REQUIRE(analytics.shortest_path_length == 6u);
+    REQUIRE(analytics.food_on_path == 1);
+    REQUIRE(analytics.reachable_food == 1);
+    REQUIRE(analytics.visible_from_start == 4);
+  }
+
+  SECTION("Cached metrics are refreshed when the layout changes") {
+    Maze layouted_maze(layout);
+    REQUIRE(layouted_maze.getAnalytics(1).reachable_food == 1);
+    REQUIRE(&layouted_maze.getAnalytics(1) == &layouted_maze.getAnalytics(1));
+
+    layouted_maze.movePlayer(Maze::Move::RIGHT);
+    layouted_maze.movePlayer(Maze::Move::RIGHT);
+
+    REQUIRE(layouted_maze.getAnalytics(1).reachable_food == 0);
+  }
+}
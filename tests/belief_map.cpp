@@ -0,0 +1,79 @@
+#include <catch2/catch.hpp>
+
+#include <maze/belief_map.hpp>
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+
+TEST_CASE("belief_map") {
+  using namespace maze;
+
+  SECTION("Merging a window updates tiles and the frontier") {
+    BeliefMap belief(5, 5);
+    const std::vector<std::vector<Maze::PerceivedTile>> window = {
+      {Maze::PerceivedTile::UNKNOWN, Maze::PerceivedTile::WALL, Maze::PerceivedTile::UNKNOWN},
+      {Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::EMPTY},
+      {Maze::PerceivedTile::UNKNOWN, Maze::PerceivedTile::WALL, Maze::PerceivedTile::UNKNOWN}
+    };
+
+    REQUIRE(belief.merge({2, 2}, window) == 5);
+    REQUIRE(belief.getKnownCount() == 5);
+    REQUIRE(belief.getTile({1, 2}) == Maze::PerceivedTile::WALL);
+    REQUIRE(belief.getFrontier().size() == 2);
+    REQUIRE(belief.isFrontier({2, 1}));
+    REQUIRE(belief.isFrontier({2, 3}));
+    REQUIRE_FALSE(belief.isFrontier({2, 2}));
+
+    const auto nearest = belief.findNearestFrontier({2, 2});
+    REQUIRE(nearest);
+    REQUIRE(nearest->moves.size() == 1);
+
+    // Seeing the same window again changes nothing.
+    REQUIRE(belief.merge({2, 2}, window) == 0);
+  }
+
+  SECTION("Locked doors are only passable with their key") {
+    BeliefMap belief(3, 4);
+    const std::vector<std::vector<Maze::PerceivedTile>> window = {
+      {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL},
+      {Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::EMPTY, Maze::perceivedLockedDoor(2)},
+      {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL}
+    };
+
+    belief.merge({1, 1}, window);
+    REQUIRE(belief.getFrontier().empty());
+    REQUIRE_FALSE(belief.findNearestFrontier({1, 0}));
+
+    belief.setKeys(1u << 2);
+    REQUIRE(belief.isFrontier({1, 2}));
+    const auto nearest = belief.findNearestFrontier({1, 0});
+    REQUIRE(nearest);
+    REQUIRE(nearest->moves == std::vector<Maze::Move>(2, Maze::Move::RIGHT));
+
+    belief.setKeys(1u << 1);
+    REQUIRE(belief.getFrontier().empty());
+  }
+
+  SECTION("A frontier agent explores every reachable cell") {
+    GenerationOptions options;
+    options.seed = 5;
+    Maze generated(25, 25, 0.0, options);
+    BeliefMap belief(generated.getRows(), generated.getCols());
+
+    uint32_t steps = 0;
+    while (steps < 5000) {
+      belief.merge(generated.getPlayerPosition(), generated.perceiveTiles(2));
+      const auto nearest = belief.findNearestFrontier(generated.getPlayerPosition());
+      if (!nearest) {
+        break;
+      }
+      if (nearest->moves.empty()) {
+        // Guards against a frontier cell whose unknown neighbours stay out of sight.
+        break;
+      }
+      REQUIRE(generated.movePlayer(nearest->moves.front()));
+      ++steps;
+    }
+
+    REQUIRE(belief.getTile(generated.getEndPosition()) == Maze::PerceivedTile::END);
+  }
+}
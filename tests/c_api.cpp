@@ -0,0 +1,58 @@
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <maze/maze_c.h>
+
+TEST_CASE("c_api") {
+  SECTION("A batch of environments is stepped into caller buffers") {
+    std::vector<maze_env*> envs;
+    for (uint64_t seed = 0; seed < 8; ++seed) {
+      envs.push_back(maze_env_create(11, 11, 0.0, seed));
+      REQUIRE(envs.back() != nullptr);
+    }
+
+    const uint32_t radius = 2;
+    const std::size_t observation_size = maze_observation_size(radius);
+    REQUIRE(observation_size == 25);
+
+    std::vector<uint8_t> moves(envs.size(), MAZE_MOVE_RIGHT);
+    std::vector<uint8_t> observations(envs.size() * observation_size);
+    std::vector<float> rewards(envs.size(), 5.0f);
+    std::vector<uint8_t> dones(envs.size(), 5);
+    REQUIRE(maze_env_step_batch(envs.data(), envs.size(), moves.data(), radius,
+                                observations.data(), rewards.data(), dones.data(), 2) == 0);
+
+    std::vector<uint8_t> observation(observation_size);
+    for (std::size_t index = 0; index < envs.size(); ++index) {
+      REQUIRE(rewards[index] == 0.0f);
+      REQUIRE(dones[index] == 0);
+      REQUIRE(maze_env_observe(envs[index], radius, observation.data()) == 0);
+      REQUIRE(std::memcmp(observation.data(), &observations[index * observation_size],
+                          observation_size) == 0);
+      REQUIRE(observation[observation_size / 2] != MAZE_TILE_WALL);
+    }
+
+    for (maze_env* env : envs) {
+      REQUIRE(maze_env_reset(env) == 0);
+      maze_env_destroy(env);
+    }
+  }
+
+  SECTION("Failures are reported") {
+    REQUIRE(maze_env_create(1, 1, 0.0, 0) == nullptr);
+    REQUIRE(std::strlen(maze_last_error()) > 0);
+
+    maze_env* env = maze_env_create(5, 5, 0.0, 0);
+    const uint8_t move = 7;
+    REQUIRE(maze_env_step_batch(&env, 1, &move, 1, nullptr, nullptr, nullptr, 1) < 0);
+
+    maze_env* const twice[] = {env, env};
+    const uint8_t moves[] = {MAZE_MOVE_LEFT, MAZE_MOVE_RIGHT};
+    REQUIRE(maze_env_step_batch(twice, 2, moves, 1, nullptr, nullptr, nullptr, 2) < 0);
+    REQUIRE(std::string(maze_last_error()).find("more than once") != std::string::npos);
+    maze_env_destroy(env);
+  }
+}
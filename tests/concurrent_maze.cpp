@@ -0,0 +1,141 @@
+#include <catch2/catch.hpp>
+
+#include <maze/concurrent_maze.hpp>
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+
+// Standard
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("concurrent_maze") {
+  using namespace maze;
+
+  GenerationOptions options;
+  options.seed = 8;
+  Maze generated(31, 31, 0.0, options);
+
+  SECTION("A guard keeps its version while newer ones are published") {
+    ConcurrentMaze shared(generated, 4);
+    REQUIRE(shared.getVersion() == 0);
+    const std::vector<Maze::Move> moves = generated.solve();
+
+    ConcurrentMaze::ReadGuard pinned = shared.read();
+    REQUIRE(pinned.getVersion() == 0);
+    REQUIRE(pinned->getPlayerPosition() == generated.getPlayerPosition());
+
+    for (const Maze::Move move : moves) {
+      REQUIRE(shared.movePlayer(move));
+    }
+    REQUIRE(shared.getVersion() == moves.size());
+    REQUIRE(shared.getRetiredCount() == moves.size());
+    REQUIRE(pinned->getPlayerPosition() == generated.getPlayerPosition());
+    REQUIRE_FALSE(pinned->isFinished());
+
+    {
+      const ConcurrentMaze::ReadGuard latest = shared.read();
+      REQUIRE(latest.getVersion() == moves.size());
+      REQUIRE(latest->isFinished());
+      REQUIRE(latest->getPlayerPosition() == shared.getWriterMaze().getPlayerPosition());
+    }
+
+    // Releasing the guard lets the next publication reclaim everything retired.
+    pinned = shared.read();
+    REQUIRE(pinned.getVersion() == moves.size());
+    shared.update([](Maze&) {});
+    REQUIRE(shared.getRetiredCount() == 1);
+  }
+
+  SECTION("Failed changes publish nothing") {
+    ConcurrentMaze shared(generated, 1);
+    const Coordinates start = generated.getPlayerPosition();
+    REQUIRE_THROWS_AS(shared.setTileType(start.row, start.col, TileType::WALL),
+                      std::invalid_argument);
+    REQUIRE(shared.getVersion() == 0);
+
+    shared.setTileType(0, 0, TileType::EMPTY);
+    REQUIRE(shared.getVersion() == 1);
+    REQUIRE(shared.read()->getCell(0, 0).type == TileType::EMPTY);
+    REQUIRE_THROWS_AS(ConcurrentMaze(generated, 0), std::invalid_argument);
+  }
+
+  SECTION("Readers only ever see published states, in order") {
+    Maze replay(generated);
+    std::vector<Maze::Move> moves = replay.solve();
+    std::vector<Coordinates> positions = {replay.getPlayerPosition()};
+    for (const Maze::Move move : moves) {
+      replay.movePlayer(move);
+      positions.push_back(replay.getPlayerPosition());
+    }
+
+    // More readers than slots, so some of them have to wait for a slot now and then.
+    ConcurrentMaze shared(generated, 3);
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> errors(0);
+    std::vector<std::thread> readers;
+    for (int reader = 0; reader < 4; ++reader) {
+      readers.emplace_back([&]() {
+        uint64_t last = 0;
+        while (!done.load()) {
+          const ConcurrentMaze::ReadGuard guard = shared.read();
+          const uint64_t version = guard.getVersion();
+          if (version < last || version >= positions.size()
+              || guard->getPlayerPosition() != positions[version]
+              || guard->getStateHash() == 0) {
+            ++errors;
+          }
+          last = version;
+        }
+      });
+    }
+    for (const Maze::Move move : moves) {
+      shared.movePlayer(move);
+      std::this_thread::yield();
+    }
+    done.store(true);
+    for (std::thread& reader : readers) {
+      reader.join();
+    }
+
+    REQUIRE(errors.load() == 0);
+    REQUIRE(shared.read()->isFinished());
+    shared.update([](Maze&) {});
+    REQUIRE(shared.getRetiredCount() == 0);
+  }
+
+  SECTION("Versions keep the cells they were published with") {
+    // Large enough for the grid to be split into several shared chunks.
+    const Maze large(201, 201, 0.0, options);
+    ConcurrentMaze shared(large, 2);
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> errors(0);
+    std::vector<std::thread> readers;
+    for (int reader = 0; reader < 2; ++reader) {
+      readers.emplace_back([&]() {
+        while (!done.load()) {
+          const ConcurrentMaze::ReadGuard guard = shared.read();
+          // Version v turned the border cell of row v into food worth v.
+          const uint32_t version = static_cast<uint32_t>(guard.getVersion());
+          if ((version > 0 && guard->getCell(version, 0) != Cell{TileType::FOOD,
+                                                                 static_cast<uint8_t>(version)})
+              || (version < 100 && guard->getCell(version + 1, 0).type != TileType::WALL)) {
+            ++errors;
+          }
+        }
+      });
+    }
+    for (uint32_t row = 1; row < 100; ++row) {
+      shared.setTileType(row, 0, TileType::FOOD, static_cast<uint8_t>(row));
+      std::this_thread::yield();
+    }
+    done.store(true);
+    for (std::thread& reader : readers) {
+      reader.join();
+    }
+
+    REQUIRE(errors.load() == 0);
+    REQUIRE(large.getCell(50, 0).type == TileType::WALL);
+  }
+}
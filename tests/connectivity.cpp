@@ -0,0 +1,95 @@
+#include <catch2/catch.hpp>
+
+#include <maze/connectivity.hpp>
+#include <maze/generation.hpp>
+#include <maze/hashing.hpp>
+#include <maze/maze.hpp>
+#include <maze/parallel_bfs.hpp>
+#include <maze/random.hpp>
+
+// Standard
+#include <limits>
+#include <stdexcept>
+
+TEST_CASE("connectivity") {
+  using namespace maze;
+
+  SECTION("Connectivity matches a fresh search after every change") {
+    Grid grid(24, 24);
+    RandomGenerator rng(11);
+    for (uint32_t row = 0; row < grid.getRows(); ++row) {
+      for (uint32_t col = 0; col < grid.getCols(); ++col) {
+        if (rng.below(100) < 40) {
+          grid.set(row, col, {TileType::WALL, 0});
+        }
+      }
+    }
+    DynamicConnectivity connectivity(grid);
+    for (int change = 0; change < 400; ++change) {
+      const Coordinates pos = {static_cast<uint32_t>(rng.below(24)),
+                               static_cast<uint32_t>(rng.below(24))};
+      const bool open = !connectivity.isOpen(pos);
+      grid.set(pos.row, pos.col, {open ? TileType::EMPTY : TileType::WALL, 0});
+      connectivity.setOpen(pos, open);
+
+      const Coordinates source = {static_cast<uint32_t>(rng.below(24)),
+                                  static_cast<uint32_t>(rng.below(24))};
+      const std::vector<uint32_t> distances = breadthFirstDistances(grid, source, 0, 1);
+      uint32_t component = 0;
+      for (uint32_t row = 0; row < 24; ++row) {
+        for (uint32_t col = 0; col < 24; ++col) {
+          const bool reachable = connectivity.isOpen(source) && connectivity.isOpen({row, col})
+                                 && distances[row * 24 + col] != kUnreachable;
+          REQUIRE(connectivity.isConnected(source, {row, col}) == reachable);
+          component += reachable;
+        }
+      }
+      REQUIRE(connectivity.getComponentSize(source) == component);
+    }
+  }
+
+  SECTION("Changing tiles keeps the maze consistent") {
+    GenerationOptions options;
+    options.seed = 5;
+    options.placement.food_density = 0.05;
+    Maze generated(21, 21, 0.0, options);
+    generated.setConnectivityTracking(true);
+    const Maze copy(generated);
+    REQUIRE(generated.isReachable(generated.getEndPosition()));
+    REQUIRE(generated.isSolvable());
+
+    // Wall the end off from its only open neighbour.
+    const Coordinates end = generated.getEndPosition();
+    const Coordinates inside = {end.row == 0 ? 1 : end.row == 20 ? 19 : end.row,
+                                end.col == 0 ? 1 : end.col == 20 ? 19 : end.col};
+    generated.setTileType(inside.row, inside.col, TileType::WALL);
+    REQUIRE_FALSE(generated.isReachable(end));
+    REQUIRE_FALSE(generated.isSolvable());
+    REQUIRE(generated.getLayoutHash()
+            == hashLayout(generated.getGrid(), generated.getStartPosition(), end));
+    REQUIRE(copy.isReachable(end));
+
+    generated.setTileType(inside.row, inside.col, TileType::MUD, 4);
+    REQUIRE(generated.getCell(inside.row, inside.col) == Cell{TileType::MUD, 4});
+    REQUIRE(generated.isReachable(end));
+    REQUIRE(generated.isSolvable());
+    REQUIRE(generated.getLayoutHash()
+            == hashLayout(generated.getGrid(), generated.getStartPosition(), end));
+
+    const Coordinates player = generated.getPlayerPosition();
+    REQUIRE_THROWS_AS(generated.setTileType(player.row, player.col, TileType::WALL),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(generated.setTileType(21, 0, TileType::EMPTY), std::invalid_argument);
+    REQUIRE_THROWS_AS(generated.setTileType(inside.row, inside.col, TileType::KEY, 0),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(generated.setTileType(inside.row, inside.col, TileType::KEY,
+                                            kKeyColours + 1),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(generated.setTileType(inside.row, inside.col, TileType::DOOR, 200),
+                      std::invalid_argument);
+    REQUIRE(generated.getCell(inside.row, inside.col) == Cell{TileType::MUD, 4});
+    REQUIRE_THROWS_AS(Maze::perceivedKey(kKeyColours), std::invalid_argument);
+    REQUIRE_THROWS_AS(Maze::perceivedLockedDoor(std::numeric_limits<uint32_t>::max()),
+                      std::invalid_argument);
+  }
+}
@@ -0,0 +1,124 @@
+#include <catch2/catch.hpp>
+
+#include <maze/eller_generator.hpp>
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+
+// Standard
+#include <map>
+#include <queue>
+#include <vector>
+
+TEST_CASE("eller_generator") {
+  SECTION("Rows are emitted in order and with the maze width") {
+    const maze::EllerGenerator generator(24, 17, 0.4, 8);
+
+    uint32_t expected_row = 0;
+    generator.generate([&](uint32_t row, const std::vector<maze::Cell>& cells) {
+      REQUIRE(row == expected_row);
+      REQUIRE(cells.size() == 17);
+      expected_row++;
+    });
+
+    REQUIRE(expected_row == 24);
+  }
+
+  SECTION("Without difficulty the streamed maze is perfect") {
+    const uint32_t rows = 31;
+    const uint32_t cols = 45;
+    const maze::EllerGenerator generator(rows, cols, 0.0, 77);
+    maze::Grid grid(rows, cols);
+    generator.generate(grid);
+
+    uint32_t passable = 0;
+    for (uint32_t row = 0; row < rows; ++row) {
+      for (uint32_t col = 0; col < cols; ++col) {
+        passable += maze::isPassable(grid.get(row, col).type) ? 1 : 0;
+      }
+    }
+
+    // Count the cells reachable from the start.
+    const maze::Coordinates start = generator.getStartPosition();
+    std::vector<bool> reached(rows * cols, false);
+    std::queue<maze::Coordinates> open;
+    open.push(start);
+    reached[start.row * cols + start.col] = true;
+    uint32_t reachable = 0;
+    while (!open.empty()) {
+      const maze::Coordinates current = open.front();
+      open.pop();
+      reachable++;
+      const maze::Coordinates neighbors[] = {{current.row - 1, current.col},
+                                             {current.row + 1, current.col},
+                                             {current.row, current.col - 1},
+                                             {current.row, current.col + 1}};
+      for (const maze::Coordinates& neighbor : neighbors) {
+        if (neighbor.row >= rows || neighbor.col >= cols ||
+            reached[neighbor.row * cols + neighbor.col] ||
+            !maze::isPassable(grid.get(neighbor.row, neighbor.col).type)) {
+          continue;
+        }
+        reached[neighbor.row * cols + neighbor.col] = true;
+        open.push(neighbor);
+      }
+    }
+
+    const uint32_t rooms = 15 * 22;
+    REQUIRE(passable == 2 * rooms - 1 + 2);
+    REQUIRE(reachable == passable);
+    REQUIRE(reached[generator.getEndPosition().row * cols + generator.getEndPosition().col]);
+  }
+
+  SECTION("Items are placed with the counts of generateMaze") {
+    maze::PlacementOptions densities;
+    densities.food_density = 0.03;
+    densities.door_density = 0.01;
+    densities.mud_density = 0.02;
+    densities.water_density = 0.01;
+    for (const maze::PlacementOptions& placement : {maze::PlacementOptions(), densities}) {
+      maze::GenerationOptions options;
+      options.seed = 12;
+      options.placement = placement;
+      const maze::Maze generated(101, 101, 0.5, options);
+      const maze::EllerGenerator generator(101, 101, 0.5, 12, placement);
+      maze::Grid streamed(101, 101);
+      generator.generate(streamed);
+
+      const auto count = [](const maze::Grid& grid) {
+        std::map<maze::TileType, uint32_t> counts;
+        for (uint32_t row = 0; row < grid.getRows(); ++row) {
+          for (uint32_t col = 0; col < grid.getCols(); ++col) {
+            counts[grid.get(row, col).type]++;
+          }
+        }
+        return counts;
+      };
+      const std::map<maze::TileType, uint32_t> expected = count(generated.getGrid());
+      const std::map<maze::TileType, uint32_t> actual = count(streamed);
+      for (const maze::TileType type :
+           {maze::TileType::WALL, maze::TileType::FOOD, maze::TileType::DOOR,
+            maze::TileType::MUD, maze::TileType::WATER}) {
+        REQUIRE(actual.count(type) == expected.count(type));
+        if (expected.count(type) != 0) {
+          REQUIRE(actual.at(type) == expected.at(type));
+        }
+      }
+    }
+  }
+
+  SECTION("The same seed streams the same maze") {
+    const maze::EllerGenerator first(40, 40, 0.5, 3);
+    const maze::EllerGenerator second(40, 40, 0.5, 3);
+    maze::Grid first_grid(40, 40);
+    maze::Grid second_grid(40, 40);
+    first.generate(first_grid);
+    second.generate(second_grid);
+
+    REQUIRE(first.getStartPosition() == second.getStartPosition());
+    for (uint32_t row = 0; row < 40; ++row) {
+      for (uint32_t col = 0; col < 40; ++col) {
+        REQUIRE(first_grid.get(row, col) == second_grid.get(row, col));
+      }
+    }
+  }
+}
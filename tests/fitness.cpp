@@ -0,0 +1,60 @@
+#include <catch2/catch.hpp>
+
+#include <maze/fitness.hpp>
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+
+TEST_CASE("fitness") {
+  using namespace maze;
+  const std::vector<std::vector<Maze::PerceivedTile>> layout = {
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL},
+    {Maze::PerceivedTile::START, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::FOOD, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::END},
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL}
+  };
+
+  SECTION("Candidates are scored like played games") {
+    const Maze layouted_maze(layout);
+    const std::vector<std::vector<Maze::Move>> candidates = {
+      {Maze::Move::RIGHT, Maze::Move::RIGHT, Maze::Move::RIGHT, Maze::Move::RIGHT,
+       Maze::Move::LEFT},
+      {Maze::Move::UP, Maze::Move::RIGHT, Maze::Move::RIGHT, Maze::Move::LEFT,
+       Maze::Move::RIGHT},
+      {}
+    };
+
+    const auto results = evaluateCandidates(layouted_maze, candidates, 2);
+
+    REQUIRE(results.size() == 3);
+    REQUIRE(results[0].reached_goal);
+    REQUIRE(results[0].steps_survived == 4);
+    REQUIRE(results[0].food_collected == 1);
+    REQUIRE(results[0].distance_to_goal == 0u);
+
+    // The food is only eaten once, even when the candidate walks over it again.
+    REQUIRE_FALSE(results[1].reached_goal);
+    REQUIRE(results[1].steps_survived == 5);
+    REQUIRE(results[1].food_collected == 1);
+    REQUIRE(results[1].distance_to_goal == 2u);
+
+    REQUIRE(results[2].steps_survived == 0);
+    REQUIRE(results[2].food == Maze::kMaxFood);
+    REQUIRE(results[2].distance_to_goal == 4u);
+  }
+
+  SECTION("Results agree with moving the player") {
+    GenerationOptions options;
+    options.seed = 2;
+    options.placement.food_density = 0.05;
+    Maze generated(15, 15, 0.0, options);
+    const std::vector<Maze::Move> path = generated.solve();
+
+    const auto results = evaluateCandidates(generated, {path});
+    for (const Maze::Move move : path) {
+      generated.movePlayer(move);
+    }
+
+    REQUIRE(results[0].reached_goal);
+    REQUIRE(results[0].steps_survived == path.size());
+    REQUIRE(results[0].food == generated.getPlayerCurrentFood());
+  }
+}
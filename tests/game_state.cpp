@@ -0,0 +1,78 @@
+#include <catch2/catch.hpp>
+
+#include <maze/game_state.hpp>
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+
+// Standard
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+TEST_CASE("game_state") {
+  using namespace maze;
+
+  SECTION("Stepping follows the rules of moving the player") {
+    GenerationOptions options;
+    options.seed = 4;
+    options.placement.food_density = 0.05;
+    Maze generated(21, 21, 0.0, options);
+    const Layout layout(generated);
+    REQUIRE(layout.getFoodCount() > 0);
+
+    GameState state = layout.getInitialState();
+    const std::vector<Maze::Move> moves = {Maze::Move::RIGHT, Maze::Move::DOWN, Maze::Move::LEFT,
+                                           Maze::Move::UP};
+    for (uint32_t index = 0; index < 400; ++index) {
+      const Maze::Move move = moves[(index * 7 + index / 3) % moves.size()];
+      state = step(layout, state, move);
+      generated.movePlayer(move);
+      REQUIRE(state.position == generated.getPlayerPosition());
+      REQUIRE(state.food == generated.getPlayerCurrentFood());
+    }
+  }
+
+  SECTION("Large layouts pick a state type with enough capacity") {
+    GenerationOptions options;
+    options.seed = 6;
+    Maze generated(101, 101, 0.2, options);
+    const Layout layout(generated);
+    REQUIRE(layout.getFoodCount() > GameState::kMaxFoodTiles);
+    REQUIRE_THROWS_AS(layout.getInitialState(), std::invalid_argument);
+
+    const std::vector<Maze::Move> moves = generated.solve();
+    LargeGameState large = layout.getInitialState<LargeGameState>();
+    const bool trivial = visitInitialState(layout, [&](auto state) {
+      for (const Maze::Move move : moves) {
+        state = step(layout, state, move);
+        large = step(layout, large, move);
+        generated.movePlayer(move);
+        REQUIRE(state.position == generated.getPlayerPosition());
+        REQUIRE(state.food == generated.getPlayerCurrentFood());
+        REQUIRE(large.food == state.food);
+      }
+      REQUIRE(isTerminal(layout, state));
+      return std::is_trivially_copyable<decltype(state)>::value;
+    });
+    REQUIRE(trivial);
+  }
+
+  SECTION("Branches do not affect each other") {
+    const std::vector<std::vector<Maze::PerceivedTile>> corridor = {
+      {Maze::PerceivedTile::START, Maze::PerceivedTile::FOOD, Maze::PerceivedTile::END}
+    };
+    const Maze layouted_maze(corridor);
+    const Layout layout(layouted_maze);
+
+    const GameState root = layout.getInitialState();
+    const GameState eaten = step(layout, root, Maze::Move::RIGHT);
+    const GameState blocked = step(layout, root, Maze::Move::UP);
+
+    REQUIRE(eaten.isEaten(0));
+    REQUIRE_FALSE(root.isEaten(0));
+    REQUIRE(blocked.position == root.position);
+    REQUIRE(blocked.food == root.food);
+    REQUIRE_FALSE(isTerminal(layout, eaten));
+    REQUIRE(isTerminal(layout, step(layout, eaten, Maze::Move::RIGHT)));
+  }
+}
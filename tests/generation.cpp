@@ -0,0 +1,132 @@
+#include <catch2/catch.hpp>
+
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+
+// Standard
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+/**
+ * @brief A carver that fails on the last region of the maze.
+ */
+class FailingCarver : public maze::Carver {
+ public:
+  void carve(maze::Grid& grid, const maze::RoomRegion& region,
+             maze::RandomGenerator& rng) const override {
+    if (2 * (region.first_row + region.rows) + 1 >= grid.getRows()
+        && 2 * (region.first_col + region.cols) + 1 >= grid.getCols()) {
+      throw std::runtime_error("The carver failed.");
+    }
+    maze::makeCarver(maze::GenerationAlgorithm::PRIM)->carve(grid, region, rng);
+  }
+};
+
+uint32_t countPassable(const maze::Grid& grid) {
+  uint32_t count = 0;
+  for (uint32_t row = 0; row < grid.getRows(); ++row) {
+    for (uint32_t col = 0; col < grid.getCols(); ++col) {
+      count += maze::isPassable(grid.get(row, col).type) ? 1 : 0;
+    }
+  }
+  return count;
+}
+
+uint32_t countReachable(const maze::Grid& grid, uint32_t row, uint32_t col) {
+  std::vector<bool> reached(static_cast<std::size_t>(grid.getRows()) * grid.getCols(), false);
+  std::queue<std::pair<uint32_t, uint32_t>> open;
+  open.push({row, col});
+  reached[row * grid.getCols() + col] = true;
+  uint32_t count = 0;
+  while (!open.empty()) {
+    const auto [current_row, current_col] = open.front();
+    open.pop();
+    count++;
+    const std::pair<uint32_t, uint32_t> neighbors[] = {{current_row - 1, current_col},
+                                                       {current_row + 1, current_col},
+                                                       {current_row, current_col - 1},
+                                                       {current_row, current_col + 1}};
+    for (const auto& [next_row, next_col] : neighbors) {
+      if (next_row >= grid.getRows() || next_col >= grid.getCols() ||
+          reached[next_row * grid.getCols() + next_col] ||
+          !maze::isPassable(grid.get(next_row, next_col).type)) {
+        continue;
+      }
+      reached[next_row * grid.getCols() + next_col] = true;
+      open.push({next_row, next_col});
+    }
+  }
+  return count;
+}
+}  // namespace
+
+TEST_CASE("generation") {
+  SECTION("A carved maze is perfect for every algorithm, also when carved in regions") {
+    for (maze::GenerationAlgorithm algorithm :
+         {maze::GenerationAlgorithm::RECURSIVE_BACKTRACKER, maze::GenerationAlgorithm::KRUSKAL,
+          maze::GenerationAlgorithm::PRIM, maze::GenerationAlgorithm::WILSON}) {
+      for (uint32_t region_size : {0u, 8u, 10u}) {
+        maze::Grid grid(41, 57);
+        maze::GenerationOptions options;
+        options.algorithm = algorithm;
+        options.region_size = region_size;
+        options.threads = 3;
+
+        maze::carvePerfectMaze(grid, 1234, options);
+
+        // A spanning tree over 20 x 28 rooms opens every room plus one wall per tree edge.
+        const uint32_t rooms = 20 * 28;
+        REQUIRE(countPassable(grid) == rooms + rooms - 1);
+        REQUIRE(countReachable(grid, 1, 1) == rooms + rooms - 1);
+      }
+    }
+  }
+
+  SECTION("Carving in regions does not depend on the number of threads") {
+    maze::GenerationOptions options;
+    options.region_size = 16;
+
+    options.threads = 1;
+    maze::Grid single_threaded(101, 77);
+    maze::carvePerfectMaze(single_threaded, 99, options);
+
+    options.threads = 4;
+    maze::Grid multi_threaded(101, 77);
+    maze::carvePerfectMaze(multi_threaded, 99, options);
+
+    for (uint32_t row = 0; row < 101; ++row) {
+      for (uint32_t col = 0; col < 77; ++col) {
+        REQUIRE(single_threaded.get(row, col) == multi_threaded.get(row, col));
+      }
+    }
+  }
+
+  SECTION("Errors of a carver reach the caller, also from other threads") {
+    maze::GenerationOptions options;
+    options.region_size = 16;
+    options.carver = std::make_shared<FailingCarver>();
+    for (const uint32_t threads : {1u, 4u}) {
+      options.threads = threads;
+      REQUIRE_THROWS_AS(maze::Maze(101, 77, 0.0, options), std::runtime_error);
+    }
+  }
+
+  SECTION("A maze generated from a seed is reproducible") {
+    maze::GenerationOptions options;
+    options.seed = 5;
+
+    maze::Maze first(31, 31, 0.3, options);
+    maze::Maze second(31, 31, 0.3, options);
+
+    REQUIRE(first.getStartPosition() == second.getStartPosition());
+    REQUIRE(first.getEndPosition() == second.getEndPosition());
+    for (uint32_t row = 0; row < 31; ++row) {
+      for (uint32_t col = 0; col < 31; ++col) {
+        REQUIRE(first.getCell(row, col) == second.getCell(row, col));
+      }
+    }
+  }
+}
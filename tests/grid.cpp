@@ -0,0 +1,133 @@
+#include <catch2/catch.hpp>
+
+#include <maze/grid.hpp>
+#include <maze/maze.hpp>
+
+// Standard
+#include <cstdio>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+TEST_CASE("grid") {
+  SECTION("A tiled grid maps every cell to a distinct storage offset") {
+    maze::GridStorage storage;
+    storage.layout = maze::GridLayout::TILED;
+    maze::Grid grid(70, 45, storage);
+
+    std::set<std::size_t> offsets;
+    for (uint32_t row = 0; row < grid.getRows(); ++row) {
+      for (uint32_t col = 0; col < grid.getCols(); ++col) {
+        offsets.insert(grid.index(row, col));
+      }
+    }
+
+    REQUIRE(offsets.size() == 70 * 45);
+    REQUIRE(grid.index(0, 0) == 0);
+    REQUIRE(grid.index(0, 1) == 1);
+    REQUIRE(grid.index(1, 0) == 2);
+    REQUIRE(grid.index(1, 1) == 3);
+  }
+
+  SECTION("Cells written to a grid are read back in every layout") {
+    for (maze::GridLayout layout : {maze::GridLayout::ROW_MAJOR, maze::GridLayout::TILED}) {
+      maze::GridStorage storage;
+      storage.layout = layout;
+      maze::Grid grid(33, 65, storage);
+      grid.set(32, 64, {maze::TileType::FOOD, 17});
+      grid.set(31, 33, {maze::TileType::WALL, 0});
+
+      const maze::Grid copy = grid;
+
+      REQUIRE(copy.get(32, 64) == maze::Cell{maze::TileType::FOOD, 17});
+      REQUIRE(copy.get(31, 33) == maze::Cell{maze::TileType::WALL, 0});
+      REQUIRE(copy.get(0, 0) == maze::Cell{maze::TileType::EMPTY, 0});
+    }
+  }
+
+  SECTION("Copies keep their own cells when either of them is written") {
+    for (maze::GridLayout layout : {maze::GridLayout::ROW_MAJOR, maze::GridLayout::TILED}) {
+      maze::GridStorage storage;
+      storage.layout = layout;
+      maze::Grid original(130, 130, storage);
+      original.set(0, 0, {maze::TileType::WALL, 0});
+      original.set(129, 129, {maze::TileType::FOOD, 3});
+
+      maze::Grid copy = original;
+      const maze::Grid second = copy;
+      copy.set(0, 0, {maze::TileType::FOOD, 5});
+      original.set(129, 129, {maze::TileType::EMPTY, 0});
+
+      REQUIRE(copy.get(0, 0) == maze::Cell{maze::TileType::FOOD, 5});
+      REQUIRE(copy.get(129, 129) == maze::Cell{maze::TileType::FOOD, 3});
+      REQUIRE(original.get(0, 0) == maze::Cell{maze::TileType::WALL, 0});
+      REQUIRE(original.get(129, 129) == maze::Cell{maze::TileType::EMPTY, 0});
+      REQUIRE(second.get(0, 0) == maze::Cell{maze::TileType::WALL, 0});
+      REQUIRE(second.get(129, 129) == maze::Cell{maze::TileType::FOOD, 3});
+
+      copy = original;
+      original.fill({maze::TileType::WALL, 0});
+      REQUIRE(copy.get(64, 64) == maze::Cell{maze::TileType::EMPTY, 0});
+      REQUIRE(original.get(64, 64) == maze::Cell{maze::TileType::WALL, 0});
+    }
+  }
+
+  SECTION("A memory-mapped grid can be reopened with its cells") {
+    const std::string file_path = "maze_grid_reopen_test.bin";
+    maze::GridStorage storage;
+    storage.layout = maze::GridLayout::TILED;
+    storage.file_path = file_path;
+    {
+      maze::Grid grid(40, 21, storage);
+      grid.set(39, 20, {maze::TileType::KEY, 3});
+      grid.set(5, 7, {maze::TileType::WALL, 0});
+    }
+
+    storage.open_existing = true;
+    {
+      const maze::Grid reopened(40, 21, storage);
+      REQUIRE(reopened.isMapped());
+      REQUIRE(reopened.get(39, 20) == maze::Cell{maze::TileType::KEY, 3});
+      REQUIRE(reopened.get(5, 7) == maze::Cell{maze::TileType::WALL, 0});
+      REQUIRE(reopened.get(0, 0) == maze::Cell{maze::TileType::EMPTY, 0});
+    }
+    REQUIRE_THROWS_AS(maze::Grid(80, 21, storage), std::runtime_error);
+
+    // A maze would overwrite the cells, so it refuses to open the file at all.
+    REQUIRE_THROWS_AS(maze::Maze(40, 21, 0.3, storage), std::invalid_argument);
+    REQUIRE(maze::Grid(40, 21, storage).get(39, 20) == maze::Cell{maze::TileType::KEY, 3});
+
+    std::remove(file_path.c_str());
+    REQUIRE_THROWS_AS(maze::Grid(40, 21, storage), std::runtime_error);
+  }
+
+  SECTION("A maze on a memory-mapped tiled grid plays like a maze on the heap") {
+    using namespace maze;
+    const std::vector<std::vector<Maze::PerceivedTile>> layout = {
+      {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL},
+      {Maze::PerceivedTile::START, Maze::PerceivedTile::FOOD, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::WALL},
+      {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::END},
+      {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL}
+    };
+
+    const std::string file_path = "maze_grid_test.bin";
+    GridStorage storage;
+    storage.layout = GridLayout::TILED;
+    storage.file_path = file_path;
+
+    {
+      Maze mapped_maze(layout, storage);
+      Maze heap_maze(layout);
+
+      REQUIRE(mapped_maze.getGrid().isMapped());
+      REQUIRE(mapped_maze.solve() == heap_maze.solve());
+      REQUIRE(mapped_maze.perceiveTiles(2) == heap_maze.perceiveTiles(2));
+
+      REQUIRE(mapped_maze.movePlayer(Maze::Move::RIGHT));
+      REQUIRE(mapped_maze.getCell(1, 1) == Cell{TileType::EMPTY, 0});
+      REQUIRE(std::dynamic_pointer_cast<EmptyTile>(mapped_maze.getTile(1, 1)) != nullptr);
+    }
+
+    std::remove(file_path.c_str());
+  }
+}
@@ -0,0 +1,49 @@
+#include <catch2/catch.hpp>
+
+#include <maze/generation.hpp>
+#include <maze/hashing.hpp>
+#include <maze/maze.hpp>
+
+TEST_CASE("hashing") {
+  using namespace maze;
+  const std::vector<std::vector<Maze::PerceivedTile>> layout = {
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL},
+    {Maze::PerceivedTile::START, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::FOOD, Maze::PerceivedTile::WALL},
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::END},
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL}
+  };
+
+  SECTION("Equal layouts hash equally and different layouts differently") {
+    GenerationOptions options;
+    options.seed = 3;
+    const Maze first(21, 21, 0.5, options);
+    const Maze second(21, 21, 0.5, options);
+    options.seed = 4;
+    const Maze third(21, 21, 0.5, options);
+
+    REQUIRE(first.getLayoutHash() == second.getLayoutHash());
+    REQUIRE(first.getStateHash() == second.getStateHash());
+    REQUIRE(first.getLayoutHash() != third.getLayoutHash());
+    REQUIRE(Maze(layout).getLayoutHash() == Maze(layout).getLayoutHash());
+  }
+
+  SECTION("Hashes are updated incrementally when the player moves and eats") {
+    Maze layouted_maze(layout);
+    const uint64_t initial_layout = layouted_maze.getLayoutHash();
+    const uint64_t initial_state = layouted_maze.getStateHash();
+
+    layouted_maze.movePlayer(Maze::Move::RIGHT);
+    REQUIRE(layouted_maze.getLayoutHash() == initial_layout);
+    REQUIRE(layouted_maze.getStateHash() != initial_state);
+
+    layouted_maze.movePlayer(Maze::Move::RIGHT);
+    REQUIRE(layouted_maze.getLayoutHash() != initial_layout);
+    REQUIRE(layouted_maze.getLayoutHash()
+            == hashLayout(layouted_maze.getGrid(), layouted_maze.getStartPosition(),
+                          layouted_maze.getEndPosition()));
+    REQUIRE(layouted_maze.getStateHash()
+            == (layouted_maze.getLayoutHash()
+                ^ zobristPlayerKey(layouted_maze.getPlayerPosition())
+                ^ zobristFoodKey(layouted_maze.getPlayerCurrentFood())));
+  }
+}
@@ -0,0 +1,63 @@
+#include <catch2/catch.hpp>
+
+#include <maze/infinite_maze.hpp>
+
+// Standard
+#include <queue>
+#include <set>
+#include <utility>
+
+TEST_CASE("infinite_maze") {
+  SECTION("Chunks are generated deterministically from the world seed") {
+    maze::InfiniteMaze first(42, 0.3, 16);
+    maze::InfiniteMaze second(42, 0.3, 16);
+
+    for (int64_t row = -40; row < 40; ++row) {
+      for (int64_t col = -40; col < 40; ++col) {
+        REQUIRE(first.getCell(row, col) == second.getCell(row, col));
+      }
+    }
+  }
+
+  SECTION("Chunks connect across their borders") {
+    maze::InfiniteMaze infinite_maze(7, 0.0, 8);
+
+    // Flood fill the 3x3 chunks around the origin from the spawn cell.
+    std::set<std::pair<int64_t, int64_t>> reached;
+    std::queue<std::pair<int64_t, int64_t>> open;
+    open.push({1, 1});
+    reached.insert({1, 1});
+    while (!open.empty()) {
+      const auto [row, col] = open.front();
+      open.pop();
+      const std::pair<int64_t, int64_t> neighbors[] = {
+          {row - 1, col}, {row + 1, col}, {row, col - 1}, {row, col + 1}};
+      for (const auto& neighbor : neighbors) {
+        if (neighbor.first < -8 || neighbor.first >= 16 || neighbor.second < -8 ||
+            neighbor.second >= 16 || reached.count(neighbor) > 0 ||
+            !maze::isPassable(infinite_maze.getCell(neighbor.first, neighbor.second).type)) {
+          continue;
+        }
+        reached.insert(neighbor);
+        open.push(neighbor);
+      }
+    }
+
+    for (int64_t chunk_row = -1; chunk_row <= 1; ++chunk_row) {
+      for (int64_t chunk_col = -1; chunk_col <= 1; ++chunk_col) {
+        REQUIRE(reached.count({chunk_row * 8 + 1, chunk_col * 8 + 1}) == 1);
+      }
+    }
+  }
+
+  SECTION("Chunks far from every player are evicted") {
+    maze::InfiniteMaze infinite_maze(3, 0.2, 8, 1);
+    const std::size_t player = infinite_maze.addPlayer();
+
+    const auto tiles = infinite_maze.perceiveTiles(player, 40);
+
+    REQUIRE(tiles.size() == 81);
+    REQUIRE(tiles[40][40] == maze::Maze::PerceivedTile::EMPTY);
+    REQUIRE(infinite_maze.getLoadedChunkCount() <= 9);
+  }
+}
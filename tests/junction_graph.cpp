@@ -0,0 +1,87 @@
+#include <catch2/catch.hpp>
+
+#include <maze/generation.hpp>
+#include <maze/junction_graph.hpp>
+#include <maze/maze.hpp>
+#include <maze/parallel_bfs.hpp>
+
+TEST_CASE("junction_graph") {
+  using namespace maze;
+
+  SECTION("Corridors collapse and eaten food is bypassed") {
+    const std::vector<std::vector<Maze::PerceivedTile>> layout = {
+      {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL},
+      {Maze::PerceivedTile::START, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::FOOD, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::END},
+      {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL}
+    };
+    Maze layouted_maze(layout);
+    layouted_maze.setJunctionSearch(true);
+    const auto graph = layouted_maze.getJunctionGraph();
+    REQUIRE(graph->getNodeCount() == 3);
+    REQUIRE(graph->getEdgeCount() == 4);
+    REQUIRE(graph->isNode({1, 2}));
+    REQUIRE_FALSE(graph->isNode({1, 4}));
+    REQUIRE(layouted_maze.solve() == std::vector<Maze::Move>(6, Maze::Move::RIGHT));
+
+    const Maze before(layouted_maze);
+    layouted_maze.movePlayer(Maze::Move::RIGHT);
+    layouted_maze.movePlayer(Maze::Move::RIGHT);
+    REQUIRE_FALSE(layouted_maze.getJunctionGraph()->isNode({1, 2}));
+    REQUIRE(before.getJunctionGraph()->isNode({1, 2}));
+    REQUIRE(layouted_maze.solve() == std::vector<Maze::Move>(4, Maze::Move::RIGHT));
+    layouted_maze.movePlayer(Maze::Move::LEFT);
+    layouted_maze.movePlayer(Maze::Move::LEFT);
+    REQUIRE(layouted_maze.solve() == std::vector<Maze::Move>(6, Maze::Move::RIGHT));
+  }
+
+  SECTION("Junction search finds shortest paths from anywhere") {
+    GenerationOptions options;
+    options.seed = 3;
+    options.placement.food_density = 0.1;
+    Maze generated(31, 31, 0.0, options);
+    generated.setJunctionSearch(true);
+    const auto graph = generated.getJunctionGraph();
+    REQUIRE(graph->getNodeCount() * 2 < 31 * 31 / 2);
+
+    for (uint32_t step = 0; step < 4 && !generated.isFinished(); ++step) {
+      const std::vector<uint32_t> distances =
+          breadthFirstDistances(generated.getGrid(), generated.getEndPosition(), 0, 1);
+      const Coordinates player = generated.getPlayerPosition();
+      const std::vector<Maze::Move> path = generated.solve();
+      REQUIRE(path.size() == distances[player.row * generated.getCols() + player.col]);
+
+      Maze walked(generated);
+      for (const Maze::Move move : path) {
+        REQUIRE(walked.movePlayer(move));
+      }
+      REQUIRE(walked.isFinished());
+      generated.movePlayer(path[0]);
+    }
+  }
+
+  SECTION("Changed tiles are picked up by the next search") {
+    GenerationOptions options;
+    options.seed = 5;
+    Maze generated(31, 31, 0.0, options);
+    generated.setJunctionSearch(true);
+    generated.setConnectivityTracking(true);
+    const std::vector<Maze::Move> path = generated.solve();
+    const auto graph = generated.getJunctionGraph();
+
+    // The generated maze is perfect, so a wall on its path cuts the player off from the end.
+    Maze walked(generated);
+    walked.movePlayer(path[0]);
+    walked.movePlayer(path[1]);
+    const Coordinates blocked = walked.getPlayerPosition();
+    generated.setTileType(blocked.row, blocked.col, TileType::WALL);
+    REQUIRE_FALSE(generated.isSolvable());
+    REQUIRE_THROWS_AS(generated.solve(), std::runtime_error);
+    REQUIRE(generated.getJunctionGraph() != graph);
+    REQUIRE(graph->isNode(generated.getEndPosition()));
+
+    generated.setTileType(blocked.row, blocked.col, TileType::MUD, 1);
+    generated.setTileType(blocked.row, blocked.col, TileType::EMPTY);
+    REQUIRE(generated.isSolvable());
+    REQUIRE(generated.solve() == path);
+  }
+}
@@ -0,0 +1,95 @@
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+
+#include <maze/generation.hpp>
+#include <maze/key_solver.hpp>
+#include <maze/maze.hpp>
+
+TEST_CASE("key_solver") {
+  using namespace maze;
+  const Maze::PerceivedTile red_key = Maze::perceivedKey(0);
+  const Maze::PerceivedTile blue_key = Maze::perceivedKey(1);
+  const Maze::PerceivedTile red_door = Maze::perceivedLockedDoor(0);
+  const Maze::PerceivedTile blue_door = Maze::perceivedLockedDoor(1);
+  const std::vector<std::vector<Maze::PerceivedTile>> layout = {
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL},
+    {Maze::PerceivedTile::START, Maze::PerceivedTile::EMPTY, red_door, Maze::PerceivedTile::EMPTY, blue_door, Maze::PerceivedTile::END},
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::WALL, blue_key, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL},
+    {Maze::PerceivedTile::WALL, red_key, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL}
+  };
+
+  SECTION("Locked doors need their keys") {
+    Maze layouted_maze(layout);
+    REQUIRE(layouted_maze.getCell(1, 2) == Cell{TileType::DOOR, 1});
+    REQUIRE(layouted_maze.getCell(2, 3) == Cell{TileType::KEY, 2});
+    REQUIRE(layouted_maze.perceiveTiles(5)[5][7] == red_door);
+    REQUIRE_FALSE(layouted_maze.getTile(1, 2)->isPassable());
+
+    layouted_maze.movePlayer(Maze::Move::RIGHT);
+    REQUIRE_FALSE(layouted_maze.movePlayer(Maze::Move::RIGHT));
+    layouted_maze.movePlayer(Maze::Move::DOWN);
+    layouted_maze.movePlayer(Maze::Move::DOWN);
+    REQUIRE(layouted_maze.getPlayerKeys() == 1);
+    REQUIRE(layouted_maze.getCell(3, 1).type == TileType::EMPTY);
+    layouted_maze.movePlayer(Maze::Move::UP);
+    layouted_maze.movePlayer(Maze::Move::UP);
+    REQUIRE(layouted_maze.movePlayer(Maze::Move::RIGHT));
+  }
+
+  SECTION("The solver collects keys in a working order") {
+    Maze layouted_maze(layout);
+    const auto moves = solveWithKeys(layouted_maze);
+    REQUIRE(moves);
+    REQUIRE(moves->size() == 11);
+    for (const Maze::Move move : *moves) {
+      REQUIRE(layouted_maze.movePlayer(move));
+    }
+    REQUIRE(layouted_maze.isFinished());
+  }
+
+  SECTION("Generated mazes with locked doors are solvable") {
+    for (uint64_t seed = 0; seed < 40; ++seed) {
+      GenerationOptions options;
+      options.seed = seed;
+      options.placement.key_colours = 2;
+      Maze generated(21, 21, 0.0, options);
+      REQUIRE(generated.isSolvable() == solveWithKeys(generated).has_value());
+      generated.setJunctionSearch(true);
+      REQUIRE(generated.isSolvable() == solveWithKeys(generated).has_value());
+    }
+  }
+
+  SECTION("Generated locked doors stay solvable") {
+    GenerationOptions options;
+    options.seed = 3;
+    options.placement.key_colours = 3;
+    Maze generated(25, 25, 0.0, options);
+
+    uint32_t locked_doors = 0;
+    for (uint32_t row = 0; row < generated.getRows(); ++row) {
+      for (uint32_t col = 0; col < generated.getCols(); ++col) {
+        const Cell cell = generated.getCell(row, col);
+        locked_doors += cell.type == TileType::DOOR && cell.value > 0 ? 1 : 0;
+      }
+    }
+    REQUIRE(locked_doors == 3);
+    REQUIRE(generated.isSolvable());
+
+    // solve() plans picking up the keys as well, with food.
+    Maze replayed(generated);
+    for (const Maze::Move move : replayed.solve()) {
+      REQUIRE(replayed.movePlayer(move));
+    }
+    REQUIRE(replayed.isFinished());
+    REQUIRE(replayed.getPlayerKeys() != 0);
+
+    const auto moves = solveWithKeys(generated);
+    REQUIRE(moves);
+    for (const Maze::Move move : *moves) {
+      REQUIRE(generated.movePlayer(move));
+    }
+    REQUIRE(generated.isFinished());
+    REQUIRE(generated.getPlayerKeys() == 7);
+  }
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch.hpp>
+
+#include <maze/generation.hpp>
+#include <maze/landmarks.hpp>
+#include <maze/maze.hpp>
+#include <maze/parallel_bfs.hpp>
+
+// Standard
+#include <memory>
+#include <set>
+#include <stdexcept>
+
+TEST_CASE("landmarks") {
+  using namespace maze;
+  GenerationOptions options;
+  options.seed = 7;
+  options.placement.food_density = 0.05;
+  const Maze generated(61, 61, 0.0, options);
+  const auto landmarks = std::make_shared<const LandmarkTable>(generated, 6, 2);
+
+  SECTION("Landmarks are distinct passable cells") {
+    REQUIRE(landmarks->getLandmarks().size() == 6);
+    std::set<std::pair<uint32_t, uint32_t>> distinct;
+    for (uint32_t index = 0; index < 6; ++index) {
+      const Coordinates& landmark = landmarks->getLandmarks()[index];
+      REQUIRE(isPassable(generated.getCell(landmark.row, landmark.col).type));
+      REQUIRE(landmarks->getDistance(index, landmark) == 0);
+      distinct.insert({landmark.row, landmark.col});
+    }
+    REQUIRE(distinct.size() == 6);
+  }
+
+  SECTION("Bounds never exceed the true distance") {
+    const Coordinates end = generated.getEndPosition();
+    const std::vector<uint32_t> distances =
+        breadthFirstDistances(generated.getGrid(), end, 0xFFFF, 1);
+    uint64_t bound_sum = 0;
+    uint64_t distance_sum = 0;
+    for (uint32_t row = 0; row < generated.getRows(); ++row) {
+      for (uint32_t col = 0; col < generated.getCols(); ++col) {
+        const uint32_t distance = distances[row * generated.getCols() + col];
+        if (distance != kUnreachable) {
+          const uint32_t bound = landmarks->getLowerBound({row, col}, end);
+          REQUIRE(bound <= distance);
+          bound_sum += bound;
+          distance_sum += distance;
+        }
+      }
+    }
+    // The bounds are far tighter than the Manhattan distance in a perfect maze.
+    REQUIRE(bound_sum * 2 > distance_sum);
+
+    const Coordinates first = landmarks->getLandmarks()[0];
+    REQUIRE(landmarks->getLowerBound(first, end) == distances[first.row * generated.getCols() + first.col]);
+  }
+
+  SECTION("Solving with landmarks reaches the end") {
+    Maze with_landmarks(generated);
+    with_landmarks.setLandmarkTable(landmarks);
+    Maze copy(with_landmarks);
+    REQUIRE(copy.getLandmarkTable() == landmarks);
+    for (const Maze::Move move : with_landmarks.solve()) {
+      REQUIRE(with_landmarks.movePlayer(move));
+    }
+    REQUIRE(with_landmarks.isFinished());
+
+    Maze other(21, 21, 0.0, options);
+    REQUIRE_THROWS_AS(other.setLandmarkTable(landmarks), std::invalid_argument);
+    other.setLandmarkTable(nullptr);
+    REQUIRE(other.getLandmarkTable() == nullptr);
+  }
+}
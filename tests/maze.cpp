@@ -144,4 +144,17 @@ TEST_CASE("maze") {
     REQUIRE(tiles[4][3] == Maze::PerceivedTile::UNKNOWN);
     REQUIRE(tiles[4][4] == Maze::PerceivedTile::UNKNOWN);
   }
+
+  SECTION("Every tile type has a perceived tile") {
+    using namespace maze;
+
+    REQUIRE(Maze::perceivedCell({TileType::EMPTY, 0}) == Maze::PerceivedTile::EMPTY);
+    REQUIRE(Maze::perceivedCell({TileType::WALL, 0}) == Maze::PerceivedTile::WALL);
+    REQUIRE(Maze::perceivedCell({TileType::DOOR, 0}) == Maze::PerceivedTile::DOOR);
+    REQUIRE(Maze::perceivedCell({TileType::DOOR, 3}) == Maze::perceivedLockedDoor(2));
+    REQUIRE(Maze::perceivedCell({TileType::FOOD, 12}) == Maze::PerceivedTile::FOOD);
+    REQUIRE(Maze::perceivedCell({TileType::KEY, 1}) == Maze::perceivedKey(0));
+    REQUIRE(Maze::perceivedCell({TileType::MUD, 2}) == Maze::PerceivedTile::MUD);
+    REQUIRE(Maze::perceivedCell({TileType::WATER, 4}) == Maze::PerceivedTile::WATER);
+  }
 }
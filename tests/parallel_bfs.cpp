@@ -0,0 +1,87 @@
+#include <catch2/catch.hpp>
+
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+#include <maze/parallel_bfs.hpp>
+
+// Standard
+#include <stdexcept>
+#include <vector>
+
+namespace {
+std::vector<uint32_t> referenceDistances(const maze::Grid& grid, const maze::Coordinates& source,
+                                         uint16_t keys) {
+  const uint32_t cols = grid.getCols();
+  std::vector<uint32_t> distances(static_cast<std::size_t>(grid.getRows()) * cols,
+                                  maze::kUnreachable);
+  std::vector<maze::Coordinates> queue = {source};
+  distances[source.row * cols + source.col] = 0;
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    const maze::Coordinates pos = queue[head];
+    const uint32_t distance = distances[pos.row * cols + pos.col];
+    const maze::Coordinates neighbors[] = {
+        {pos.row - 1, pos.col}, {pos.row + 1, pos.col}, {pos.row, pos.col - 1}, {pos.row, pos.col + 1}};
+    for (const maze::Coordinates& neighbor : neighbors) {
+      if (neighbor.row < grid.getRows() && neighbor.col < cols
+          && maze::isPassable(grid.get(neighbor.row, neighbor.col), keys)
+          && distances[neighbor.row * cols + neighbor.col] == maze::kUnreachable) {
+        distances[neighbor.row * cols + neighbor.col] = distance + 1;
+        queue.push_back(neighbor);
+      }
+    }
+  }
+  return distances;
+}
+} // namespace
+
+TEST_CASE("parallel_bfs") {
+  using namespace maze;
+
+  SECTION("Distances match a sequential search on a generated maze") {
+    GenerationOptions options;
+    options.seed = 4;
+    options.placement.key_colours = 2;
+    const Maze generated(41, 41, 0.3, options);
+    const Coordinates start = generated.getStartPosition();
+    for (const uint16_t keys : {uint16_t(0), uint16_t(3)}) {
+      REQUIRE(breadthFirstDistances(generated.getGrid(), start, keys, 4)
+              == referenceDistances(generated.getGrid(), start, keys));
+    }
+  }
+
+  SECTION("Large grids search in parallel in both directions") {
+    // An open room with scattered walls grows a frontier wide enough to expand on all threads,
+    // and switches to bottom-up once the frontier outgrows the unvisited corners.
+    Grid grid(1201, 1201, GridStorage{GridLayout::TILED, ""});
+    for (uint32_t row = 0; row < grid.getRows(); ++row) {
+      for (uint32_t col = 0; col < grid.getCols(); ++col) {
+        if ((row * 7 + col * 13) % 11 == 0) {
+          grid.set(row, col, {TileType::WALL, 0});
+        }
+      }
+    }
+    const Coordinates source = {600, 601};
+    const std::vector<uint32_t> expected = referenceDistances(grid, source, 0);
+    REQUIRE(breadthFirstDistances(grid, source, 0, 1) == expected);
+    REQUIRE(breadthFirstDistances(grid, source, 0, 4) == expected);
+
+    GenerationOptions options;
+    options.seed = 2;
+    options.algorithm = GenerationAlgorithm::PRIM;
+    Grid carved(401, 401);
+    carvePerfectMaze(carved, *options.seed, options);
+    REQUIRE(breadthFirstDistances(carved, {1, 1}, 0, 4) == referenceDistances(carved, {1, 1}, 0));
+  }
+
+  SECTION("Unreachable ends are detected before solving") {
+    const std::vector<std::vector<Maze::PerceivedTile>> walled = {
+        {Maze::PerceivedTile::START, Maze::PerceivedTile::WALL, Maze::PerceivedTile::END}};
+    Maze blocked(walled);
+    REQUIRE_FALSE(blocked.isSolvable());
+    REQUIRE(breadthFirstDistances(blocked.getGrid(), {0, 0})[2] == kUnreachable);
+  }
+
+  SECTION("Sources outside the grid are rejected") {
+    REQUIRE_THROWS_AS(breadthFirstDistances(Grid(3, 3), {3, 0}), std::invalid_argument);
+  }
+}
@@ -0,0 +1,74 @@
+#include <catch2/catch.hpp>
+
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+#include <maze/placement.hpp>
+
+// Standard
+#include <set>
+
+TEST_CASE("placement") {
+  SECTION("Taken cells are distinct, empty and never more than available") {
+    maze::Grid grid(21, 21);
+    maze::carvePerfectMaze(grid, 11, maze::GenerationOptions());
+    maze::RandomGenerator rng(1);
+    maze::PlacementEngine engine(grid, rng);
+    const std::size_t available = engine.getAvailableCount();
+
+    const auto first = engine.take(50, maze::PlacementOptions(), {0, 1});
+    const auto second = engine.take(available, maze::PlacementOptions(), {0, 1});
+
+    REQUIRE(first.size() == 50);
+    REQUIRE(second.size() == available - 50);
+    REQUIRE(engine.getAvailableCount() == 0);
+
+    std::set<maze::Coordinates> cells(first.begin(), first.end());
+    cells.insert(second.begin(), second.end());
+    REQUIRE(cells.size() == available);
+    for (const maze::Coordinates& cell : cells) {
+      REQUIRE(grid.get(cell.row, cell.col).type == maze::TileType::EMPTY);
+    }
+  }
+
+  SECTION("Distance weighted placement prefers cells far from the start") {
+    maze::Grid grid(41, 41);
+    maze::GenerationOptions generation;
+    generation.algorithm = maze::GenerationAlgorithm::PRIM;
+    maze::carvePerfectMaze(grid, 3, generation);
+    const maze::Coordinates start{1, 1};
+
+    maze::PlacementOptions weighted;
+    weighted.distribution = maze::PlacementDistribution::DISTANCE_FROM_START;
+    maze::RandomGenerator uniform_rng(5);
+    maze::RandomGenerator weighted_rng(5);
+    maze::PlacementEngine uniform_engine(grid, uniform_rng);
+    maze::PlacementEngine weighted_engine(grid, weighted_rng);
+
+    const auto manhattanSum = [&](const std::vector<maze::Coordinates>& cells) {
+      uint64_t sum = 0;
+      for (const maze::Coordinates& cell : cells) {
+        sum += cell.row - start.row + cell.col - start.col;
+      }
+      return sum;
+    };
+
+    REQUIRE(manhattanSum(weighted_engine.take(200, weighted, start)) >
+            manhattanSum(uniform_engine.take(200, maze::PlacementOptions(), start)));
+  }
+
+  SECTION("A crowded maze is generated without running out of cells") {
+    maze::GenerationOptions generation;
+    generation.seed = 17;
+    generation.placement.food_density = 1.0;
+    generation.placement.door_density = 1.0;
+    generation.placement.distribution = maze::PlacementDistribution::CLUSTERED;
+
+    maze::Maze crowded(15, 15, 0.5, generation);
+
+    for (uint32_t row = 1; row < 14; ++row) {
+      for (uint32_t col = 1; col < 14; ++col) {
+        REQUIRE(crowded.getCell(row, col).type != maze::TileType::EMPTY);
+      }
+    }
+  }
+}
@@ -0,0 +1,96 @@
+#include <catch2/catch.hpp>
+
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+#include <maze/planner.hpp>
+
+TEST_CASE("planner") {
+  using namespace maze;
+  GenerationOptions options;
+  options.seed = 11;
+  Maze generated(31, 31, 0.0, options);
+
+  SECTION("Plans shortest paths on a fully known map") {
+    IncrementalPlanner planner(generated.getRows(), generated.getCols(),
+                               generated.getStartPosition(), generated.getEndPosition());
+    for (uint32_t row = 0; row < generated.getRows(); ++row) {
+      for (uint32_t col = 0; col < generated.getCols(); ++col) {
+        planner.setKnowledge({row, col}, isPassable(generated.getCell(row, col).type)
+                                             ? IncrementalPlanner::Knowledge::PASSABLE
+                                             : IncrementalPlanner::Knowledge::BLOCKED);
+      }
+    }
+
+    const auto moves = planner.plan();
+    REQUIRE(moves);
+    REQUIRE(moves->size() == *generated.getAnalytics(0).shortest_path_length);
+
+    // Nothing changed, so nothing needs to be expanded again.
+    const uint64_t expanded = planner.getExpandedCount();
+    REQUIRE(planner.plan() == moves);
+    REQUIRE(planner.getExpandedCount() == expanded);
+  }
+
+  SECTION("Reaches the end while only perceiving the surroundings") {
+    IncrementalPlanner planner(generated.getRows(), generated.getCols(),
+                               generated.getStartPosition(), generated.getEndPosition());
+    uint32_t steps = 0;
+    while (generated.getPlayerPosition() != generated.getEndPosition() && steps < 2000) {
+      planner.observe(generated.getPlayerPosition(), generated.perceiveTiles(3));
+      const auto moves = planner.plan();
+      REQUIRE(moves);
+      REQUIRE(generated.movePlayer(moves->front()));
+      planner.setStart(generated.getPlayerPosition());
+      ++steps;
+    }
+
+    REQUIRE(generated.getPlayerPosition() == generated.getEndPosition());
+  }
+
+  SECTION("Reports unreachable goals") {
+    IncrementalPlanner planner(3, 3, {0, 0}, {2, 2});
+    REQUIRE(planner.plan()->size() == 4);
+    planner.setKnowledge({1, 2}, IncrementalPlanner::Knowledge::BLOCKED);
+    planner.setKnowledge({2, 1}, IncrementalPlanner::Knowledge::BLOCKED);
+    REQUIRE_FALSE(planner.plan());
+    planner.setKnowledge({2, 1}, IncrementalPlanner::Knowledge::FOOD);
+    REQUIRE(planner.plan()->size() == 4);
+  }
+
+  SECTION("Plans around locked doors unless the key is held") {
+    const Maze::PerceivedTile W = Maze::PerceivedTile::WALL;
+    const Maze::PerceivedTile E = Maze::PerceivedTile::EMPTY;
+    const std::vector<std::vector<Maze::PerceivedTile>> layout = {
+      {W, W, W, W, W, W, W},
+      {Maze::PerceivedTile::START, E, E, Maze::perceivedLockedDoor(0), E, E,
+       Maze::PerceivedTile::END},
+      {E, W, W, W, W, W, E},
+      {E, E, E, E, E, E, E},
+      {W, W, W, W, W, W, W}
+    };
+    Maze locked(layout);
+    IncrementalPlanner planner(locked.getRows(), locked.getCols(), locked.getStartPosition(),
+                               locked.getEndPosition());
+    planner.observe(locked.getPlayerPosition(), locked.perceiveTiles(6));
+    REQUIRE(planner.getKnowledge({1, 3}) == IncrementalPlanner::Knowledge::BLOCKED);
+    REQUIRE(planner.plan()->size() == 10);
+
+    REQUIRE(planner.setKeys(1) == 1);
+    REQUIRE(planner.getKnowledge({1, 3}) == IncrementalPlanner::Knowledge::PASSABLE);
+    REQUIRE(planner.plan()->size() == 6);
+    REQUIRE(planner.setKeys(0) == 1);
+    REQUIRE(planner.plan()->size() == 10);
+
+    // Every planned move succeeds, the detour is taken instead of bumping into the door.
+    uint32_t steps = 0;
+    while (locked.getPlayerPosition() != locked.getEndPosition() && steps < 20) {
+      planner.observe(locked.getPlayerPosition(), locked.perceiveTiles(2));
+      const auto moves = planner.plan();
+      REQUIRE(moves);
+      REQUIRE(locked.movePlayer(moves->front()));
+      planner.setStart(locked.getPlayerPosition());
+      ++steps;
+    }
+    REQUIRE(steps == 10);
+  }
+}
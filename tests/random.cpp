@@ -0,0 +1,77 @@
+#include <catch2/catch.hpp>
+
+#include <maze/random.hpp>
+
+// Standard
+#include <set>
+#include <vector>
+
+TEST_CASE("random") {
+  using namespace maze;
+
+  SECTION("Generators with the same seed draw the same sequence") {
+    RandomGenerator first(42);
+    RandomGenerator second(42);
+    RandomGenerator other(43);
+    bool differs = false;
+    for (int i = 0; i < 100; ++i) {
+      const uint64_t value = first();
+      REQUIRE(value == second());
+      differs = differs || value != other();
+    }
+    REQUIRE(differs);
+  }
+
+  SECTION("Bounded draws stay in range and cover it evenly") {
+    RandomGenerator rng(7);
+    std::vector<uint32_t> counts(6, 0);
+    for (int i = 0; i < 60000; ++i) {
+      const uint64_t value = rng.below(6);
+      REQUIRE(value < 6);
+      counts[value]++;
+    }
+    for (const uint32_t count : counts) {
+      REQUIRE(count > 9500);
+      REQUIRE(count < 10500);
+    }
+    REQUIRE(rng.below(1) == 0);
+    const uint64_t large = (1ull << 40) + 3;
+    for (int i = 0; i < 1000; ++i) {
+      REQUIRE(rng.below(large) < large);
+    }
+  }
+
+  SECTION("Bulk fills match single draws") {
+    RandomGenerator single(9);
+    RandomGenerator bulk(9);
+    std::vector<uint32_t> bounded(100);
+    bulk.fillBelow(bounded.data(), bounded.size(), 13);
+    std::vector<double> units(100);
+    bulk.fillUnit(units.data(), units.size());
+    for (const uint32_t value : bounded) {
+      REQUIRE(value == single.below(13));
+    }
+    for (const double value : units) {
+      REQUIRE(value >= 0.0);
+      REQUIRE(value < 1.0);
+      REQUIRE(value == single.unit());
+    }
+  }
+
+  SECTION("Streams are reproducible and distinct per index and thread") {
+    std::set<uint64_t> first_draws;
+    for (uint64_t index = 0; index < 4; ++index) {
+      for (uint32_t thread = 0; thread < 4; ++thread) {
+        RandomGenerator rng = RandomGenerator::forStream(5, index, thread);
+        const uint64_t value = rng();
+        REQUIRE(RandomGenerator::forStream(5, index, thread)() == value);
+        first_draws.insert(value);
+      }
+    }
+    REQUIRE(first_draws.size() == 16);
+
+    RandomGenerator jumped(5);
+    jumped.jump();
+    REQUIRE(jumped() != RandomGenerator(5)());
+  }
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch.hpp>
+
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+#include <maze/renderer.hpp>
+
+// Standard
+#include <sstream>
+#include <string>
+
+TEST_CASE("renderer") {
+  using namespace maze;
+  const std::vector<std::vector<Maze::PerceivedTile>> layout = {
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::START, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL},
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::FOOD, Maze::PerceivedTile::MUD, Maze::PerceivedTile::WALL},
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::DOOR, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WATER, Maze::PerceivedTile::WALL},
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::END, Maze::PerceivedTile::WALL}
+  };
+  const Maze layouted_maze(layout);
+
+  SECTION("ASCII shows one character per cell") {
+    REQUIRE(MazeRenderer(layouted_maze).render() == "#X###\n#.FM#\n#D#W#\n###O#\n");
+  }
+
+  SECTION("Overlays mark the path and hide unperceived cells") {
+    RenderOptions options;
+    options.path = {Maze::Move::DOWN, Maze::Move::RIGHT, Maze::Move::RIGHT, Maze::Move::DOWN,
+                    Maze::Move::DOWN};
+    REQUIRE(MazeRenderer(layouted_maze, options).render() == "#X###\n#***#\n#D#*#\n###O#\n");
+
+    options.path.clear();
+    options.sight_radius = 1;
+    const std::string rendered = MazeRenderer(layouted_maze, options).render();
+    REQUIRE(rendered == "#X#  \n .   \n     \n     \n");
+  }
+
+  SECTION("Images have a header and scaled pixels") {
+    RenderOptions options;
+    options.format = RenderFormat::PGM;
+    options.scale = 2;
+    const MazeRenderer renderer(layouted_maze, options);
+    const std::string image = renderer.render();
+    REQUIRE(image.compare(0, 12, "P5\n10 8\n255\n") == 0);
+    REQUIRE(image.size() == renderer.getHeaderSize() + 10 * 8);
+    // The wall at (0, 0) is black, the empty cell at (1, 1) white in both of its pixel rows.
+    REQUIRE(image[renderer.getHeaderSize()] == 0);
+    REQUIRE(static_cast<uint8_t>(image[renderer.getHeaderSize() + 2 * 10 + 2]) == 255);
+    REQUIRE(static_cast<uint8_t>(image[renderer.getHeaderSize() + 3 * 10 + 3]) == 255);
+
+    options.format = RenderFormat::PPM;
+    REQUIRE(MazeRenderer(layouted_maze, options).getSize()
+            == std::string("P6\n10 8\n255\n").size() + 10 * 8 * 3);
+  }
+
+  SECTION("Streaming and parallel bands match a single render") {
+    GenerationOptions generation;
+    generation.seed = 6;
+    generation.placement.food_density = 0.05;
+    const Maze generated(301, 157, 0.0, generation);
+    RenderOptions options;
+    options.format = RenderFormat::PPM;
+    options.path = Maze(generated).solve();
+    const std::string expected = MazeRenderer(generated, options).render();
+
+    options.threads = 4;
+    const MazeRenderer renderer(generated, options);
+    REQUIRE(renderer.render() == expected);
+    std::ostringstream stream;
+    renderer.write(stream, 100);
+    REQUIRE(stream.str() == expected);
+  }
+}
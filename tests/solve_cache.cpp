@@ -0,0 +1,65 @@
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <stdexcept>
+
+#include <maze/maze.hpp>
+#include <maze/solve_cache.hpp>
+
+TEST_CASE("solve_cache") {
+  using namespace maze;
+  const std::vector<std::vector<Maze::PerceivedTile>> solvable = {
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL},
+    {Maze::PerceivedTile::START, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::END},
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL}
+  };
+  const std::vector<std::vector<Maze::PerceivedTile>> unsolvable = {
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL},
+    {Maze::PerceivedTile::START, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::WALL, Maze::PerceivedTile::END},
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL}
+  };
+
+  SECTION("Results are shared between mazes with the same state") {
+    const auto cache = std::make_shared<SolveCache>(8);
+    Maze first(solvable);
+    Maze second(solvable);
+    first.setSolveCache(cache);
+    second.setSolveCache(cache);
+
+    const auto moves = first.solve();
+    REQUIRE(cache->getMisses() == 1);
+    REQUIRE(second.solve() == moves);
+    REQUIRE(cache->getHits() == 1);
+
+    // Moving changes the state, so the next query misses.
+    second.movePlayer(Maze::Move::RIGHT);
+    REQUIRE(second.solve().size() == moves.size() - 1);
+    REQUIRE(cache->getMisses() == 2);
+    REQUIRE(cache->getSize() == 2);
+  }
+
+  SECTION("Unsolvable states are cached") {
+    const auto cache = std::make_shared<SolveCache>(8);
+    Maze blocked(unsolvable);
+    blocked.setSolveCache(cache);
+
+    REQUIRE_FALSE(blocked.isSolvable());
+    REQUIRE_THROWS_AS(blocked.solve(), std::runtime_error);
+    REQUIRE(cache->getHits() == 1);
+    REQUIRE(cache->getMisses() == 1);
+  }
+
+  SECTION("The least recently used result is evicted") {
+    SolveCache cache(2);
+    cache.insert(1, std::vector<Maze::Move>{Maze::Move::LEFT});
+    cache.insert(2, std::nullopt);
+    REQUIRE(cache.find(1));
+    cache.insert(3, std::vector<Maze::Move>{});
+
+    REQUIRE(cache.getSize() == 2);
+    REQUIRE(cache.find(1));
+    REQUIRE_FALSE(cache.find(2));
+    REQUIRE(cache.find(3));
+    REQUIRE_THROWS_AS(SolveCache(0), std::invalid_argument);
+  }
+}
@@ -0,0 +1,65 @@
+#include <catch2/catch.hpp>
+
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+#include <maze/trajectory.hpp>
+
+TEST_CASE("trajectory") {
+  using namespace maze;
+
+  SECTION("Moves are packed and serialized losslessly") {
+    Trajectory trajectory(0x0123456789ABCDEFull);
+    const std::vector<Maze::Move> moves = {Maze::Move::LEFT, Maze::Move::RIGHT, Maze::Move::UP,
+                                           Maze::Move::DOWN, Maze::Move::DOWN, Maze::Move::UP};
+    for (const Maze::Move move : moves) {
+      trajectory.append(move);
+    }
+    trajectory.setOutcome(TrajectoryOutcome::STARVED);
+
+    const std::vector<uint8_t> bytes = trajectory.serialize();
+    REQUIRE(bytes.size() == 17 + 2);
+
+    const Trajectory restored = Trajectory::deserialize(bytes);
+    REQUIRE(restored.getLayoutHash() == 0x0123456789ABCDEFull);
+    REQUIRE(restored.getOutcome() == TrajectoryOutcome::STARVED);
+    REQUIRE(restored.size() == moves.size());
+    for (std::size_t index = 0; index < moves.size(); ++index) {
+      REQUIRE(restored.getMove(index) == moves[index]);
+    }
+
+    REQUIRE_THROWS_AS(Trajectory::deserialize({1, 2, 3}), std::invalid_argument);
+  }
+
+  SECTION("Replays match the mazes they were recorded on") {
+    GenerationOptions options;
+    options.seed = 9;
+    options.placement.food_density = 0.05;
+    const Maze original(21, 21, 0.0, options);
+    Maze played(21, 21, 0.0, options);
+
+    Trajectory solved(played.getLayoutHash());
+    for (const Maze::Move move : played.solve()) {
+      solved.append(move);
+      played.movePlayer(move);
+    }
+    solved.setOutcome(TrajectoryOutcome::REACHED_END);
+
+    Trajectory wandering(original.getLayoutHash());
+    wandering.append(Maze::Move::UP);
+    wandering.append(Maze::Move::LEFT);
+    wandering.setOutcome(TrajectoryOutcome::REACHED_END);
+
+    const std::vector<ReplayResult> results =
+        replayTrajectories({&original}, {solved, wandering, Trajectory(1)}, 2);
+
+    REQUIRE(results.size() == 3);
+    REQUIRE(results[0].maze_found);
+    REQUIRE(results[0].matches_recording);
+    REQUIRE(results[0].final_position == played.getPlayerPosition());
+    REQUIRE(results[0].food == played.getPlayerCurrentFood());
+    REQUIRE(results[0].moves_replayed == solved.size());
+    REQUIRE(results[1].maze_found);
+    REQUIRE_FALSE(results[1].matches_recording);
+    REQUIRE_FALSE(results[2].maze_found);
+  }
+}
@@ -0,0 +1,43 @@
+#include <catch2/catch.hpp>
+
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+#include <maze/visibility.hpp>
+
+TEST_CASE("visibility") {
+  using namespace maze;
+  GenerationOptions options;
+  options.seed = 6;
+  options.placement.food_density = 0.05;
+
+  SECTION("Indexed perception matches traced perception") {
+    Maze traced(31, 31, 0.3, options);
+    Maze indexed(31, 31, 0.3, options);
+    const auto index = indexed.getVisibilityIndex(4, 2);
+    REQUIRE(index->getRadius() == 4);
+    REQUIRE(index->getRunCount() > 0);
+
+    const std::vector<Maze::Move> moves = {Maze::Move::RIGHT, Maze::Move::DOWN, Maze::Move::LEFT,
+                                           Maze::Move::UP};
+    for (uint32_t step = 0; step < 300; ++step) {
+      REQUIRE(indexed.perceiveTiles(4) == traced.perceiveTiles(4));
+      // Other radii still trace their lines of sight.
+      REQUIRE(indexed.perceiveTiles(2) == traced.perceiveTiles(2));
+      const Maze::Move move = moves[(step * 5 + step / 4) % moves.size()];
+      traced.movePlayer(move);
+      indexed.movePlayer(move);
+    }
+  }
+
+  SECTION("An index is shared between mazes with the same walls") {
+    Maze first(21, 21, 0.2, options);
+    Maze second(21, 21, 0.2, options);
+    const auto index = first.getVisibilityIndex(3);
+    second.setVisibilityIndex(index);
+    REQUIRE(second.getVisibilityIndex(3) == index);
+    REQUIRE(first.perceiveTiles(3) == second.perceiveTiles(3));
+
+    Maze other(11, 11, 0.2, options);
+    REQUIRE_THROWS_AS(other.setVisibilityIndex(index), std::invalid_argument);
+  }
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch.hpp>
+
+#include <maze/generation.hpp>
+#include <maze/maze.hpp>
+#include <maze/radix_heap.hpp>
+#include <maze/tiles.hpp>
+#include <maze/weighted_solver.hpp>
+
+TEST_CASE("weighted_solver") {
+  using namespace maze;
+  const std::vector<std::vector<Maze::PerceivedTile>> layout = {
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL},
+    {Maze::PerceivedTile::START, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::MUD, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::END},
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::EMPTY, Maze::PerceivedTile::WALL},
+    {Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WATER, Maze::PerceivedTile::WALL, Maze::PerceivedTile::WALL}
+  };
+
+  SECTION("Terrain costs food to enter") {
+    Maze layouted_maze(layout);
+    REQUIRE(layouted_maze.getCell(1, 2) == Cell{TileType::MUD, kDefaultMudCost});
+    REQUIRE(std::dynamic_pointer_cast<WaterTile>(layouted_maze.getTile(3, 2))->getCost()
+            == kDefaultWaterCost);
+    REQUIRE(layouted_maze.perceiveTiles(2)[2][4] == Maze::PerceivedTile::MUD);
+
+    layouted_maze.movePlayer(Maze::Move::RIGHT);
+    layouted_maze.movePlayer(Maze::Move::RIGHT);
+    REQUIRE(layouted_maze.getPlayerCurrentFood() == Maze::kMaxFood - 1 - kDefaultMudCost);
+  }
+
+  SECTION("The cheapest path avoids mud") {
+    const Maze layouted_maze(layout);
+    const auto path = solveWeighted(layouted_maze);
+    REQUIRE(path);
+    REQUIRE(path->cost == 6);
+    REQUIRE(path->moves.size() == 6);
+  }
+
+  SECTION("Weighted and unit costs agree without terrain") {
+    GenerationOptions options;
+    options.seed = 12;
+    const Maze generated(31, 31, 0.0, options);
+    const auto path = solveWeighted(generated);
+    REQUIRE(path);
+    REQUIRE(path->cost == *generated.getAnalytics(0).shortest_path_length);
+
+    options.placement.mud_density = 0.1;
+    options.placement.water_density = 0.05;
+    Maze muddy(31, 31, 0.0, options);
+    const auto muddy_path = solveWeighted(muddy);
+    REQUIRE(muddy_path);
+    REQUIRE(muddy_path->cost > muddy_path->moves.size());
+    for (const Maze::Move move : muddy_path->moves) {
+      REQUIRE(muddy.movePlayer(move));
+    }
+    REQUIRE(muddy.isFinished());
+    REQUIRE(muddy.getPlayerCurrentFood() + muddy_path->cost >= Maze::kMaxFood);
+  }
+
+  SECTION("The radix heap pops keys in order") {
+    RadixHeap<int> heap;
+    heap.push(5, 0);
+    heap.push(3, 1);
+    heap.push(9, 2);
+    REQUIRE(heap.pop().first == 3);
+    heap.push(4, 3);
+    REQUIRE(heap.pop().first == 4);
+    REQUIRE(heap.pop().first == 5);
+    REQUIRE(heap.pop().second == 2);
+    REQUIRE(heap.empty());
+  }
+}